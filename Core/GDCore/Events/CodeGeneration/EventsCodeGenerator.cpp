@@ -700,6 +700,11 @@ gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
   return ConvertToStringExplicit(behaviorName);
 }
 
+gd::String EventsCodeGenerator::GenerateGetObjectNameCode(
+    const gd::String& objectName) {
+  return ConvertToStringExplicit(objectName);
+}
+
 gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
     EventsCodeGenerationContext& context) {
   auto declareObjectList = [this](gd::String object,
@@ -736,8 +741,8 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
     if (!context.ObjectAlreadyDeclared(object)) {
       objectListDeclaration = "std::vector<RuntimeObject*> " +
                               GetObjectListName(object, context) +
-                              " = runtimeContext->GetObjectsRawPointers(\"" +
-                              ConvertToString(object) + "\");\n";
+                              " = runtimeContext->GetObjectsRawPointers(" +
+                              GenerateGetObjectNameCode(object) + ");\n";
       context.SetObjectDeclared(object);
     } else
       objectListDeclaration = declareObjectList(object, context);
@@ -706,6 +706,12 @@ class GD_CORE_API EventsCodeGenerator {
    */
   virtual gd::String GenerateGetBehaviorNameCode(const gd::String& behaviorName);
 
+  /**
+   * Generate the getter to get the name of the specified object, used to
+   * fetch the list of objects having this name.
+   */
+  virtual gd::String GenerateGetObjectNameCode(const gd::String& objectName);
+
   const gd::Platform& platform;  ///< The platform being used.
 
   gd::ObjectsContainer& globalObjectsAndGroups;
@@ -28,8 +28,7 @@ ExpressionParser2::ExpressionParser2(
     const gd::Platform& platform_,
     const gd::ObjectsContainer& globalObjectsContainer_,
     const gd::ObjectsContainer& objectsContainer_)
-    : expression(""),
-      currentPosition(0),
+    : currentPosition(0),
       platform(platform_),
       globalObjectsContainer(globalObjectsContainer_),
       objectsContainer(objectsContainer_) {}
@@ -105,7 +104,7 @@ std::unique_ptr<ExpressionParserDiagnostic> ExpressionParser2::ValidateFunction(
     }
   }
 
-  return gd::make_unique<ExpressionParserDiagnostic>();
+  return nullptr;
 }
 
 std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
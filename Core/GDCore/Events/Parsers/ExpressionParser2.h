@@ -7,6 +7,7 @@
 #define GDCORE_EXPRESSIONPARSER2_H
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include "ExpressionParser2Node.h"
@@ -59,7 +60,12 @@ class GD_CORE_API ExpressionParser2 {
       const gd::String &type,
       const gd::String &expression_,
       const gd::String &objectName = "") {
-    expression = expression_;
+    // Decode the expression once, so that reading a character is done in
+    // constant time even if the expression is not only made of ASCII
+    // characters. The buffer is reused by the next parsed expressions.
+    expression.clear();
+    for (gd::String::value_type character : expression_)
+      expression.push_back(character);
 
     currentPosition = 0;
     return Start(type, objectName);
@@ -542,7 +548,7 @@ class GD_CORE_API ExpressionParser2 {
   };
 
   ParametersNode Parameters(
-      std::vector<gd::ParameterMetadata> parameterMetadata,
+      const std::vector<gd::ParameterMetadata> &parameterMetadata,
       const gd::String &objectName = "",
       const gd::String &behaviorName = "") {
     std::vector<std::unique_ptr<ExpressionNode>> parameters;
@@ -612,7 +618,8 @@ class GD_CORE_API ExpressionParser2 {
   ///@}
 
   /** \name Validators
-   * Return a diagnostic if any error is found
+   * Return a diagnostic if any error is found, nullptr otherwise (no need to
+   * allocate an empty diagnostic for every valid node).
    */
   ///@{
   std::unique_ptr<ExpressionParserDiagnostic> ValidateFunction(
@@ -623,7 +630,7 @@ class GD_CORE_API ExpressionParser2 {
     if (type == "number") {
       if (operatorChar == '+' || operatorChar == '-' || operatorChar == '/' ||
           operatorChar == '*') {
-        return gd::make_unique<ExpressionParserDiagnostic>();
+        return nullptr;
       }
 
       return gd::make_unique<ExpressionParserError>(
@@ -633,7 +640,7 @@ class GD_CORE_API ExpressionParser2 {
           GetCurrentPosition());
     } else if (type == "string") {
       if (operatorChar == '+') {
-        return gd::make_unique<ExpressionParserDiagnostic>();
+        return nullptr;
       }
 
       return gd::make_unique<ExpressionParserError>(
@@ -655,14 +662,14 @@ class GD_CORE_API ExpressionParser2 {
           GetCurrentPosition());
     }
 
-    return gd::make_unique<ExpressionParserDiagnostic>();
+    return nullptr;
   }
 
   std::unique_ptr<ExpressionParserDiagnostic> ValidateUnaryOperator(
       const gd::String &type, gd::String::value_type operatorChar) {
     if (type == "number") {
       if (operatorChar == '+' || operatorChar == '-') {
-        return gd::make_unique<ExpressionParserDiagnostic>();
+        return nullptr;
       }
 
       return gd::make_unique<ExpressionParserError>(
@@ -692,7 +699,7 @@ class GD_CORE_API ExpressionParser2 {
           GetCurrentPosition());
     }
 
-    return gd::make_unique<ExpressionParserDiagnostic>();
+    return nullptr;
   }
   ///@}
 
@@ -712,8 +719,7 @@ class GD_CORE_API ExpressionParser2 {
     }
   }
 
-  void SkipIfChar(
-      const std::function<bool(gd::String::value_type)> &predicate) {
+  void SkipIfChar(bool (*predicate)(gd::String::value_type)) {
     if (CheckIfChar(predicate)) {
       currentPosition++;
     }
@@ -730,8 +736,7 @@ class GD_CORE_API ExpressionParser2 {
     return ExpressionParserLocation(startPosition, currentPosition);
   }
 
-  bool CheckIfChar(
-      const std::function<bool(gd::String::value_type)> &predicate) {
+  bool CheckIfChar(bool (*predicate)(gd::String::value_type)) {
     if (currentPosition >= expression.size()) return false;
     gd::String::value_type character = expression[currentPosition];
 
@@ -830,9 +835,15 @@ class GD_CORE_API ExpressionParser2 {
   bool IsNamespaceSeparator() {
     // Namespace separator is a special kind of delimiter as it is 2 characters
     // long
-    return (currentPosition + NAMESPACE_SEPARATOR.size() <= expression.size() &&
-            expression.substr(currentPosition, NAMESPACE_SEPARATOR.size()) ==
-                NAMESPACE_SEPARATOR);
+    if (currentPosition + NAMESPACE_SEPARATOR.size() > expression.size())
+      return false;
+
+    std::size_t i = 0;
+    for (gd::String::value_type character : NAMESPACE_SEPARATOR) {
+      if (expression[currentPosition + i] != character) return false;
+      i++;
+    }
+    return true;
   }
 
   bool IsEndReached() { return currentPosition >= expression.size(); }
@@ -844,36 +855,29 @@ class GD_CORE_API ExpressionParser2 {
   };
 
   IdentifierAndLocation ReadIdentifierName() {
-    gd::String name;
     size_t startPosition = currentPosition;
     while (currentPosition < expression.size() &&
            (IsIdentifierAllowedChar()
             // Allow whitespace in identifier name for compatibility
             ||
             expression[currentPosition] == ' ')) {
-      name += expression[currentPosition];
       currentPosition++;
     }
 
     // Trim whitespace at the end (we allow them for compatibility inside
     // the name, but after the last character that is not whitespace, they
     // should be ignore again).
-    if (!name.empty() && IsWhitespace(name[name.size() - 1])) {
-      size_t lastCharacterPos = name.size() - 1;
-      while (lastCharacterPos < name.size() &&
-             IsWhitespace(name[lastCharacterPos])) {
-        lastCharacterPos--;
-      }
-      if ((lastCharacterPos + 1) < name.size()) {
-        name.erase(lastCharacterPos + 1);
-      }
+    size_t endPosition = currentPosition;
+    while (endPosition > startPosition &&
+           IsWhitespace(expression[endPosition - 1])) {
+      endPosition--;
     }
 
     IdentifierAndLocation identifierAndLocation{
-        name,
+        GetString(startPosition, endPosition),
         // The location is ignoring the trailing whitespace (only whitespace
         // inside the identifier are allowed for compatibility).
-        ExpressionParserLocation(startPosition, startPosition + name.size())};
+        ExpressionParserLocation(startPosition, endPosition)};
     return identifierAndLocation;
   }
 
@@ -881,30 +885,26 @@ class GD_CORE_API ExpressionParser2 {
 
   std::unique_ptr<NumberNode> ReadNumber();
 
-  std::unique_ptr<EmptyNode> ReadUntilWhitespace(gd::String type) {
+  std::unique_ptr<EmptyNode> ReadUntilWhitespace(const gd::String &type) {
     size_t startPosition = GetCurrentPosition();
-    gd::String text;
     while (currentPosition < expression.size() &&
            !IsWhitespace(expression[currentPosition])) {
-      text += expression[currentPosition];
       currentPosition++;
     }
 
-    auto node = gd::make_unique<EmptyNode>(type, text);
+    auto node = gd::make_unique<EmptyNode>(
+        type, GetString(startPosition, currentPosition));
     node->location =
         ExpressionParserLocation(startPosition, GetCurrentPosition());
     return node;
   }
 
-  std::unique_ptr<EmptyNode> ReadUntilEnd(gd::String type) {
+  std::unique_ptr<EmptyNode> ReadUntilEnd(const gd::String &type) {
     size_t startPosition = GetCurrentPosition();
-    gd::String text;
-    while (currentPosition < expression.size()) {
-      text += expression[currentPosition];
-      currentPosition++;
-    }
+    currentPosition = expression.size();
 
-    auto node = gd::make_unique<EmptyNode>(type, text);
+    auto node = gd::make_unique<EmptyNode>(
+        type, GetString(startPosition, currentPosition));
     node->location =
         ExpressionParserLocation(startPosition, GetCurrentPosition());
     return node;
@@ -912,6 +912,17 @@ class GD_CORE_API ExpressionParser2 {
 
   size_t GetCurrentPosition() { return currentPosition; }
 
+  /**
+   * Return the part of the expression between the two positions.
+   */
+  gd::String GetString(size_t startPosition, size_t endPosition) {
+    gd::String str;
+    for (size_t i = startPosition; i < endPosition; ++i)
+      str.push_back(expression[i]);
+
+    return str;
+  }
+
   gd::String::value_type GetCurrentChar() {
     if (currentPosition < expression.size()) {
       return expression[currentPosition];
@@ -965,7 +976,8 @@ class GD_CORE_API ExpressionParser2 {
     return !behaviorName.empty() ? 2 : (!objectName.empty() ? 1 : 0);
   }
 
-  gd::String expression;
+  std::u32string expression;  ///< The expression being parsed, decoded to have
+                              ///< a constant time access to its characters.
   std::size_t currentPosition;
 
   const gd::Platform &platform;
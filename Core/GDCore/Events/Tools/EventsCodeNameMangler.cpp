@@ -8,10 +8,12 @@
 #include "GDCore/CommonTools.h"
 #include "GDCore/String.h"
 
-EventsCodeNameMangler *EventsCodeNameMangler::_singleton = nullptr;
+std::atomic<EventsCodeNameMangler *> EventsCodeNameMangler::_singleton(
+    nullptr);
 
 const gd::String& EventsCodeNameMangler::GetMangledObjectsListName(
     const gd::String &originalObjectName) {
+  std::lock_guard<std::mutex> lock(mangledNamesMutex);
   auto it = mangledObjectNames.find(originalObjectName);
   if (it != mangledObjectNames.end()) {
     return it->second;
@@ -38,6 +40,7 @@ const gd::String& EventsCodeNameMangler::GetMangledObjectsListName(
 
 const gd::String& EventsCodeNameMangler::GetExternalEventsFunctionMangledName(
     const gd::String &externalEventsName) {
+  std::lock_guard<std::mutex> lock(mangledNamesMutex);
   auto it = mangledExternalEventsNames.find(externalEventsName);
   if (it != mangledExternalEventsNames.end()) {
     return it->second;
@@ -67,16 +70,22 @@ const gd::String& ManObjListName(const gd::String &objectName) {
 }
 
 EventsCodeNameMangler *EventsCodeNameMangler::Get() {
-  if (nullptr == _singleton) _singleton = new EventsCodeNameMangler;
+  EventsCodeNameMangler *mangler = _singleton.load();
+  if (nullptr == mangler) {
+    // If several threads create the singleton at the same time, only one is
+    // kept.
+    EventsCodeNameMangler *newMangler = new EventsCodeNameMangler;
+    if (_singleton.compare_exchange_strong(mangler, newMangler))
+      mangler = newMangler;
+    else
+      delete newMangler;
+  }
 
-  return (static_cast<EventsCodeNameMangler *>(_singleton));
+  return mangler;
 }
 
 void EventsCodeNameMangler::DestroySingleton() {
-  if (nullptr != _singleton) {
-    delete _singleton;
-    _singleton = nullptr;
-  }
+  delete _singleton.exchange(nullptr);
 }
 
 #endif
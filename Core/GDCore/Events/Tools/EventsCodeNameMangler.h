@@ -6,6 +6,8 @@
 #if defined(GD_IDE_ONLY)
 #ifndef EVENTSCODENAMEMANGLER_H
 #define EVENTSCODENAMEMANGLER_H
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include "GDCore/String.h"
 
@@ -22,6 +24,9 @@ class GD_CORE_API EventsCodeNameMangler {
    *
    * The mangled name is memoized as this is intensively used during project
    * export and events code generation.
+   *
+   * \note Can be called by several threads at the same time, as events code
+   * can be generated in parallel.
    */
   const gd::String &GetMangledObjectsListName(
       const gd::String &originalObjectName);
@@ -42,13 +47,14 @@ class GD_CORE_API EventsCodeNameMangler {
  private:
   EventsCodeNameMangler(){};
   virtual ~EventsCodeNameMangler(){};
-  static EventsCodeNameMangler *_singleton;
+  static std::atomic<EventsCodeNameMangler *> _singleton;
 
   std::unordered_map<gd::String, gd::String>
       mangledObjectNames;  ///< Memoized results of mangling for objects
   std::unordered_map<gd::String, gd::String>
       mangledExternalEventsNames;  ///< Memoized results of mangling for
                                    /// external events
+  std::mutex mangledNamesMutex;  ///< Protect the memoized results.
 };
 
 /**
@@ -25,6 +25,7 @@ BehaviorMetadata::BehaviorMetadata(
     std::shared_ptr<gd::Behavior> instance_,
     std::shared_ptr<gd::BehaviorsSharedData> sharedDatasInstance_)
     : extensionNamespace(extensionNamespace_),
+      objectLocal(false),
       instance(instance_),
       sharedDatasInstance(sharedDatasInstance_) {
 #if defined(GD_IDE_ONLY)
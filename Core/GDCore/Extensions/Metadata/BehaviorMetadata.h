@@ -36,7 +36,7 @@ class GD_CORE_API BehaviorMetadata {
       const gd::String& className_,
       std::shared_ptr<gd::Behavior> instance,
       std::shared_ptr<gd::BehaviorsSharedData> sharedDatasInstance);
-  BehaviorMetadata(){};
+  BehaviorMetadata() : objectLocal(false){};
   virtual ~BehaviorMetadata(){};
 
   /**
@@ -135,6 +135,26 @@ class GD_CORE_API BehaviorMetadata {
     return *this;
   }
 
+  /**
+   * \brief Declare that the behavior only reads and modifies the object
+   * owning it during its pre and post events steps.
+   *
+   * Object-local behaviors can be stepped in parallel by the platform (see
+   * RuntimeScene::SetBehaviorsThreadsCount in GDCpp). A behavior that creates
+   * or deletes objects, or changes other objects, must not be declared as
+   * object-local.
+   */
+  BehaviorMetadata& SetObjectLocal(bool objectLocal_ = true) {
+    objectLocal = objectLocal_;
+    return *this;
+  }
+
+  /**
+   * \brief Return true if the behavior was declared as object-local.
+   * \see SetObjectLocal
+   */
+  bool IsObjectLocal() const { return objectLocal; }
+
   const gd::String& GetName() const;
 #if defined(GD_IDE_ONLY)
   const gd::String& GetFullName() const { return fullname; }
@@ -184,6 +204,7 @@ class GD_CORE_API BehaviorMetadata {
  private:
   gd::String extensionNamespace;
   gd::String helpPath;
+  bool objectLocal;  ///< True if the behavior only touches its own object.
 #if defined(GD_IDE_ONLY)
   gd::String fullname;
   gd::String defaultName;
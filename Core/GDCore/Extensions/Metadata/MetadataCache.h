@@ -0,0 +1,167 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#if defined(GD_IDE_ONLY)
+#ifndef GDCORE_METADATACACHE_H
+#define GDCORE_METADATACACHE_H
+#include <mutex>
+#include <unordered_map>
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/String.h"
+namespace gd {
+class ExpressionMetadata;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Memoize the metadata of the expressions found by
+ * gd::MetadataProvider, so that the extensions of a platform are searched only
+ * once for each expression.
+ *
+ * Each gd::Platform owns a cache, which is cleared when an extension is added
+ * or removed. The expressions found are bounded by the extensions, and at
+ * most MaxNotFoundExpressionsCount expressions not found are memoized, so that
+ * searching arbitrary names does not grow the cache without bound.
+ *
+ * Memoizing does not change the metadata returned, so GetExpressionMetadata is
+ * const and can be called on the cache of a const gd::Platform.
+ *
+ * \note Can be used by several threads at the same time.
+ *
+ * \see gd::MetadataProvider
+ * \ingroup PlatformDefinition
+ */
+class GD_CORE_API MetadataCache {
+ public:
+  MetadataCache() : notFoundExpressionsCount(0){};
+
+  /**
+   * \brief The kinds of expressions, each one having its own metadata.
+   */
+  enum ExpressionKind {
+    Expression = 0,
+    StrExpression,
+    ObjectExpression,
+    ObjectStrExpression,
+    BehaviorExpression,
+    BehaviorStrExpression,
+    ExpressionKindsCount
+  };
+
+  /**
+   * \brief The maximum number of expressions not found memoized. When reached,
+   * they are all removed from the cache.
+   */
+  static const std::size_t MaxNotFoundExpressionsCount = 1024;
+
+  /**
+   * \brief Return the metadata of an expression, calling \a search to find it
+   * in the extensions if it's not in the cache yet.
+   *
+   * \param ownerType The type of the object or of the behavior owning the
+   * expression, or an empty string for static expressions.
+   * \param search A function returning the
+   * gd::ExtensionAndMetadata<gd::ExpressionMetadata> of the expression.
+   */
+  template <class SearchFunction>
+  ExtensionAndMetadata<ExpressionMetadata> GetExpressionMetadata(
+      ExpressionKind kind,
+      const gd::String& ownerType,
+      const gd::String& name,
+      SearchFunction search) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = Find(foundExpressions[kind], ownerType, name);
+    if (found) return *found;
+    auto notFound = Find(notFoundExpressions[kind], ownerType, name);
+    if (notFound) return *notFound;
+
+    ExtensionAndMetadata<ExpressionMetadata> extensionAndMetadata = search();
+    if (!MetadataProvider::IsBadExpressionMetadata(
+            extensionAndMetadata.GetMetadata())) {
+      foundExpressions[kind][ownerType].emplace(name, extensionAndMetadata);
+    } else {
+      // Any name can be searched (for example while an expression is typed),
+      // so the expressions not found are not kept forever.
+      if (notFoundExpressionsCount >= MaxNotFoundExpressionsCount) {
+        for (auto& kindExpressions : notFoundExpressions)
+          kindExpressions.clear();
+        notFoundExpressionsCount = 0;
+      }
+      notFoundExpressions[kind][ownerType].emplace(name, extensionAndMetadata);
+      notFoundExpressionsCount++;
+    }
+    return extensionAndMetadata;
+  }
+
+  /**
+   * \brief Return the number of expressions found in the extensions and
+   * memoized.
+   */
+  std::size_t GetFoundExpressionsCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t count = 0;
+    for (auto& kindExpressions : foundExpressions)
+      for (auto& ownerExpressions : kindExpressions)
+        count += ownerExpressions.second.size();
+    return count;
+  }
+
+  /**
+   * \brief Return the number of expressions not found in the extensions and
+   * memoized (at most MaxNotFoundExpressionsCount).
+   */
+  std::size_t GetNotFoundExpressionsCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return notFoundExpressionsCount;
+  }
+
+  /**
+   * \brief Remove all the memoized metadata.
+   */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& kindExpressions : foundExpressions) kindExpressions.clear();
+    for (auto& kindExpressions : notFoundExpressions) kindExpressions.clear();
+    notFoundExpressionsCount = 0;
+  }
+
+ private:
+  typedef std::unordered_map<
+      gd::String,
+      std::unordered_map<gd::String, ExtensionAndMetadata<ExpressionMetadata>>>
+      ExpressionsByOwnerType;
+
+  /**
+   * \brief Return the memoized metadata of an expression, or nullptr. Does not
+   * add anything to \a expressions.
+   */
+  static const ExtensionAndMetadata<ExpressionMetadata>* Find(
+      const ExpressionsByOwnerType& expressions,
+      const gd::String& ownerType,
+      const gd::String& name) {
+    auto ownerExpressions = expressions.find(ownerType);
+    if (ownerExpressions == expressions.end()) return nullptr;
+
+    auto it = ownerExpressions->second.find(name);
+    return it != ownerExpressions->second.end() ? &it->second : nullptr;
+  }
+
+  mutable ExpressionsByOwnerType
+      foundExpressions[ExpressionKindsCount];  ///< The metadata of the
+                                               ///< expressions found, by kind,
+                                               ///< owner type and name.
+  mutable ExpressionsByOwnerType
+      notFoundExpressions[ExpressionKindsCount];  ///< The bad metadata
+                                                  ///< returned for the
+                                                  ///< expressions not found.
+  mutable std::size_t notFoundExpressionsCount;
+  mutable std::mutex mutex;  ///< Protect the memoized metadata.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_METADATACACHE_H
+#endif
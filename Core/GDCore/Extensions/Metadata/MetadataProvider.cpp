@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
 #include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/MetadataCache.h"
 #include "GDCore/Extensions/Metadata/ObjectMetadata.h"
 #include "GDCore/Extensions/Metadata/EffectMetadata.h"
 #include "GDCore/Extensions/Platform.h"
@@ -164,7 +165,20 @@ const gd::InstructionMetadata& MetadataProvider::GetConditionMetadata(
 
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndObjectExpressionMetadata(
-    const gd::Platform& platform, gd::String objectType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& objectType,
+    const gd::String& exprType) {
+  return platform.GetMetadataCache().GetExpressionMetadata(
+      MetadataCache::ObjectExpression, objectType, exprType, [&]() {
+        return SearchObjectExpressionMetadata(platform, objectType, exprType);
+      });
+}
+
+ExtensionAndMetadata<ExpressionMetadata>
+MetadataProvider::SearchObjectExpressionMetadata(
+    const gd::Platform& platform,
+    const gd::String& objectType,
+    const gd::String& exprType) {
   auto& extensions = platform.GetAllPlatformExtensions();
   for (auto& extension : extensions) {
     const auto& objects = extension->GetExtensionObjectsTypes();
@@ -191,14 +205,29 @@ MetadataProvider::GetExtensionAndObjectExpressionMetadata(
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetObjectExpressionMetadata(
-    const gd::Platform& platform, gd::String objectType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& objectType,
+    const gd::String& exprType) {
   return GetExtensionAndObjectExpressionMetadata(platform, objectType, exprType)
       .GetMetadata();
 }
 
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndBehaviorExpressionMetadata(
-    const gd::Platform& platform, gd::String autoType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& autoType,
+    const gd::String& exprType) {
+  return platform.GetMetadataCache().GetExpressionMetadata(
+      MetadataCache::BehaviorExpression, autoType, exprType, [&]() {
+        return SearchBehaviorExpressionMetadata(platform, autoType, exprType);
+      });
+}
+
+ExtensionAndMetadata<ExpressionMetadata>
+MetadataProvider::SearchBehaviorExpressionMetadata(
+    const gd::Platform& platform,
+    const gd::String& autoType,
+    const gd::String& exprType) {
   auto& extensions = platform.GetAllPlatformExtensions();
   for (auto& extension : extensions) {
     const auto& autos = extension->GetBehaviorsTypes();
@@ -225,14 +254,25 @@ MetadataProvider::GetExtensionAndBehaviorExpressionMetadata(
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetBehaviorExpressionMetadata(
-    const gd::Platform& platform, gd::String autoType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& autoType,
+    const gd::String& exprType) {
   return GetExtensionAndBehaviorExpressionMetadata(platform, autoType, exprType)
       .GetMetadata();
 }
 
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndExpressionMetadata(
-    const gd::Platform& platform, gd::String exprType) {
+    const gd::Platform& platform, const gd::String& exprType) {
+  return platform.GetMetadataCache().GetExpressionMetadata(
+      MetadataCache::Expression, "", exprType, [&]() {
+        return SearchExpressionMetadata(platform, exprType);
+      });
+}
+
+ExtensionAndMetadata<ExpressionMetadata>
+MetadataProvider::SearchExpressionMetadata(
+    const gd::Platform& platform, const gd::String& exprType) {
   auto& extensions = platform.GetAllPlatformExtensions();
   for (auto& extension : extensions) {
     const auto& allExpr = extension->GetAllExpressions();
@@ -246,13 +286,27 @@ MetadataProvider::GetExtensionAndExpressionMetadata(
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetExpressionMetadata(
-    const gd::Platform& platform, gd::String exprType) {
+    const gd::Platform& platform, const gd::String& exprType) {
   return GetExtensionAndExpressionMetadata(platform, exprType).GetMetadata();
 }
 
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndObjectStrExpressionMetadata(
-    const gd::Platform& platform, gd::String objectType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& objectType,
+    const gd::String& exprType) {
+  return platform.GetMetadataCache().GetExpressionMetadata(
+      MetadataCache::ObjectStrExpression, objectType, exprType, [&]() {
+        return SearchObjectStrExpressionMetadata(
+            platform, objectType, exprType);
+      });
+}
+
+ExtensionAndMetadata<ExpressionMetadata>
+MetadataProvider::SearchObjectStrExpressionMetadata(
+    const gd::Platform& platform,
+    const gd::String& objectType,
+    const gd::String& exprType) {
   auto& extensions = platform.GetAllPlatformExtensions();
   for (auto& extension : extensions) {
     const auto& objects = extension->GetExtensionObjectsTypes();
@@ -280,7 +334,9 @@ MetadataProvider::GetExtensionAndObjectStrExpressionMetadata(
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetObjectStrExpressionMetadata(
-    const gd::Platform& platform, gd::String objectType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& objectType,
+    const gd::String& exprType) {
   return GetExtensionAndObjectStrExpressionMetadata(
              platform, objectType, exprType)
       .GetMetadata();
@@ -288,7 +344,21 @@ const gd::ExpressionMetadata& MetadataProvider::GetObjectStrExpressionMetadata(
 
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndBehaviorStrExpressionMetadata(
-    const gd::Platform& platform, gd::String autoType, gd::String exprType) {
+    const gd::Platform& platform,
+    const gd::String& autoType,
+    const gd::String& exprType) {
+  return platform.GetMetadataCache().GetExpressionMetadata(
+      MetadataCache::BehaviorStrExpression, autoType, exprType, [&]() {
+        return SearchBehaviorStrExpressionMetadata(
+            platform, autoType, exprType);
+      });
+}
+
+ExtensionAndMetadata<ExpressionMetadata>
+MetadataProvider::SearchBehaviorStrExpressionMetadata(
+    const gd::Platform& platform,
+    const gd::String& autoType,
+    const gd::String& exprType) {
   auto& extensions = platform.GetAllPlatformExtensions();
   for (auto& extension : extensions) {
     const auto& autos = extension->GetBehaviorsTypes();
@@ -318,8 +388,8 @@ MetadataProvider::GetExtensionAndBehaviorStrExpressionMetadata(
 
 const gd::ExpressionMetadata&
 MetadataProvider::GetBehaviorStrExpressionMetadata(const gd::Platform& platform,
-                                                   gd::String autoType,
-                                                   gd::String exprType) {
+                                                   const gd::String& autoType,
+                                                   const gd::String& exprType) {
   return GetExtensionAndBehaviorStrExpressionMetadata(
              platform, autoType, exprType)
       .GetMetadata();
@@ -327,7 +397,16 @@ MetadataProvider::GetBehaviorStrExpressionMetadata(const gd::Platform& platform,
 
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndStrExpressionMetadata(
-    const gd::Platform& platform, gd::String exprType) {
+    const gd::Platform& platform, const gd::String& exprType) {
+  return platform.GetMetadataCache().GetExpressionMetadata(
+      MetadataCache::StrExpression, "", exprType, [&]() {
+        return SearchStrExpressionMetadata(platform, exprType);
+      });
+}
+
+ExtensionAndMetadata<ExpressionMetadata>
+MetadataProvider::SearchStrExpressionMetadata(
+    const gd::Platform& platform, const gd::String& exprType) {
   auto& extensions = platform.GetAllPlatformExtensions();
   for (auto& extension : extensions) {
     const auto& allExpr = extension->GetAllStrExpressions();
@@ -341,7 +420,7 @@ MetadataProvider::GetExtensionAndStrExpressionMetadata(
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetStrExpressionMetadata(
-    const gd::Platform& platform, gd::String exprType) {
+    const gd::Platform& platform, const gd::String& exprType) {
   return GetExtensionAndStrExpressionMetadata(platform, exprType).GetMetadata();
 }
 
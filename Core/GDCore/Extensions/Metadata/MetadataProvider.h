@@ -100,7 +100,7 @@ class GD_CORE_API MetadataProvider {
    */
   static ExtensionAndMetadata<ExpressionMetadata>
   GetExtensionAndExpressionMetadata(const gd::Platform& platform,
-                                    gd::String exprType);
+                                    const gd::String& exprType);
 
   /**
    * Get information about an expression, and its associated extension.
@@ -108,8 +108,8 @@ class GD_CORE_API MetadataProvider {
    */
   static ExtensionAndMetadata<ExpressionMetadata>
   GetExtensionAndObjectExpressionMetadata(const gd::Platform& platform,
-                                          gd::String objectType,
-                                          gd::String exprType);
+                                          const gd::String& objectType,
+                                          const gd::String& exprType);
 
   /**
    * Get information about an expression, and its associated extension.
@@ -117,8 +117,8 @@ class GD_CORE_API MetadataProvider {
    */
   static ExtensionAndMetadata<ExpressionMetadata>
   GetExtensionAndBehaviorExpressionMetadata(const gd::Platform& platform,
-                                            gd::String autoType,
-                                            gd::String exprType);
+                                            const gd::String& autoType,
+                                            const gd::String& exprType);
 
   /**
    * Get information about a string expression, and its associated extension.
@@ -126,7 +126,7 @@ class GD_CORE_API MetadataProvider {
    */
   static ExtensionAndMetadata<ExpressionMetadata>
   GetExtensionAndStrExpressionMetadata(const gd::Platform& platform,
-                                       gd::String exprType);
+                                       const gd::String& exprType);
 
   /**
    * Get information about a string expression, and its associated extension.
@@ -134,8 +134,8 @@ class GD_CORE_API MetadataProvider {
    */
   static ExtensionAndMetadata<ExpressionMetadata>
   GetExtensionAndObjectStrExpressionMetadata(const gd::Platform& platform,
-                                             gd::String objectType,
-                                             gd::String exprType);
+                                             const gd::String& objectType,
+                                             const gd::String& exprType);
 
   /**
    * Get information about a string expression, and its associated extension.
@@ -143,8 +143,8 @@ class GD_CORE_API MetadataProvider {
    */
   static ExtensionAndMetadata<ExpressionMetadata>
   GetExtensionAndBehaviorStrExpressionMetadata(const gd::Platform& platform,
-                                               gd::String autoType,
-                                               gd::String exprType);
+                                               const gd::String& autoType,
+                                               const gd::String& exprType);
 
   /**
    * Get the metadata about a behavior.
@@ -183,42 +183,50 @@ class GD_CORE_API MetadataProvider {
    * Works for static expressions.
    */
   static const gd::ExpressionMetadata& GetExpressionMetadata(
-      const gd::Platform& platform, gd::String exprType);
+      const gd::Platform& platform, const gd::String& exprType);
 
   /**
    * Get information about an expression from its type
    * Works for object expressions.
    */
   static const gd::ExpressionMetadata& GetObjectExpressionMetadata(
-      const gd::Platform& platform, gd::String objectType, gd::String exprType);
+      const gd::Platform& platform,
+      const gd::String& objectType,
+      const gd::String& exprType);
 
   /**
    * Get information about an expression from its type
    * Works for behavior expressions.
    */
   static const gd::ExpressionMetadata& GetBehaviorExpressionMetadata(
-      const gd::Platform& platform, gd::String autoType, gd::String exprType);
+      const gd::Platform& platform,
+      const gd::String& autoType,
+      const gd::String& exprType);
 
   /**
    * Get information about a string expression from its type
    * Works for static expressions.
    */
   static const gd::ExpressionMetadata& GetStrExpressionMetadata(
-      const gd::Platform& platform, gd::String exprType);
+      const gd::Platform& platform, const gd::String& exprType);
 
   /**
    * Get information about a string expression from its type
    * Works for object expressions.
    */
   static const gd::ExpressionMetadata& GetObjectStrExpressionMetadata(
-      const gd::Platform& platform, gd::String objectType, gd::String exprType);
+      const gd::Platform& platform,
+      const gd::String& objectType,
+      const gd::String& exprType);
 
   /**
    * Get information about a string expression from its type
    * Works for behavior expressions.
    */
   static const gd::ExpressionMetadata& GetBehaviorStrExpressionMetadata(
-      const gd::Platform& platform, gd::String autoType, gd::String exprType);
+      const gd::Platform& platform,
+      const gd::String& autoType,
+      const gd::String& exprType);
 
   /**
    * \brief Check if a (static) condition exists
@@ -318,6 +326,33 @@ class GD_CORE_API MetadataProvider {
  private:
   MetadataProvider();
 
+  /** \name Expressions search
+   * Search the metadata of an expression in all the extensions of a platform,
+   * without using the gd::MetadataCache of the platform.
+   */
+  ///@{
+  static ExtensionAndMetadata<ExpressionMetadata> SearchExpressionMetadata(
+      const gd::Platform& platform, const gd::String& exprType);
+  static ExtensionAndMetadata<ExpressionMetadata>
+  SearchObjectExpressionMetadata(const gd::Platform& platform,
+                                 const gd::String& objectType,
+                                 const gd::String& exprType);
+  static ExtensionAndMetadata<ExpressionMetadata>
+  SearchBehaviorExpressionMetadata(const gd::Platform& platform,
+                                   const gd::String& autoType,
+                                   const gd::String& exprType);
+  static ExtensionAndMetadata<ExpressionMetadata> SearchStrExpressionMetadata(
+      const gd::Platform& platform, const gd::String& exprType);
+  static ExtensionAndMetadata<ExpressionMetadata>
+  SearchObjectStrExpressionMetadata(const gd::Platform& platform,
+                                    const gd::String& objectType,
+                                    const gd::String& exprType);
+  static ExtensionAndMetadata<ExpressionMetadata>
+  SearchBehaviorStrExpressionMetadata(const gd::Platform& platform,
+                                      const gd::String& autoType,
+                                      const gd::String& exprType);
+  ///@}
+
   static PlatformExtension badExtension;
   static BehaviorMetadata badBehaviorInfo;
   static ObjectMetadata badObjectInfo;
@@ -4,9 +4,11 @@
  * reserved. This project is released under the MIT License.
  */
 #include "Platform.h"
+#include "GDCore/Extensions/Metadata/MetadataCache.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/Project/Object.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/MakeUnique.h"
 
 using namespace std;
 
@@ -14,7 +16,11 @@ using namespace std;
 
 namespace gd {
 
-Platform::Platform(): enableExtensionLoadingLogs(true) {}
+Platform::Platform() : enableExtensionLoadingLogs(true) {
+#if defined(GD_IDE_ONLY)
+  metadataCache = gd::make_unique<gd::MetadataCache>();
+#endif
+}
 
 Platform::~Platform() {}
 
@@ -29,6 +35,9 @@ bool Platform::AddExtension(std::shared_ptr<gd::PlatformExtension> extension) {
   if (enableExtensionLoadingLogs) std::cout << std::endl;
 
   extensionsLoaded.push_back(extension);
+#if defined(GD_IDE_ONLY)
+  metadataCache->Clear();
+#endif
 
   // Load all creation/destruction functions for objects provided by the
   // extension
@@ -61,6 +70,9 @@ void Platform::RemoveExtension(const gd::String& name) {
                   return extension->GetName() == name;
                 }),
       extensionsLoaded.end());
+#if defined(GD_IDE_ONLY)
+  metadataCache->Clear();
+#endif
 }
 
 bool Platform::IsExtensionLoaded(const gd::String& name) const {
@@ -23,6 +23,7 @@ class BehaviorsSharedData;
 class PlatformExtension;
 class LayoutEditorCanvas;
 class ProjectExporter;
+class MetadataCache;
 }  // namespace gd
 
 typedef std::function<std::unique_ptr<gd::Object>(gd::String name)>
@@ -173,6 +174,16 @@ class GD_CORE_API Platform {
    */
   virtual void OnIDEInitialized(){};
 
+  /**
+   * \brief Return the cache used by gd::MetadataProvider to memoize the
+   * metadata found in the extensions. It is cleared when an extension is added
+   * or removed.
+   *
+   * The cache can only be read: filling it does not change the metadata it
+   * returns, so it is allowed on a const platform.
+   */
+  const gd::MetadataCache& GetMetadataCache() const { return *metadataCache; }
+
 #endif
 
  private:
@@ -181,6 +192,10 @@ class GD_CORE_API Platform {
   std::map<gd::String, CreateFunPtr>
       creationFunctionTable;  ///< Creation functions for objects
   bool enableExtensionLoadingLogs;
+#if defined(GD_IDE_ONLY)
+  std::unique_ptr<gd::MetadataCache>
+      metadataCache;  ///< Memoized metadata of the extensions
+#endif
 };
 
 }  // namespace gd
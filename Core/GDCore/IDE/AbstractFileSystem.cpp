@@ -5,8 +5,10 @@
  */
 
 #include "AbstractFileSystem.h"
+#include <sstream>
 #include "GDCore/CommonTools.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/FileStream.h"
 
 namespace gd {
 
@@ -18,4 +20,22 @@ gd::String gd::AbstractFileSystem::NormalizeSeparator(gd::String filename) {
   return filename.FindAndReplace("\\", "/");
 }
 
+bool AbstractFileSystem::StreamToFile(
+    const gd::String& file, std::function<void(std::ostream&)> writer) {
+  std::ostringstream content;
+  writer(content);
+  return WriteToFile(file, gd::String::FromUTF8(content.str()));
+}
+
+bool AbstractFileSystem::StreamToLocalFile(
+    const gd::String& file, std::function<void(std::ostream&)> writer) {
+  gd::FileStream output(
+      file, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!output.is_open()) return false;
+
+  writer(output);
+  output.flush();
+  return !output.fail();
+}
+
 }  // namespace gd
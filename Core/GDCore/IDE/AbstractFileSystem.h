@@ -6,6 +6,8 @@
 
 #ifndef GDCORE_ABSTRACTFILESYSTEM
 #define GDCORE_ABSTRACTFILESYSTEM
+#include <functional>
+#include <iosfwd>
 #include <vector>
 #include "GDCore/String.h"
 
@@ -107,6 +109,22 @@ class GD_CORE_API AbstractFileSystem {
   virtual bool WriteToFile(const gd::String& file,
                            const gd::String& content) = 0;
 
+  /**
+   * \brief Write to a file the content written by a function in a stream,
+   * so that large contents don't have to be stored in a string first.
+   *
+   * The default implementation stores the content in memory and calls
+   * WriteToFile: file systems able to write a file progressively should
+   * override it (file systems using the files of the computer can call
+   * StreamToLocalFile).
+   *
+   * \param file The file to write.
+   * \param writer The function writing the content of the file in the stream.
+   * \return true if the operation succeeded.
+   */
+  virtual bool StreamToFile(const gd::String& file,
+                            std::function<void(std::ostream&)> writer);
+
   /**
    * \brief Read the content of a file.
    * \return The content of the file.
@@ -125,6 +143,17 @@ class GD_CORE_API AbstractFileSystem {
 
  protected:
   AbstractFileSystem(){};
+
+  /**
+   * \brief Write the content written by a function in a stream directly to a
+   * file of the computer, without storing it in memory.
+   *
+   * \param file The path of the file, in UTF-8.
+   * \param writer The function writing the content of the file in the stream.
+   * \return true if the operation succeeded.
+   */
+  static bool StreamToLocalFile(const gd::String& file,
+                                std::function<void(std::ostream&)> writer);
 };
 
 }  // namespace gd
@@ -10,10 +10,11 @@
 
 namespace gd {
 
-SceneNameMangler *SceneNameMangler::_singleton = nullptr;
+std::atomic<SceneNameMangler *> SceneNameMangler::_singleton(nullptr);
 
 const gd::String &SceneNameMangler::GetMangledSceneName(
     const gd::String &sceneName) {
+  std::lock_guard<std::mutex> lock(mangledSceneNamesMutex);
   auto it = mangledSceneNames.find(sceneName);
   if (it != mangledSceneNames.end()) {
     return it->second;
@@ -43,16 +44,22 @@ const gd::String &SceneNameMangler::GetMangledSceneName(
 }
 
 SceneNameMangler *SceneNameMangler::Get() {
-  if (nullptr == _singleton) _singleton = new SceneNameMangler;
+  SceneNameMangler *mangler = _singleton.load();
+  if (nullptr == mangler) {
+    // If several threads create the singleton at the same time, only one is
+    // kept.
+    SceneNameMangler *newMangler = new SceneNameMangler;
+    if (_singleton.compare_exchange_strong(mangler, newMangler))
+      mangler = newMangler;
+    else
+      delete newMangler;
+  }
 
-  return (static_cast<SceneNameMangler *>(_singleton));
+  return mangler;
 }
 
 void SceneNameMangler::DestroySingleton() {
-  if (nullptr != _singleton) {
-    delete _singleton;
-    _singleton = nullptr;
-  }
+  delete _singleton.exchange(nullptr);
 }
 
 }  // namespace gd
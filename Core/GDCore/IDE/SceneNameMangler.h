@@ -6,6 +6,8 @@
 
 #ifndef SCENENAMEMANGLER_H
 #define SCENENAMEMANGLER_H
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include "GDCore/String.h"
 
@@ -26,6 +28,9 @@ class GD_CORE_API SceneNameMangler {
    *
    * The mangled name is memoized as this is intensively used during project
    * export and events code generation.
+   *
+   * \note Can be called by several threads at the same time, as events code
+   * can be generated in parallel.
    */
   const gd::String& GetMangledSceneName(const gd::String& sceneName);
 
@@ -35,10 +40,11 @@ class GD_CORE_API SceneNameMangler {
  private:
   SceneNameMangler(){};
   virtual ~SceneNameMangler(){};
-  static SceneNameMangler* _singleton;
+  static std::atomic<SceneNameMangler*> _singleton;
 
   std::unordered_map<gd::String, gd::String>
       mangledSceneNames;  ///< Memoized results of mangling
+  std::mutex mangledSceneNamesMutex;  ///< Protect the memoized results.
 };
 
 }  // namespace gd
@@ -15,7 +15,17 @@
 
 namespace gd {
 
-ImageManager::ImageManager() : resourcesManager(NULL) {
+ImageManager::ImageManager()
+    : usesCount(0),
+      texturesMemoryBudget(256 * 1024 * 1024),
+      texturesMemoryUsage(0),
+      cacheHitsCount(0),
+      cacheMissesCount(0),
+      evictionsCount(0),
+      resourcesManager(NULL) {
+#if defined(GD_IDE_ONLY)
+  preventUnloading = false;
+#endif
 #if !defined(EMSCRIPTEN)
   badTexture = std::make_shared<SFMLTextureWrapper>();
   badTexture->texture.loadFromMemory(gd::InvalidImageData,
@@ -32,11 +42,17 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
     return badTexture;
   }
 
-  if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
-      !alreadyLoadedImages.find(name)->second.expired())
-    return alreadyLoadedImages.find(name)->second.lock();
+  auto alreadyLoaded = alreadyLoadedImages.find(name);
+  if (alreadyLoaded != alreadyLoadedImages.end() &&
+      !alreadyLoaded->second.expired()) {
+    std::shared_ptr<SFMLTextureWrapper> texture = alreadyLoaded->second.lock();
+    cacheHitsCount++;
+    CacheTexture(name, texture);
+    return texture;
+  }
 
   std::cout << "ImageManager: Loading " << name << ".";
+  cacheMissesCount++;
 
   // Load only an image when necessary
   try {
@@ -55,6 +71,7 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
           texture);  // If unload prevention is activated, add the image to the
                      // list dedicated to prevent images from being unloaded.
 #endif
+    CacheTexture(name, texture);
 
     return texture;
   } catch (...) {
@@ -65,6 +82,34 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
   return badTexture;
 }
 
+std::shared_ptr<SFMLTextureWrapper> ImageManager::AddDecodedTexture(
+    const gd::String& name, std::shared_ptr<SFMLTextureWrapper> texture) const {
+  if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
+      !alreadyLoadedImages.find(name)->second.expired())
+    return alreadyLoadedImages.find(name)->second.lock();
+
+  bool smooth = true;
+  if (resourcesManager) {
+    try {
+      const ImageResource& image =
+          dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
+      smooth = image.smooth;
+    } catch (...) { /*The resource is not an image*/
+    }
+  }
+
+  texture->texture.loadFromImage(texture->image);
+  texture->texture.setSmooth(smooth);
+
+  alreadyLoadedImages[name] = texture;
+#if defined(GD_IDE_ONLY)
+  if (preventUnloading) unloadingPreventer.push_back(texture);
+#endif
+  CacheTexture(name, texture);
+
+  return texture;
+}
+
 bool ImageManager::HasLoadedSFMLTexture(const gd::String& name) const {
   if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
       !alreadyLoadedImages.find(name)->second.expired())
@@ -77,8 +122,10 @@ void ImageManager::SetSFMLTextureAsPermanentlyLoaded(
     const gd::String& name,
     std::shared_ptr<SFMLTextureWrapper>& texture) const {
   if (alreadyLoadedImages.find(name) == alreadyLoadedImages.end() ||
-      alreadyLoadedImages.find(name)->second.expired())
+      alreadyLoadedImages.find(name)->second.expired()) {
     alreadyLoadedImages[name] = texture;
+    CacheTexture(name, texture);
+  }
 
   if (permanentlyLoadedImages.find(name) == permanentlyLoadedImages.end())
     permanentlyLoadedImages[name] = texture;
@@ -109,6 +156,7 @@ void ImageManager::ReloadImage(const gd::String& name) const {
     ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), oldTexture->image);
     oldTexture->texture.loadFromImage(oldTexture->image);
     oldTexture->texture.setSmooth(image.smooth);
+    UpdateCachedTextureSize(name);
 
     return;
   } catch (...) { /*The ressource is not an image*/
@@ -118,6 +166,89 @@ void ImageManager::ReloadImage(const gd::String& name) const {
   std::cout << "ImageManager: " << name << " is not available anymore."
             << std::endl;
   *oldTexture = *badTexture;
+  UpdateCachedTextureSize(name);
+}
+
+void ImageManager::SetTexturesMemoryBudget(std::size_t budget) {
+  texturesMemoryBudget = budget;
+  EvictTextures();
+}
+
+void ImageManager::EvictTextures() const {
+  // Each texture is checked at most once.
+  std::size_t texturesToCheck = leastRecentlyUsedTextures.size();
+  while (texturesMemoryUsage > texturesMemoryBudget && texturesToCheck > 0) {
+    texturesToCheck--;
+    auto leastRecentlyUsed = leastRecentlyUsedTextures.begin();
+    auto cached = cachedTextures.find(leastRecentlyUsed->second);
+    leastRecentlyUsedTextures.erase(leastRecentlyUsed);
+
+    // Textures still used elsewhere (including the permanently loaded ones)
+    // would not be freed: mark them as recently used, so that they are not
+    // checked again before the others.
+    if (cached->second.texture.use_count() > 1) {
+      cached->second.lastUse = ++usesCount;
+      leastRecentlyUsedTextures.insert(
+          std::make_pair(cached->second.lastUse, cached->first));
+      continue;
+    }
+
+    texturesMemoryUsage -= cached->second.size;
+    alreadyLoadedImages.erase(cached->first);
+    cachedTextures.erase(cached);
+    evictionsCount++;
+  }
+}
+
+void ImageManager::CacheTexture(
+    const gd::String& name,
+    const std::shared_ptr<SFMLTextureWrapper>& texture) const {
+  auto cached = cachedTextures.find(name);
+  if (cached != cachedTextures.end()) {
+    CachedTexture& cachedTexture = cached->second;
+    leastRecentlyUsedTextures.erase(
+        std::make_pair(cachedTexture.lastUse, name));
+    cachedTexture.lastUse = ++usesCount;
+    leastRecentlyUsedTextures.insert(
+        std::make_pair(cachedTexture.lastUse, name));
+    if (cachedTexture.texture == texture) return;
+
+    // The texture was replaced by another one.
+    texturesMemoryUsage -= cachedTexture.size;
+    cachedTexture.texture = texture;
+    cachedTexture.size = GetTextureMemorySize(*texture);
+    texturesMemoryUsage += cachedTexture.size;
+  } else {
+    CachedTexture cachedTexture;
+    cachedTexture.texture = texture;
+    cachedTexture.size = GetTextureMemorySize(*texture);
+    cachedTexture.lastUse = ++usesCount;
+    cachedTextures[name] = cachedTexture;
+    leastRecentlyUsedTextures.insert(
+        std::make_pair(cachedTexture.lastUse, name));
+    texturesMemoryUsage += cachedTexture.size;
+  }
+
+  EvictTextures();
+}
+
+void ImageManager::UpdateCachedTextureSize(const gd::String& name) const {
+  auto cached = cachedTextures.find(name);
+  if (cached == cachedTextures.end()) return;
+
+  std::size_t oldSize = cached->second.size;
+  cached->second.size = GetTextureMemorySize(*cached->second.texture);
+  texturesMemoryUsage = texturesMemoryUsage - oldSize + cached->second.size;
+  if (cached->second.size > oldSize) EvictTextures();
+}
+
+std::size_t ImageManager::GetTextureMemorySize(
+    const SFMLTextureWrapper& texture) {
+  sf::Vector2u imageSize = texture.image.getSize();
+  sf::Vector2u textureSize = texture.texture.getSize();
+  return (std::size_t(imageSize.x) * imageSize.y +
+          std::size_t(textureSize.x) * textureSize.y) *
+         4;
 }
 
 std::shared_ptr<OpenGLTextureWrapper> ImageManager::GetOpenGLTexture(
@@ -10,8 +10,12 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
 #include <SFML/System.hpp>
+#include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 #include "GDCore/String.h"
 namespace gd {
@@ -29,8 +33,10 @@ namespace gd {
  *
  * Image manager is used by objects to obtain their images from the image name.
  *
- * Images are loaded dynamically when necessary, and are unloaded if there is no
- * more shared_ptr pointing on an image.
+ * Images are loaded dynamically when necessary. Images not used anymore (with
+ * no more shared_ptr pointing on them) are kept in memory until the memory
+ * used by the textures exceeds a budget (see SetTexturesMemoryBudget): the
+ * least recently used ones are then unloaded.
  *
  * You should in particular be interested by gd::ImageManager::GetOpenGLTexture
  * and gd::ImageManager::GetSFMLTexture.
@@ -63,6 +69,19 @@ class GD_CORE_API ImageManager {
   std::shared_ptr<SFMLTextureWrapper> GetSFMLTexture(
       const gd::String& name) const;
 
+  /**
+   * \brief Create the texture of an image already decoded in \a
+   * texture->image (for example by a background thread) and add it to the
+   * loaded images, so that GetSFMLTexture does not load it again.
+   *
+   * \warning The texture is uploaded to the GPU: this must be called by the
+   * thread rendering the game.
+   * \return The texture of the image, which is the already loaded one if any.
+   */
+  std::shared_ptr<SFMLTextureWrapper> AddDecodedTexture(
+      const gd::String& name,
+      std::shared_ptr<SFMLTextureWrapper> texture) const;
+
   /**
    * \brief Set the gd::ResourcesManager used by the ImageManager.
    */
@@ -98,6 +117,55 @@ class GD_CORE_API ImageManager {
    */
   void ReloadImage(const gd::String& name) const;
 
+  /**
+   * \brief Set the maximum memory, in bytes, that the textures should use
+   * (256 MB by default).
+   *
+   * When exceeded, the least recently used textures that are not used anymore
+   * are unloaded. Textures still used (for example by objects) and permanently
+   * loaded textures are never unloaded, even if they alone exceed the budget.
+   */
+  void SetTexturesMemoryBudget(std::size_t budget);
+
+  /**
+   * \brief Return the maximum memory, in bytes, that the textures should use.
+   */
+  std::size_t GetTexturesMemoryBudget() const { return texturesMemoryBudget; }
+
+  /**
+   * \brief Return the memory used by the loaded textures, in bytes (their
+   * pixels being stored both in the sf::Image and in the sf::Texture).
+   */
+  std::size_t GetTexturesMemoryUsage() const { return texturesMemoryUsage; }
+
+  /**
+   * \brief Unload the least recently used textures not used anymore until the
+   * textures memory budget is respected.
+   *
+   * Done automatically each time the textures memory usage grows (a texture
+   * is loaded, replaced or reloaded with a larger size). Textures still used
+   * are marked as recently used, so that each texture is checked at most once.
+   */
+  void EvictTextures() const;
+
+  /**
+   * \brief Return the number of textures requested to GetSFMLTexture that were
+   * already loaded.
+   */
+  std::size_t GetCacheHitsCount() const { return cacheHitsCount; }
+
+  /**
+   * \brief Return the number of textures requested to GetSFMLTexture that had
+   * to be loaded.
+   */
+  std::size_t GetCacheMissesCount() const { return cacheMissesCount; }
+
+  /**
+   * \brief Return the number of textures unloaded to respect the textures
+   * memory budget.
+   */
+  std::size_t GetEvictionsCount() const { return evictionsCount; }
+
 #if defined(GD_IDE_ONLY)
   /**
    * \brief When called, images won't be unloaded from memory until
@@ -113,6 +181,44 @@ class GD_CORE_API ImageManager {
 #endif
 
  private:
+  /**
+   * \brief A texture kept in memory by the ImageManager.
+   */
+  struct CachedTexture {
+    std::shared_ptr<SFMLTextureWrapper> texture;
+    std::size_t size;       ///< The memory used by the texture, in bytes.
+    std::uint64_t lastUse;  ///< The value of usesCount when last used.
+  };
+
+  /**
+   * \brief Add the texture to the cached textures if not already there and
+   * mark it as the most recently used one. Textures are evicted if necessary
+   * when the texture was not already cached.
+   */
+  void CacheTexture(const gd::String& name,
+                    const std::shared_ptr<SFMLTextureWrapper>& texture) const;
+
+  /**
+   * \brief Update the size of a cached texture after its image was changed,
+   * evicting textures if it grew.
+   */
+  void UpdateCachedTextureSize(const gd::String& name) const;
+
+  static std::size_t GetTextureMemorySize(const SFMLTextureWrapper& texture);
+
+  mutable std::map<gd::String, CachedTexture>
+      cachedTextures;  ///< All the textures loaded, except the ones unloaded
+                       ///< to respect the budget.
+  mutable std::set<std::pair<std::uint64_t, gd::String> >
+      leastRecentlyUsedTextures;  ///< The last use and the name of the cached
+                                  ///< textures, the least recently used first.
+  mutable std::uint64_t usesCount;
+  std::size_t texturesMemoryBudget;
+  mutable std::size_t texturesMemoryUsage;
+  mutable std::size_t cacheHitsCount;
+  mutable std::size_t cacheMissesCount;
+  mutable std::size_t evictionsCount;
+
   mutable std::map<gd::String, std::weak_ptr<SFMLTextureWrapper> >
       alreadyLoadedImages;  ///< Reference all images loaded in memory.
   mutable std::map<gd::String, std::shared_ptr<SFMLTextureWrapper> >
@@ -5,7 +5,6 @@
  */
 
 #include "GDCore/Project/Variable.h"
-#include <sstream>
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 #include "GDCore/TinyXml/tinyxml.h"
@@ -19,9 +18,7 @@ namespace gd {
  */
 double Variable::GetValue() const {
   if (!isNumber) {
-    stringstream ss;
-    ss << str;
-    ss >> value;
+    value = str.To<double>();
     isNumber = true;
   }
 
@@ -30,9 +27,7 @@ double Variable::GetValue() const {
 
 const gd::String& Variable::GetString() const {
   if (isNumber) {
-    stringstream s;
-    s << (value);
-    str = s.str();
+    str = gd::String::From(value);
     isNumber = false;
   }
 
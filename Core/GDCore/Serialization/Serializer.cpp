@@ -5,9 +5,14 @@
  */
 
 #include "GDCore/Serialization/Serializer.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "GDCore/CommonTools.h"
@@ -15,6 +20,11 @@
 #if !defined(EMSCRIPTEN)
 #include "GDCore/TinyXml/tinyxml.h"
 #endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GD_SERIALIZER_SSE2
+#endif
 
 namespace gd {
 
@@ -123,46 +133,42 @@ static bool containsControlCharacter(const char* str) {
 }
 
 /**
- * Tool function converting a string to a quoted string that can be inserted
+ * Tool function writing a string as a quoted string that can be inserted
  * into a JSON file. Adapted from public domain library "jsoncpp"
  * (http://sourceforge.net/projects/jsoncpp/).
  */
-gd::String StringToQuotedJSONString(const char* value) {
-  if (value == NULL) return "";
+void WriteQuotedJSONString(std::ostream& output, const char* value) {
+  if (value == NULL) return;
   // Not sure how to handle unicode...
   if (strpbrk(value, "\"\\\b\f\n\r\t") == NULL &&
-      !containsControlCharacter(value))
-    return gd::String("\"") + value + "\"";
-  // We have to walk value and escape any special characters.
-  // Appending to std::string is not efficient, but this should be rare.
-  // (Note: forward slashes are *not* rare, but I am not escaping them.)
-  std::string::size_type maxsize =
-      strlen(value) * 2 + 3;  // allescaped+quotes+NULL
-  std::string result;
-  result.reserve(maxsize);  // to avoid lots of mallocs
-  result += "\"";
+      !containsControlCharacter(value)) {
+    output << '"' << value << '"';
+    return;
+  }
+
+  output << '"';
   for (const char* c = value; *c != 0; ++c) {
     switch (*c) {
       case '\"':
-        result += "\\\"";
+        output << "\\\"";
         break;
       case '\\':
-        result += "\\\\";
+        output << "\\\\";
         break;
       case '\b':
-        result += "\\b";
+        output << "\\b";
         break;
       case '\f':
-        result += "\\f";
+        output << "\\f";
         break;
       case '\n':
-        result += "\\n";
+        output << "\\n";
         break;
       case '\r':
-        result += "\\r";
+        output << "\\r";
         break;
       case '\t':
-        result += "\\t";
+        output << "\\t";
         break;
       // case '/':
       // Even though \/ is considered a legal escape in JSON, a bare
@@ -176,34 +182,42 @@ gd::String StringToQuotedJSONString(const char* value) {
           std::ostringstream oss;
           oss << "\\u" << std::hex << std::uppercase << std::setfill('0')
               << std::setw(4) << static_cast<int>(*c);
-          result += oss.str();
+          output << oss.str();
         } else {
-          result += *c;
+          output << *c;
         }
         break;
     }
   }
-  result += "\"";
-  return gd::String::FromUTF8(result);
+  output << '"';
 }
 
-gd::String ValueToJSON(const SerializerValue& val) {
+void WriteValueJSON(std::ostream& output, const SerializerValue& val) {
+  // Numbers are formatted by gd::String::From so that the output does not
+  // depend on the state of the stream.
   if (val.IsBoolean())
-    return val.GetBool() ? "true" : "false";
+    output << (val.GetBool() ? "true" : "false");
   else if (val.IsInt())
-    return gd::String::From(val.GetInt());
+    output << gd::String::From(val.GetInt()).Raw();
   else if (val.IsDouble())
-    return gd::String::From(val.GetDouble());
+    output << gd::String::From(val.GetDouble()).Raw();
   else
-    return StringToQuotedJSONString(val.GetString().c_str());
+    WriteQuotedJSONString(output, val.GetString().c_str());
 }
 }  // namespace
 
 gd::String Serializer::ToJSON(const SerializerElement& element) {
+  std::ostringstream output;
+  ToJSON(element, output);
+  return gd::String::FromUTF8(output.str());
+}
+
+void Serializer::ToJSON(const SerializerElement& element,
+                        std::ostream& output) {
   if (element.IsValueUndefined()) {
     if (element.ConsideredAsArray()) {
       // Store the element as an array in JSON:
-      gd::String str = "[";
+      output << "[";
       bool firstChild = true;
 
       if (element.GetAllAttributes().size() > 0) {
@@ -232,16 +246,15 @@ gd::String Serializer::ToJSON(const SerializerElement& element) {
           continue;
         }
 
-        if (!firstChild) str += ",";
-        str += ToJSON(*children[i].second);
+        if (!firstChild) output << ",";
+        ToJSON(*children[i].second, output);
 
         firstChild = false;
       }
 
-      str += "]";
-      return str;
+      output << "]";
     } else {
-      gd::String str = "{";
+      output << "{";
       bool firstChild = true;
 
       const std::map<gd::String, SerializerValue>& attributes =
@@ -250,9 +263,10 @@ gd::String Serializer::ToJSON(const SerializerElement& element) {
                attributes.begin();
            it != attributes.end();
            ++it) {
-        if (!firstChild) str += ",";
-        str += StringToQuotedJSONString(it->first.c_str()) + ": " +
-               ValueToJSON(it->second);
+        if (!firstChild) output << ",";
+        WriteQuotedJSONString(output, it->first.c_str());
+        output << ": ";
+        WriteValueJSON(output, it->second);
 
         firstChild = false;
       }
@@ -273,231 +287,751 @@ gd::String Serializer::ToJSON(const SerializerElement& element) {
                     << std::endl;
         }
 
-        if (!firstChild) str += ",";
-        str += StringToQuotedJSONString(children[i].first.c_str()) + ": " +
-               ToJSON(*children[i].second);
+        if (!firstChild) output << ",";
+        WriteQuotedJSONString(output, children[i].first.c_str());
+        output << ": ";
+        ToJSON(*children[i].second, output);
 
         firstChild = false;
       }
 
-      str += "}";
-      return str;
+      output << "}";
     }
   } else {
-    return ValueToJSON(element.GetValue());
+    WriteValueJSON(output, element.GetValue());
   }
 }
 
 // Private functions for JSON parsing
 namespace {
-size_t SkipBlankChar(const std::string& str, size_t pos) {
-  const std::string blankChar = " \n";
-  return str.find_first_not_of(blankChar, pos);
+/**
+ * Return true if the bytes are a valid UTF-8 string. ASCII characters, which
+ * are most of the characters of a project, are checked 16 (or 8) at a time.
+ */
+bool IsValidUTF8(const char* data, std::size_t size) {
+  const unsigned char* c = reinterpret_cast<const unsigned char*>(data);
+  const unsigned char* end = c + size;
+  while (c < end) {
+#if defined(GD_SERIALIZER_SSE2)
+    while (end - c >= 16 &&
+           _mm_movemask_epi8(_mm_loadu_si128(
+               reinterpret_cast<const __m128i*>(c))) == 0)
+      c += 16;
+#else
+    std::uint64_t chunk;
+    while (end - c >= 8 &&
+           (std::memcpy(&chunk, c, 8), (chunk & 0x8080808080808080ULL) == 0))
+      c += 8;
+#endif
+    if (c >= end) break;
+    if (*c < 0x80) {
+      ++c;
+      continue;
+    }
+
+    // Check the lead byte and the range of the first continuation byte,
+    // rejecting overlong encodings, surrogates and code points > U+10FFFF.
+    std::size_t continuationsCount;
+    unsigned char min = 0x80, max = 0xBF;
+    if (*c >= 0xC2 && *c <= 0xDF)
+      continuationsCount = 1;
+    else if (*c >= 0xE0 && *c <= 0xEF) {
+      continuationsCount = 2;
+      if (*c == 0xE0) min = 0xA0;
+      if (*c == 0xED) max = 0x9F;
+    } else if (*c >= 0xF0 && *c <= 0xF4) {
+      continuationsCount = 3;
+      if (*c == 0xF0) min = 0x90;
+      if (*c == 0xF4) max = 0x8F;
+    } else
+      return false;
+
+    if (static_cast<std::size_t>(end - c) <= continuationsCount) return false;
+    if (c[1] < min || c[1] > max) return false;
+    for (std::size_t i = 2; i <= continuationsCount; ++i)
+      if (c[i] < 0x80 || c[i] > 0xBF) return false;
+
+    c += continuationsCount + 1;
+  }
+
+  return true;
+}
+
+/**
+ * Append a code point, encoded in UTF-8, to a string.
+ */
+void AppendUTF8(std::string& str, std::uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    str.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    str.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    str.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    str.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
 }
 
 /**
- * Adapted from https://github.com/hjiang/jsonxx
+ * \brief A single pass JSON parser, reading the JSON in place and filling a
+ * gd::SerializerElement.
+ *
+ * Strings without escaped characters are copied directly from the JSON to
+ * the element. The names of the children are decoded in a buffer reused for
+ * all of them.
  */
-std::string DecodeString(const std::string& original) {
-  std::string value;
-  value.reserve(original.size());
-  std::istringstream input("\"" + original + "\"");
-
-  char ch = '\0', delimiter = '"';
-  input.get(ch);
-  if (ch != delimiter) return "";
-
-  while (!input.eof() && input.good()) {
-    input.get(ch);
-    if (ch == delimiter) {
-      break;
+class JSONParser {
+ public:
+  JSONParser(const char* json, std::size_t size)
+      : begin(json),
+        current(json),
+        end(json + size),
+        validUTF8(IsValidUTF8(json, size)),
+        errorPosition(std::string::npos){};
+
+  /**
+   * \brief Parse the first JSON value of the string into the element.
+   * \return The position of the first error, or std::string::npos.
+   */
+  std::size_t Parse(gd::SerializerElement& element) {
+    if (ParseValue(element) || errorPosition != std::string::npos)
+      return errorPosition;
+
+    return SetError("Unexpected end of JSON");
+  }
+
+ private:
+  void SkipBlanks() {
+    while (current < end && (*current == ' ' || *current == '\n' ||
+                             *current == '\r' || *current == '\t'))
+      ++current;
+  }
+
+  bool SetError(const char* message) {
+    errorPosition = current - begin;
+    std::cout << "Parsing error at byte " << errorPosition << ": " << message
+              << "." << std::endl;
+    return false;
+  }
+
+  /**
+   * Return the position of the first quote or backslash, or end.
+   */
+  const char* FindQuoteOrBackslash(const char* c) {
+#if defined(GD_SERIALIZER_SSE2)
+    const __m128i quotes = _mm_set1_epi8('"');
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    while (end - c >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c));
+      int mask = _mm_movemask_epi8(
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes),
+                       _mm_cmpeq_epi8(chunk, backslashes)));
+      if (mask != 0) {
+        int index = 0;
+        while (!(mask & (1 << index))) ++index;
+        return c + index;
+      }
+      c += 16;
     }
-    if (ch == '\\') {
-      input.get(ch);
-      switch (ch) {
+#endif
+    while (c < end && *c != '"' && *c != '\\') ++c;
+    return c;
+  }
+
+  bool ParseHexadecimal(std::uint32_t& value) {
+    if (end - current < 4) return SetError("Invalid unicode escape sequence");
+
+    value = 0;
+    for (std::size_t i = 0; i < 4; ++i, ++current) {
+      char c = *current;
+      value <<= 4;
+      if (c >= '0' && c <= '9')
+        value |= c - '0';
+      else if (c >= 'a' && c <= 'f')
+        value |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        value |= c - 'A' + 10;
+      else
+        return SetError("Invalid unicode escape sequence");
+    }
+    return true;
+  }
+
+  /**
+   * Parse the string starting after the current quote into str.
+   */
+  bool ParseString(gd::String& str) {
+    std::string& raw = str.Raw();
+    raw.clear();
+    ++current;  // Skip the opening quote.
+    while (true) {
+      const char* stop = FindQuoteOrBackslash(current);
+      raw.append(current, stop);
+      current = stop;
+      if (current >= end) return SetError("Unterminated string");
+      if (*current == '"') break;
+
+      ++current;  // Skip the backslash.
+      if (current >= end) return SetError("Unterminated string");
+      char escaped = *current++;
+      switch (escaped) {
+        case '"':
         case '\\':
         case '/':
-          value.push_back(ch);
+          raw.push_back(escaped);
           break;
         case 'b':
-          value.push_back('\b');
+          raw.push_back('\b');
           break;
         case 'f':
-          value.push_back('\f');
+          raw.push_back('\f');
           break;
         case 'n':
-          value.push_back('\n');
+          raw.push_back('\n');
           break;
         case 'r':
-          value.push_back('\r');
+          raw.push_back('\r');
           break;
         case 't':
-          value.push_back('\t');
+          raw.push_back('\t');
           break;
         case 'u': {
-          int i;
-          std::stringstream ss;
-          for (i = 0; (!input.eof() && input.good()) && i < 4; ++i) {
-            input.get(ch);
-            ss << ch;
+          std::uint32_t codePoint;
+          if (!ParseHexadecimal(codePoint)) return false;
+          if (codePoint >= 0xD800 && codePoint <= 0xDBFF &&
+              end - current >= 6 && current[0] == '\\' && current[1] == 'u') {
+            // A surrogate pair, for code points above U+FFFF.
+            const char* lowSurrogateStart = current;
+            current += 2;
+            std::uint32_t lowSurrogate;
+            if (!ParseHexadecimal(lowSurrogate)) return false;
+            if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF)
+              codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                          (lowSurrogate - 0xDC00);
+            else
+              current = lowSurrogateStart;
           }
-          if (input.good() && (ss >> i)) value.push_back(i);
+          // Lone surrogates can't be encoded in UTF-8.
+          if (codePoint >= 0xD800 && codePoint <= 0xDFFF) codePoint = 0xFFFD;
+
+          AppendUTF8(raw, codePoint);
         } break;
         default:
-          if (ch != delimiter) {
-            value.push_back('\\');
-            value.push_back(ch);
-          } else
-            value.push_back(ch);
+          // Unknown escape sequences are kept as is.
+          raw.push_back('\\');
+          raw.push_back(escaped);
           break;
       }
+    }
+
+    ++current;  // Skip the closing quote.
+    if (!validUTF8) str.ReplaceInvalid();
+    return true;
+  }
+
+  bool ParseValue(gd::SerializerElement& element) {
+    SkipBlanks();
+    if (current >= end) return false;
+
+    if (*current == '{') {
+      ++current;
+      SkipBlanks();
+      if (current < end && *current == '}') {
+        ++current;
+        return true;
+      }
+
+      while (true) {
+        SkipBlanks();
+        if (current >= end || *current != '"')
+          return SetError("Expected the name of a child");
+        if (!ParseString(childName)) return false;
+
+        SkipBlanks();
+        if (current >= end || *current != ':')
+          return SetError("Expected ':' after the name of a child");
+        ++current;
+
+        if (!ParseValue(element.AddChild(childName))) {
+          if (errorPosition == std::string::npos)
+            SetError("Object not properly formed");
+          return false;
+        }
+
+        SkipBlanks();
+        if (current < end && *current == ',') {
+          ++current;
+          continue;
+        }
+        if (current < end && *current == '}') {
+          ++current;
+          return true;
+        }
+        return SetError("Object not properly formed");
+      }
+    } else if (*current == '[') {
+      element.ConsiderAsArray();
+      ++current;
+      SkipBlanks();
+      if (current < end && *current == ']') {
+        ++current;
+        return true;
+      }
+
+      while (true) {
+        if (!ParseValue(element.AddChild(""))) {
+          if (errorPosition == std::string::npos)
+            SetError("Element of array not properly formed");
+          return false;
+        }
+
+        SkipBlanks();
+        if (current < end && *current == ',') {
+          ++current;
+          continue;
+        }
+        if (current < end && *current == ']') {
+          ++current;
+          return true;
+        }
+        return SetError("Array not properly ended");
+      }
+    } else if (*current == '"') {
+      if (!ParseString(stringValue)) return false;
+
+      element.SetValue(stringValue);
+      return true;
     } else {
-      value.push_back(ch);
+      // Number or boolean (anything else is considered as 0).
+      const char* tokenStart = current;
+      while (current < end && *current != ' ' && *current != '\n' &&
+             *current != '\r' && *current != '\t' && *current != ',' &&
+             *current != '}' && *current != ']')
+        ++current;
+
+      std::size_t tokenSize = current - tokenStart;
+      if (tokenSize == 4 && std::memcmp(tokenStart, "true", 4) == 0)
+        element.SetValue(true);
+      else if (tokenSize == 5 && std::memcmp(tokenStart, "false", 5) == 0)
+        element.SetValue(false);
+      else {
+        // Read with a point as the decimal separator, whatever the locale.
+        numberBuffer.Raw().assign(tokenStart, current);
+        element.SetValue(numberBuffer.To<double>());
+      }
+      return true;
     }
   }
-  if (input && ch == delimiter) {
-    return value;
-  } else {
-    return "";
+
+  const char* begin;
+  const char* current;
+  const char* end;
+  bool validUTF8;  ///< If false, strings are checked one by one.
+  std::size_t errorPosition;
+
+  gd::String childName;    ///< Buffer for the names of the children.
+  gd::String stringValue;  ///< Buffer for the strings.
+  gd::String numberBuffer;  ///< Buffer for the numbers.
+};
+}  // namespace
+
+SerializerElement Serializer::FromJSON(const std::string& jsonStr) {
+  return FromJSON(jsonStr.data(), jsonStr.size());
+}
+
+SerializerElement Serializer::FromJSON(const char* json,
+                                       std::size_t size,
+                                       std::size_t* errorPosition) {
+  SerializerElement element;
+  std::size_t error = std::string::npos;
+  if (size > 0) {
+    JSONParser parser(json, size);
+    error = parser.Parse(element);
   }
+
+  if (errorPosition) *errorPosition = error;
+  return element;
 }
 
+// Private functions for binary serialization
+namespace {
+const char binaryMagic[4] = {'G', 'D', 'S', 'E'};
+const std::uint64_t binaryVersion = 1;
+
 /**
- * Return the position of the end of the string. Blank are skipped if necessary
- * @param str The string to be used
- * @param startPos The start position
- * @param strContent A reference to a string that will be filled with the string
- * content.
+ * The kinds of elements stored in the binary format.
  */
-size_t SkipString(const std::string& str,
-                  size_t startPos,
-                  std::string& strContent) {
-  startPos = SkipBlankChar(str, startPos);
-  if (startPos >= str.length()) return std::string::npos;
+enum BinaryKind {
+  BinaryContainer = 0,      ///< An element without value, with children.
+  BinaryFalse = 1,          ///< The boolean false.
+  BinaryTrue = 2,           ///< The boolean true.
+  BinaryInt = 3,            ///< Followed by a zigzag varint.
+  BinaryDouble = 4,         ///< Followed by the 8 bytes of the double.
+  BinaryIntegerDouble = 5,  ///< A double without fractional part, followed
+                            ///< by a zigzag varint.
+  BinaryString = 6,         ///< Followed by a length prefixed string.
+  BinaryUnknown = 7  ///< A value of unknown type, stored as a string.
+};
+
+std::uint64_t ZigZagEncode(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t ZigZagDecode(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+class BinaryWriter {
+ public:
+  BinaryWriter(std::ostream& output_) : output(output_){};
+
+  void Write(const gd::SerializerElement& root) {
+    CollectNames(root);
+
+    output.write(binaryMagic, sizeof(binaryMagic));
+    WriteVarint(binaryVersion);
+    WriteVarint(names.size());
+    for (const gd::String* name : names) WriteString(*name);
+
+    WriteElement(root);
+  }
 
-  size_t endPos = startPos;
+ private:
+  void AddName(const gd::String& name) {
+    if (namesIndex.emplace(name, names.size()).second)
+      names.push_back(&name);
+  }
+
+  void CollectNames(const gd::SerializerElement& element) {
+    if (!element.IsValueUndefined()) return;
+
+    if (element.ConsideredAsArray()) AddName(element.ConsideredAsArrayOf());
+    for (const auto& attribute : element.GetAllAttributes())
+      AddName(attribute.first);
+    for (const auto& child : element.GetAllChildren()) {
+      if (!child.second) continue;
 
-  if (str[startPos] == '"') {
-    if (startPos + 1 >= str.length()) return std::string::npos;
+      AddName(child.first);
+      CollectNames(*child.second);
+    }
+  }
 
-    while (endPos == startPos || (str[endPos - 1] == '\\')) {
-      endPos = str.find_first_of('\"', endPos + 1);
-      if (endPos == std::string::npos)
-        return std::string::npos;  // Invalid string
+  void WriteVarint(std::uint64_t value) {
+    char buffer[10];
+    std::size_t size = 0;
+    while (value >= 0x80) {
+      buffer[size++] = static_cast<char>((value & 0x7F) | 0x80);
+      value >>= 7;
     }
+    buffer[size++] = static_cast<char>(value);
+    output.write(buffer, size);
+  }
 
-    strContent = DecodeString(str.substr(startPos + 1, endPos - 1 - startPos));
-    return endPos;
+  void WriteString(const gd::String& str) {
+    WriteVarint(str.Raw().size());
+    output.write(str.Raw().data(), str.Raw().size());
   }
 
-  endPos = str.find_first_of(" \n,:");
-  if (endPos >= str.length()) return std::string::npos;  // Invalid string
+  void WriteName(const gd::String& name) {
+    WriteVarint(namesIndex.find(name)->second);
+  }
 
-  strContent = DecodeString(str.substr(startPos, endPos - 1 - startPos));
-  return endPos - 1;
-}
+  void WriteValue(const gd::SerializerValue& value) {
+    if (value.IsBoolean()) {
+      output.put(value.GetBool() ? BinaryTrue : BinaryFalse);
+    } else if (value.IsInt()) {
+      output.put(BinaryInt);
+      WriteVarint(ZigZagEncode(value.GetInt()));
+    } else if (value.IsDouble()) {
+      double number = value.GetDouble();
+      // Most numbers of a project (positions, sizes...) are integers: store
+      // them as varints. -0 is kept as a double to be restored as is.
+      if (number >= -9007199254740992.0 && number <= 9007199254740992.0 &&
+          number == static_cast<double>(static_cast<std::int64_t>(number)) &&
+          !(number == 0 && std::signbit(number))) {
+        output.put(BinaryIntegerDouble);
+        WriteVarint(ZigZagEncode(static_cast<std::int64_t>(number)));
+      } else {
+        std::uint64_t bits;
+        std::memcpy(&bits, &number, sizeof(bits));
+        char buffer[8];
+        for (std::size_t i = 0; i < 8; ++i)
+          buffer[i] = static_cast<char>(bits >> (i * 8));  // Little endian.
+
+        output.put(BinaryDouble);
+        output.write(buffer, sizeof(buffer));
+      }
+    } else {
+      output.put(value.IsString() ? BinaryString : BinaryUnknown);
+      WriteString(value.GetString());
+    }
+  }
+
+  void WriteElement(const gd::SerializerElement& element) {
+    if (!element.IsValueUndefined()) {
+      WriteValue(element.GetValue());
+      return;
+    }
+
+    output.put(BinaryContainer);
+    WriteVarint(element.ConsideredAsArray() ? 1 : 0);
+    if (element.ConsideredAsArray())
+      WriteName(element.ConsideredAsArrayOf());
+
+    const std::map<gd::String, SerializerValue>& attributes =
+        element.GetAllAttributes();
+    WriteVarint(attributes.size());
+    for (const auto& attribute : attributes) {
+      WriteName(attribute.first);
+      WriteValue(attribute.second);
+    }
+
+    const std::vector<
+        std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
+        children = element.GetAllChildren();
+    std::size_t childrenCount = 0;
+    for (const auto& child : children)
+      if (child.second) childrenCount++;
+
+    WriteVarint(childrenCount);
+    for (const auto& child : children) {
+      if (!child.second) continue;
+
+      WriteName(child.first);
+      WriteElement(*child.second);
+    }
+  }
+
+  std::ostream& output;
+  std::unordered_map<gd::String, std::size_t> namesIndex;
+  std::vector<const gd::String*> names;  ///< The names, in the order of
+                                         ///< their index.
+};
 
 /**
- * Parse a JSON string, starting from pos, and storing the result into the
- * specified element. Note that the parsing is stopped as soon as a valid object
- * is parsed. \return The position at the end of the valid object stored into
- * the element.
+ * \brief Read the binary format in place, filling a gd::SerializerElement.
  */
-size_t ParseJSONObject(const std::string& jsonStr,
-                       size_t startPos,
-                       gd::SerializerElement& element) {
-  size_t pos = SkipBlankChar(jsonStr, startPos);
-  if (pos >= jsonStr.length()) return std::string::npos;
-
-  if (jsonStr[pos] == '{')  // Object
-  {
-    bool firstChild = true;
-    while (firstChild || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == '}') break;
-
-      std::string childName;
-      pos = SkipString(jsonStr, pos, childName);
-
-      pos++;
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length() || jsonStr[pos] != ':')
-        return std::string::npos;
-
-      pos++;
-      pos = ParseJSONObject(
-          jsonStr,
-          pos,
-          element.AddChild(gd::String::FromUTF8(childName).ReplaceInvalid()));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) return std::string::npos;
-      firstChild = false;
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, std::size_t size)
+      : begin(reinterpret_cast<const unsigned char*>(data)),
+        current(begin),
+        end(begin + size),
+        errorPosition(std::string::npos){};
+
+  /**
+   * \brief Read the element.
+   * \return The position of the first error, or std::string::npos.
+   */
+  std::size_t Read(gd::SerializerElement& root) {
+    if (static_cast<std::size_t>(end - begin) < sizeof(binaryMagic) ||
+        std::memcmp(begin, binaryMagic, sizeof(binaryMagic)) != 0) {
+      SetError("Not a binary serialized element");
+      return errorPosition;
     }
+    current += sizeof(binaryMagic);
 
-    if (jsonStr[pos] != '}') {
-      std::cout << "Parsing error: Object not properly formed.";
-      return std::string::npos;
+    std::uint64_t version, namesCount;
+    if (!ReadVarint(version)) return errorPosition;
+    if (version != binaryVersion) {
+      current = begin + sizeof(binaryMagic);
+      SetError("Unsupported version");
+      return errorPosition;
     }
-    return pos + 1;
-  } else if (jsonStr[pos] == '[')  // Array
-  {
-    element.ConsiderAsArray();
-    unsigned int index = 0;
-    while (index == 0 || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == ']') break;
-      pos = ParseJSONObject(jsonStr, pos, element.AddChild(""));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) {
-        std::cout << "Parsing error: element of array not properly formed.";
-        return std::string::npos;
+
+    if (!ReadVarint(namesCount)) return errorPosition;
+    if (namesCount > static_cast<std::uint64_t>(end - current)) {
+      SetError("Invalid names count");
+      return errorPosition;
+    }
+    names.resize(namesCount);
+    for (auto& name : names)
+      if (!ReadString(name)) return errorPosition;
+
+    ReadElement(root);
+    return errorPosition;
+  }
+
+ private:
+  bool SetError(const char* message) {
+    errorPosition = current - begin;
+    std::cout << "Binary parsing error at byte " << errorPosition << ": "
+              << message << "." << std::endl;
+    return false;
+  }
+
+  bool ReadByte(unsigned char& byte) {
+    if (current >= end) return SetError("Unexpected end of data");
+    byte = *current++;
+    return true;
+  }
+
+  bool ReadVarint(std::uint64_t& value) {
+    value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+      unsigned char byte;
+      if (!ReadByte(byte)) return false;
+
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return true;
+    }
+
+    return SetError("Invalid varint");
+  }
+
+  bool ReadString(gd::String& str) {
+    std::uint64_t size;
+    if (!ReadVarint(size)) return false;
+    if (size > static_cast<std::uint64_t>(end - current))
+      return SetError("Unexpected end of data");
+
+    str.Raw().assign(reinterpret_cast<const char*>(current), size);
+    current += size;
+    return true;
+  }
+
+  bool ReadName(const gd::String*& name) {
+    std::uint64_t index;
+    if (!ReadVarint(index)) return false;
+    if (index >= names.size()) return SetError("Invalid name index");
+
+    name = &names[index];
+    return true;
+  }
+
+  /**
+   * Read a value and set it as the value of the element.
+   */
+  bool ReadValue(unsigned char kind, gd::SerializerElement& target) {
+    std::uint64_t number;
+    switch (kind) {
+      case BinaryFalse:
+      case BinaryTrue:
+        target.SetBoolValue(kind == BinaryTrue);
+        return true;
+      case BinaryInt:
+        if (!ReadVarint(number)) return false;
+        target.SetIntValue(static_cast<int>(ZigZagDecode(number)));
+        return true;
+      case BinaryIntegerDouble:
+        if (!ReadVarint(number)) return false;
+        target.SetDoubleValue(static_cast<double>(ZigZagDecode(number)));
+        return true;
+      case BinaryDouble: {
+        if (end - current < 8) return SetError("Unexpected end of data");
+        std::uint64_t bits = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+          bits |= static_cast<std::uint64_t>(current[i]) << (i * 8);
+        current += 8;
+
+        double doubleValue;
+        std::memcpy(&doubleValue, &bits, sizeof(doubleValue));
+        target.SetDoubleValue(doubleValue);
+        return true;
+      }
+      case BinaryString:
+        if (!ReadString(stringValue)) return false;
+        target.SetStringValue(stringValue);
+        return true;
+      case BinaryUnknown: {
+        if (!ReadString(stringValue)) return false;
+        gd::SerializerValue value;
+        value.Set(stringValue);
+        target.SetValue(value);
+        return true;
       }
-      index++;
+      default:
+        current--;
+        return SetError("Unknown kind of element");
     }
+  }
+
+  bool ReadElement(gd::SerializerElement& element) {
+    unsigned char kind;
+    if (!ReadByte(kind)) return false;
+    if (kind != BinaryContainer) return ReadValue(kind, element);
 
-    if (jsonStr[pos] != ']') {
-      std::cout << "Parsing error: array not properly ended";
-      return std::string::npos;
+    std::uint64_t flags, attributesCount, childrenCount;
+    if (!ReadVarint(flags)) return false;
+    if (flags & 1) {
+      const gd::String* arrayOf;
+      if (!ReadName(arrayOf)) return false;
+      element.ConsiderAsArrayOf(*arrayOf);
     }
-    return pos + 1;
-  } else if (jsonStr[pos] == '"')  // String
-  {
-    std::string str;
-    pos = SkipString(jsonStr, pos, str);
-    if (pos >= jsonStr.length()) {
-      std::cout << "Parsing error: Invalid string";
-      return std::string::npos;
+
+    if (!ReadVarint(attributesCount)) return false;
+    for (std::uint64_t i = 0; i < attributesCount; ++i) {
+      const gd::String* name;
+      unsigned char valueKind;
+      gd::SerializerElement attribute;
+      if (!ReadName(name) || !ReadByte(valueKind) ||
+          !ReadValue(valueKind, attribute))
+        return false;
+
+      const gd::SerializerValue& value = attribute.GetValue();
+      if (value.IsBoolean())
+        element.SetAttribute(*name, value.GetBool());
+      else if (value.IsInt())
+        element.SetAttribute(*name, value.GetInt());
+      else if (value.IsDouble())
+        element.SetAttribute(*name, value.GetDouble());
+      else
+        element.SetAttribute(*name, value.GetString());
     }
 
-    element.SetValue(gd::String::FromUTF8(str).ReplaceInvalid());
-    return pos + 1;
-  } else  // Number or boolean
-  {
-    std::string str;
-    size_t endPos = pos;
-    const std::string separators = " \n,}]";
-    while (endPos < jsonStr.length() &&
-           separators.find_first_of(jsonStr[endPos]) == std::string::npos) {
-      endPos++;
+    if (!ReadVarint(childrenCount)) return false;
+    for (std::uint64_t i = 0; i < childrenCount; ++i) {
+      const gd::String* name;
+      if (!ReadName(name) || !ReadElement(element.AddChild(*name)))
+        return false;
     }
 
-    str = jsonStr.substr(pos, endPos - pos);
-    if (str == "true")
-      element.SetValue(true);
-    else if (str == "false")
-      element.SetValue(false);
-    else
-      element.SetValue(gd::String::FromUTF8(str).To<double>());
-    return endPos;
+    return true;
   }
-}
+
+  const unsigned char* begin;
+  const unsigned char* current;
+  const unsigned char* end;
+  std::size_t errorPosition;
+
+  std::vector<gd::String> names;  ///< The table of names.
+  gd::String stringValue;         ///< Buffer for the strings.
+};
 }  // namespace
 
-SerializerElement Serializer::FromJSON(const std::string& jsonStr) {
+void Serializer::ToBinary(const SerializerElement& element,
+                          std::ostream& output) {
+  BinaryWriter writer(output);
+  writer.Write(element);
+}
+
+std::string Serializer::ToBinary(const SerializerElement& element) {
+  std::ostringstream output;
+  ToBinary(element, output);
+  return output.str();
+}
+
+bool Serializer::IsBinary(const char* data, std::size_t size) {
+  return size >= sizeof(binaryMagic) &&
+         std::memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+SerializerElement Serializer::FromBinary(const char* data,
+                                         std::size_t size,
+                                         std::size_t* errorPosition) {
   SerializerElement element;
-  if (!jsonStr.empty()) gd::ParseJSONObject(jsonStr, 0, element);
+  BinaryReader reader(data, size);
+  std::size_t error = reader.Read(element);
+
+  if (errorPosition) *errorPosition = error;
   return element;
 }
 
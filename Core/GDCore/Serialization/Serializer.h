@@ -6,6 +6,8 @@
 
 #ifndef GDCORE_SERIALIZER_H
 #define GDCORE_SERIALIZER_H
+#include <cstddef>
+#include <iosfwd>
 #include <string>
 #include "GDCore/Serialization/SerializerElement.h"
 class TiXmlElement;
@@ -42,14 +44,83 @@ class GD_CORE_API Serializer {
    */
   static gd::String ToJSON(const SerializerElement& element);
 
+  /**
+   * \brief Serialize a gd::SerializerElement to JSON, writing it in the
+   * stream as it goes.
+   *
+   * Prefer this to the gd::String version for large elements (like a whole
+   * project): the JSON is never stored in memory.
+   */
+  static void ToJSON(const SerializerElement& element, std::ostream& output);
+
+  /**
+   * \brief Parse a JSON string, encoded in UTF-8, and returns a
+   * gd::SerializerElement for it.
+   */
   static SerializerElement FromJSON(const std::string& json);
 
   /**
    * \brief Parse a JSON string and returns a gd::SerializerElement for it.
    */
   static SerializerElement FromJSON(const gd::String& json) {
-    return FromJSON(json.ToUTF8());
+    return FromJSON(json.Raw());
   }
+
+  /**
+   * \brief Parse the JSON stored in a buffer (for example a memory-mapped
+   * file), encoded in UTF-8, and returns a gd::SerializerElement for it.
+   *
+   * The JSON is read in a single pass, without being copied.
+   *
+   * \param json The JSON to parse. It does not have to be null terminated.
+   * \param size The size of the JSON, in bytes.
+   * \param errorPosition If not null, set to the position (in bytes) of the
+   * first error in the JSON, or std::string::npos if the JSON is valid.
+   */
+  static SerializerElement FromJSON(const char* json,
+                                    std::size_t size,
+                                    std::size_t* errorPosition = NULL);
+  ///@}
+
+  /** \name Binary serialization.
+   * Serialize a SerializerElement from/to a compact binary format, faster to
+   * read and smaller than JSON.
+   *
+   * The format starts with "GDSE" and a version number, followed by a table
+   * of the names of the children and attributes (each name being stored
+   * once), and then by the root element. Numbers are stored as varints when
+   * possible, strings and lists of children are prefixed by their length.
+   */
+  ///@{
+  /**
+   * \brief Serialize a gd::SerializerElement to the binary format, writing
+   * it in the stream.
+   */
+  static void ToBinary(const SerializerElement& element, std::ostream& output);
+
+  /**
+   * \brief Serialize a gd::SerializerElement to the binary format.
+   */
+  static std::string ToBinary(const SerializerElement& element);
+
+  /**
+   * \brief Return true if the data starts like an element serialized to the
+   * binary format.
+   */
+  static bool IsBinary(const char* data, std::size_t size);
+
+  /**
+   * \brief Read an element serialized to the binary format, stored in a
+   * buffer (for example a memory-mapped file).
+   *
+   * \param data The serialized element.
+   * \param size The size of the data, in bytes.
+   * \param errorPosition If not null, set to the position (in bytes) of the
+   * first error in the data, or std::string::npos if the data is valid.
+   */
+  static SerializerElement FromBinary(const char* data,
+                                      std::size_t size,
+                                      std::size_t* errorPosition = NULL);
   ///@}
 
   virtual ~Serializer(){};
@@ -1,15 +1,20 @@
 #include "GDCore/Serialization/SerializerElement.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace gd {
 
 SerializerElement SerializerElement::nullElement;
 
-SerializerElement::SerializerElement() : valueUndefined(true), isArray(false) {}
+SerializerElement::SerializerElement()
+    : valueUndefined(true), childrenHaveSameName(true), isArray(false) {}
 
 SerializerElement::SerializerElement(const SerializerValue& value)
-    : valueUndefined(false), elementValue(value), isArray(false) {}
+    : valueUndefined(false),
+      elementValue(value),
+      childrenHaveSameName(true),
+      isArray(false) {}
 
 SerializerElement::~SerializerElement() {}
 
@@ -154,16 +159,22 @@ SerializerElement& SerializerElement::AddChild(gd::String name) {
 
   // In case of children of objects, there can be only one child with
   // a given name.
-  // Note: searching for the existing children is O(number of children). This
-  // could be improved, but in practice has no visible impact on saving
-  // large projects.
-  if (!isArray && HasChild(name)) {
-    return GetChild(name);
+  if (!isArray) {
+    std::size_t position = FindChildPosition(name, "");
+    if (position != std::string::npos) return *children[position].second;
   }
 
-  std::shared_ptr<SerializerElement> newElement(new SerializerElement);
+  std::shared_ptr<SerializerElement> newElement =
+      std::make_shared<SerializerElement>();
   children.push_back(std::make_pair(name, newElement));
 
+  if (children.size() > 1 && name != children[0].first)
+    childrenHaveSameName = false;
+  if (children.size() == childrenIndexMinimumSize)
+    UpdateChildrenIndex();
+  else if (children.size() > childrenIndexMinimumSize)
+    childrenIndex.emplace(name, children.size() - 1);
+
   return *newElement;
 }
 
@@ -175,17 +186,24 @@ SerializerElement& SerializerElement::GetChild(std::size_t index) const {
     return nullElement;
   }
 
-  std::size_t currentIndex = 0;
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == arrayOf || children[i].first.empty() ||
-        (!deprecatedArrayOf.empty() &&
-         children[i].first == deprecatedArrayOf)) {
-      if (index == currentIndex)
-        return *children[i].second;
-      else
-        currentIndex++;
+  if (childrenHaveSameName) {
+    // Either all the children are elements of the array, or none is.
+    if (index < children.size() &&
+        SameNameChildrenMatch(arrayOf, deprecatedArrayOf))
+      return *children[index].second;
+  } else {
+    std::size_t currentIndex = 0;
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
+
+      if (children[i].first == arrayOf || children[i].first.empty() ||
+          (!deprecatedArrayOf.empty() &&
+           children[i].first == deprecatedArrayOf)) {
+        if (index == currentIndex)
+          return *children[i].second;
+        else
+          currentIndex++;
+      }
     }
   }
 
@@ -206,17 +224,25 @@ SerializerElement& SerializerElement::GetChild(
     }
   }
 
-  std::size_t currentIndex = 0;
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == name ||
-        (isArray && children[i].first.empty()) ||
-        (!deprecatedName.empty() && children[i].first == deprecatedName)) {
-      if (index == currentIndex)
-        return *children[i].second;
-      else
-        currentIndex++;
+  if (childrenHaveSameName) {
+    if (index < children.size() && SameNameChildrenMatch(name, deprecatedName))
+      return *children[index].second;
+  } else if (!isArray && index == 0) {
+    std::size_t position = FindChildPosition(name, deprecatedName);
+    if (position != std::string::npos) return *children[position].second;
+  } else {
+    std::size_t currentIndex = 0;
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
+
+      if (children[i].first == name ||
+          (isArray && children[i].first.empty()) ||
+          (!deprecatedName.empty() && children[i].first == deprecatedName)) {
+        if (index == currentIndex)
+          return *children[i].second;
+        else
+          currentIndex++;
+      }
     }
   }
 
@@ -240,6 +266,9 @@ std::size_t SerializerElement::GetChildrenCount(
     deprecatedName = deprecatedArrayOf;
   }
 
+  if (childrenHaveSameName)
+    return SameNameChildrenMatch(name, deprecatedName) ? children.size() : 0;
+
   std::size_t currentIndex = 0;
   for (size_t i = 0; i < children.size(); ++i) {
     if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
@@ -255,23 +284,71 @@ std::size_t SerializerElement::GetChildrenCount(
 
 bool SerializerElement::HasChild(const gd::String& name,
                                  gd::String deprecatedName) const {
+  return FindChildPosition(name, deprecatedName) != std::string::npos;
+}
+
+void SerializerElement::RemoveChild(const gd::String& name) {
+  bool removed = false;
+  for (size_t i = 0; i < children.size();) {
+    if (children[i].first == name) {
+      children.erase(children.begin() + i);
+      removed = true;
+    } else
+      ++i;
+  }
+
+  if (removed) UpdateChildrenIndex();
+}
+
+std::size_t SerializerElement::FindChildPosition(
+    const gd::String& name, const gd::String& deprecatedName) const {
+  if (!childrenIndex.empty()) {
+    std::size_t position = std::string::npos;
+    auto it = childrenIndex.find(name);
+    if (it != childrenIndex.end()) position = it->second;
+    if (!deprecatedName.empty()) {
+      it = childrenIndex.find(deprecatedName);
+      if (it != childrenIndex.end()) position = std::min(position, it->second);
+    }
+
+    return position;
+  }
+
   for (size_t i = 0; i < children.size(); ++i) {
     if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
 
     if (children[i].first == name ||
         (!deprecatedName.empty() && children[i].first == deprecatedName))
-      return true;
+      return i;
   }
 
-  return false;
+  return std::string::npos;
 }
 
-void SerializerElement::RemoveChild(const gd::String& name) {
-  for (size_t i = 0; i < children.size();) {
-    if (children[i].first == name)
-      children.erase(children.begin() + i);
-    else
-      ++i;
+bool SerializerElement::SameNameChildrenMatch(
+    const gd::String& name, const gd::String& deprecatedName) const {
+  if (children.empty()) return false;
+
+  const gd::String& childrenName = children[0].first;
+  return childrenName == name || (isArray && childrenName.empty()) ||
+         (!deprecatedName.empty() && childrenName == deprecatedName);
+}
+
+void SerializerElement::UpdateChildrenIndex() {
+  childrenHaveSameName = true;
+  for (size_t i = 1; i < children.size(); ++i) {
+    if (children[i].first != children[0].first) {
+      childrenHaveSameName = false;
+      break;
+    }
+  }
+
+  childrenIndex.clear();
+  if (children.size() >= childrenIndexMinimumSize) {
+    // Only the first child with a given name is indexed (emplace does not
+    // replace existing entries).
+    for (size_t i = 0; i < children.size(); ++i)
+      childrenIndex.emplace(children[i].first, i);
   }
 }
 
@@ -281,12 +358,13 @@ void SerializerElement::Init(const gd::SerializerElement& other) {
   attributes = other.attributes;
 
   children.clear();
+  children.reserve(other.children.size());
   for (const auto& child : other.children) {
-    children.push_back(
-        std::make_pair(child.first,
-                       std::shared_ptr<SerializerElement>(
-                           new SerializerElement(*child.second))));
+    children.push_back(std::make_pair(
+        child.first, std::make_shared<SerializerElement>(*child.second)));
   }
+  childrenHaveSameName = other.childrenHaveSameName;
+  childrenIndex = other.childrenIndex;
 
   isArray = other.isArray;
   arrayOf = other.arrayOf;
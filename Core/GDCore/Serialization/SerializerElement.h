@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "GDCore/Serialization/SerializerValue.h"
 #include "GDCore/String.h"
@@ -27,8 +28,10 @@ namespace gd {
  * It also has specialized methods in GDevelop.js (see postjs.js) to be
  * converted to a JavaScript object.
  *
- * \note Children are stored with their order preserved, but this also
- * means that their access/removal is O(number of children). This class
+ * \note Children are stored with their order preserved. Elements with many
+ * children also index them by name, and children of arrays having all the
+ * same name are accessed directly by their index, so that accessing a child
+ * is O(1) in most cases. Removing a child is O(number of children). This class
  * is not appropriated for a use in game where fast access is required.
  *
  * \see gd::Serializer
@@ -412,7 +415,6 @@ class GD_CORE_API SerializerElement {
 
   /**
    * \brief Return true if the specified child exists.
-   * \note Complexity is O(number of children).
    * \param name The name of the child to find.
    */
   bool HasChild(const gd::String &name, gd::String deprecatedName = "") const;
@@ -442,12 +444,44 @@ class GD_CORE_API SerializerElement {
    */
   void Init(const gd::SerializerElement& other);
 
+  /**
+   * Return the position of the first child having the specified name (or the
+   * deprecated name), or std::string::npos.
+   */
+  std::size_t FindChildPosition(const gd::String& name,
+                                const gd::String& deprecatedName) const;
+
+  /**
+   * Return true if all the children are matched by the name (or the
+   * deprecated name, or the empty name for arrays). Only valid if the
+   * children have the same name.
+   */
+  bool SameNameChildrenMatch(const gd::String& name,
+                             const gd::String& deprecatedName) const;
+
+  /**
+   * Update childrenHaveSameName and childrenIndex after the children were
+   * changed.
+   */
+  void UpdateChildrenIndex();
+
+  /**
+   * The number of children from which children are indexed by name.
+   */
+  static const std::size_t childrenIndexMinimumSize = 16;
+
   bool valueUndefined;  ///< If true, the element does not have a value.
   SerializerValue elementValue;
 
   std::map<gd::String, SerializerValue> attributes;
   std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement> > >
       children;
+  bool childrenHaveSameName;  ///< true if all the children have the name of
+                              ///< the first one.
+  std::unordered_map<gd::String, std::size_t>
+      childrenIndex;  ///< The position of the first child with each name.
+                      ///< Empty if there are less than
+                      ///< childrenIndexMinimumSize children.
   mutable bool isArray;        ///< true if element is considered as an array
   mutable gd::String arrayOf;  ///< The name of the children (was useful for XML
                                ///< parsed elements).
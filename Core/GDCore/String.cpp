@@ -6,6 +6,13 @@
 
 #include "GDCore/String.h"
 
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <SFML/System/String.hpp>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Utf8/utf8proc.h"
@@ -13,24 +20,165 @@
 namespace gd
 {
 
+namespace priv
+{
+    /**
+     * \return the position of the character following the one starting at
+     * **position**, moving like String::const_iterator but without going past
+     * the end of truncated sequences.
+     */
+    std::string::size_type GetNextCharacter( const std::string &str, std::string::size_type position )
+    {
+        std::string::size_type length = ::utf8::internal::sequence_length(str.begin() + position);
+        return std::min(position + std::max<std::string::size_type>(length, 1), str.size());
+    }
+
+    /**
+     * \return true if none of the 8 bytes starting at **bytes** is part of a
+     * multi-byte character.
+     */
+    bool AreASCIIBytes( const char *bytes )
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return (word & UINT64_C(0x8080808080808080)) == 0;
+    }
+
+    /**
+     * Write the digits of **value** before **end**.
+     * \return a pointer to the first digit.
+     */
+    char* WriteDigits( unsigned long long value, char *end )
+    {
+        do
+        {
+            *--end = '0' + value % 10;
+            value /= 10;
+        } while(value != 0);
+
+        return end;
+    }
+
+    /**
+     * Replace the decimal point of the current C locale by a dot in the
+     * **length** characters formatted by snprintf in **buffer**.
+     * \return the new length.
+     */
+    std::size_t UseDotAsDecimalPoint( char *buffer, std::size_t length )
+    {
+        const char *point = std::localeconv()->decimal_point;
+        if(point[0] == '.' && point[1] == '\0')
+            return length;
+
+        char *pointPos = std::strstr(buffer, point);
+        if(!pointPos)
+            return length;
+
+        std::size_t pointLength = std::strlen(point);
+        *pointPos = '.';
+        std::memmove(pointPos + 1, pointPos + pointLength, buffer + length - pointPos - pointLength + 1);
+        return length - pointLength + 1;
+    }
+
+    bool IsSpace( char c )
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    bool IsDigit( char c )
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * Copy in **buffer** the characters that std::num_get would use to read a
+     * floating point number at the beginning of **str**, with the decimal
+     * point of the current C locale so that the number can be read by strtod.
+     * \return false if the number is too long for the buffer.
+     */
+    bool ExtractFloatingPointNumber( const char *str, char (&buffer)[64] )
+    {
+        const char *point = std::localeconv()->decimal_point;
+        std::size_t pointLength = std::strlen(point);
+
+        while(IsSpace(*str))
+            ++str;
+
+        std::size_t length = 0;
+        bool foundDigit = false, foundPoint = false, foundExponent = false;
+        if(*str == '+' || *str == '-')
+            buffer[length++] = *str++;
+
+        for(;; ++str)
+        {
+            if(length + pointLength + 1 >= sizeof(buffer))
+                return false;
+
+            if(IsDigit(*str))
+            {
+                buffer[length++] = *str;
+                foundDigit = true;
+            }
+            else if(*str == '.' && !foundPoint && !foundExponent)
+            {
+                std::memcpy(buffer + length, point, pointLength);
+                length += pointLength;
+                foundPoint = true;
+            }
+            else if((*str == 'e' || *str == 'E') && foundDigit && !foundExponent)
+            {
+                buffer[length++] = 'e';
+                foundExponent = true;
+                if(str[1] == '+' || str[1] == '-')
+                    buffer[length++] = *++str;
+            }
+            else
+                break;
+        }
+
+        buffer[length] = '\0';
+        return true;
+    }
+
+    /**
+     * Finish reading a floating point number converted by **convert** (strtod
+     * or similar) like std::num_get: 0 if the number is not valid and the
+     * maximum value if it overflows.
+     */
+    template<typename T, typename Convert>
+    T ConvertFloatingPointNumber( const char *buffer, Convert convert )
+    {
+        char *end;
+        T value = convert(buffer, &end);
+        if(end == buffer || *end != '\0')
+            return 0;
+        if(value == std::numeric_limits<T>::infinity())
+            return std::numeric_limits<T>::max();
+        if(value == -std::numeric_limits<T>::infinity())
+            return -std::numeric_limits<T>::max();
+
+        return value;
+    }
+}
+
 constexpr String::size_type String::npos;
 
-String::String() : m_string()
+String::String() : m_string(), m_size(0)
 {
 
 }
 
-String::String(const char *characters) : m_string()
+String::String(const char *characters) : m_string(), m_size(npos)
 {
     *this = characters;
 }
 
-String::String(const sf::String &string) : m_string()
+String::String(const sf::String &string) : m_string(), m_size(0)
 {
     *this = string;
 }
 
-String::String(const std::u32string &string) : m_string()
+String::String(const std::u32string &string) : m_string(), m_size(0)
 {
     *this = string;
 }
@@ -38,12 +186,13 @@ String::String(const std::u32string &string) : m_string()
 String& String::operator=(const char *characters)
 {
     m_string = std::string(characters);
+    m_size.store(npos, std::memory_order_relaxed);
     return *this;
 }
 
 String& String::operator=(const sf::String &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -63,7 +212,7 @@ String& String::operator=(const sf::String &string)
 
 String& String::operator=(const std::u32string &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -81,9 +230,159 @@ String& String::operator=(const std::u32string &string)
     return *this;
 }
 
+String String::FromNumber(long long value)
+{
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *begin = priv::WriteDigits(value < 0 ? 0 - static_cast<unsigned long long>(value) : value, end);
+    if(value < 0)
+        *--begin = '-';
+
+    String str;
+    str.m_string.assign(begin, end);
+    str.m_size.store(end - begin, std::memory_order_relaxed);
+    return str;
+}
+
+String String::FromNumber(unsigned long long value)
+{
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *begin = priv::WriteDigits(value, end);
+
+    String str;
+    str.m_string.assign(begin, end);
+    str.m_size.store(end - begin, std::memory_order_relaxed);
+    return str;
+}
+
+String String::FromNumber(double value)
+{
+    //Integers with less than 7 digits are written the same way by "%g".
+    if(value > -1e6 && value < 1e6 && value == static_cast<long long>(value) &&
+        !(value == 0 && std::signbit(value)))
+        return FromNumber(static_cast<long long>(value));
+
+    //Same format as std::ostringstream, which uses snprintf.
+    char buffer[64];
+    std::size_t length = std::snprintf(buffer, sizeof(buffer), "%.*g", 6, value);
+    length = priv::UseDotAsDecimalPoint(buffer, length);
+
+    String str;
+    str.m_string.assign(buffer, length);
+    str.m_size.store(length, std::memory_order_relaxed);
+    return str;
+}
+
+String String::FromNumber(long double value)
+{
+    char buffer[64];
+    std::size_t length = std::snprintf(buffer, sizeof(buffer), "%.*Lg", 6, value);
+    length = priv::UseDotAsDecimalPoint(buffer, length);
+
+    String str;
+    str.m_string.assign(buffer, length);
+    str.m_size.store(length, std::memory_order_relaxed);
+    return str;
+}
+
+bool String::ReadInteger(bool &negative, bool &overflow, unsigned long long &magnitude) const
+{
+    const char *str = m_string.c_str();
+    while(priv::IsSpace(*str))
+        ++str;
+
+    negative = *str == '-';
+    if(*str == '+' || *str == '-')
+        ++str;
+
+    if(!priv::IsDigit(*str))
+        return false;
+
+    const unsigned long long max = std::numeric_limits<unsigned long long>::max();
+    overflow = false;
+    magnitude = 0;
+    for(; priv::IsDigit(*str) && !overflow; ++str)
+    {
+        unsigned digit = *str - '0';
+        overflow = magnitude > (max - digit) / 10;
+        magnitude = magnitude * 10 + digit;
+    }
+
+    return true;
+}
+
+void String::ToNumber(float &value) const
+{
+    char buffer[64];
+    if(!priv::ExtractFloatingPointNumber(m_string.c_str(), buffer))
+        return ToValue(value, std::false_type());
+
+    value = priv::ConvertFloatingPointNumber<float>(buffer, std::strtof);
+}
+
+void String::ToNumber(double &value) const
+{
+    char buffer[64];
+    if(!priv::ExtractFloatingPointNumber(m_string.c_str(), buffer))
+        return ToValue(value, std::false_type());
+
+    value = priv::ConvertFloatingPointNumber<double>(buffer, std::strtod);
+}
+
+void String::ToNumber(long double &value) const
+{
+    char buffer[64];
+    if(!priv::ExtractFloatingPointNumber(m_string.c_str(), buffer))
+        return ToValue(value, std::false_type());
+
+    value = priv::ConvertFloatingPointNumber<long double>(buffer, std::strtold);
+}
+
 String::size_type String::size() const
 {
-    return std::distance(begin(), end());
+    size_type size = m_size.load(std::memory_order_relaxed);
+    if(size == npos)
+    {
+        size = CountCharacters(0, m_string.size());
+        m_size.store(size, std::memory_order_relaxed);
+    }
+
+    return size;
+}
+
+std::string::size_type String::GetBytePosition( size_type count, std::string::size_type from ) const
+{
+    if(HasSingleByteCharacters())
+        return count < m_string.size() - from ? from + count : m_string.size();
+
+    std::string::size_type position = from;
+    for(; count > 0 && position < m_string.size(); --count)
+        position = priv::GetNextCharacter(m_string, position);
+
+    return position;
+}
+
+String::size_type String::CountCharacters( std::string::size_type first, std::string::size_type last ) const
+{
+    size_type count = 0;
+    std::string::size_type position = first;
+    while(position < last)
+    {
+        //Skip ASCII characters 8 at a time.
+        if(last - position >= 8 && priv::AreASCIIBytes(m_string.data() + position))
+        {
+            position += 8;
+            count += 8;
+        }
+        else
+        {
+            position = priv::GetNextCharacter(m_string, position);
+            ++count;
+        }
+    }
+
+    return count;
 }
 
 String::iterator String::begin()
@@ -231,20 +530,27 @@ String& String::ReplaceInvalid( value_type replacement )
     ::utf8::replace_invalid(m_string.begin(), m_string.end(), std::back_inserter(validStr), replacement);
 
     m_string = validStr;
+    m_size.store(npos, std::memory_order_relaxed);
 
     return *this;
 }
 
 String::value_type String::operator[]( const String::size_type position ) const
 {
-    const_iterator it = begin();
-    std::advance(it, position);
+    if(HasSingleByteCharacters())
+        return static_cast<unsigned char>(m_string[position]);
+
+    const_iterator it(m_string.begin() + GetBytePosition(position));
     return *it;
 }
 
 String& String::operator+=( const String &other )
 {
+    size_type size = m_size.load(std::memory_order_relaxed);
+    size_type otherSize = other.m_size.load(std::memory_order_relaxed);
+
     m_string += other.m_string;
+    m_size.store(size != npos && otherSize != npos ? size + otherSize : npos, std::memory_order_relaxed);
     return *this;
 }
 
@@ -262,21 +568,27 @@ String& String::operator+=( value_type character )
 
 void String::push_back( String::value_type character )
 {
+    size_type size = m_size.load(std::memory_order_relaxed);
+
     ::utf8::unchecked::append(character, std::back_inserter(m_string));
+    //Invalid code points may not be read back as a single character.
+    m_size.store(size != npos && character <= 0x10FFFF ? size + 1 : npos, std::memory_order_relaxed);
 }
 
 void String::pop_back()
 {
     m_string.erase((--end()).base(), end().base());
+    m_size.store(npos, std::memory_order_relaxed);
 }
 
 String& String::insert( size_type pos, const String &str )
 {
-    iterator it = begin();
-    std::advance(it, pos);
+    if(pos > size())
+        throw std::out_of_range("[gd::String::insert] starting pos greater than size");
 
-    //Use the real position as bytes using the std::string::iterators
-    m_string.insert( std::distance(m_string.begin(), it.base()), str.m_string );
+    size_type newSize = size() + str.size();
+    m_string.insert( GetBytePosition(pos), str.m_string );
+    m_size.store(newSize, std::memory_order_relaxed);
 
     return *this;
 }
@@ -284,6 +596,7 @@ String& String::insert( size_type pos, const String &str )
 String& String::replace( iterator i1, iterator i2, const String &str )
 {
     m_string.replace(i1.base(), i2.base(), str.m_string);
+    m_size.store(npos, std::memory_order_relaxed);
 
     return *this;
 }
@@ -293,26 +606,26 @@ String& String::replace( String::size_type pos, String::size_type len, const Str
     if(pos > size())
         throw std::out_of_range("[gd::String::replace] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance( i1, pos );
+    len = std::min(len, size() - pos);
+    size_type newSize = size() - len + str.size();
 
-    iterator i2 = i1;
-    while(i2 != end() && len > 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        --len;
-    }
+    std::string::size_type first = GetBytePosition(pos);
+    std::string::size_type last = GetBytePosition(len, first);
+    m_string.replace(first, last - first, str.m_string);
+    m_size.store(newSize, std::memory_order_relaxed);
 
-    return replace( i1, i2, str );
+    return *this;
 }
 
 String::iterator String::erase( String::iterator first, String::iterator last )
 {
+    m_size.store(npos, std::memory_order_relaxed);
     return iterator( m_string.erase( first.base(), last.base() ) );
 }
 
 String::iterator String::erase( String::iterator p )
 {
+    m_size.store(npos, std::memory_order_relaxed);
     return iterator( m_string.erase( p.base() ) );
 }
 
@@ -321,17 +634,12 @@ void String::erase( String::size_type pos, String::size_type len )
     if(pos > size())
         throw std::out_of_range("[gd::String::erase] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance(i1, pos);
+    len = std::min(len, size() - pos);
+    size_type newSize = size() - len;
 
-    iterator i2 = i1;
-    while(i2 != end() && len != 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        len--;
-    }
-
-    erase( i1, i2 );
+    std::string::size_type first = GetBytePosition(pos);
+    m_string.erase(first, GetBytePosition(len, first) - first);
+    m_size.store(newSize, std::memory_order_relaxed);
 }
 
 std::vector<String> String::Split( String::value_type delimiter ) const
@@ -417,6 +725,7 @@ String& String::Normalize(String::NormForm form)
         newStr = utf8proc_NFKC((unsigned char*)m_string.c_str());
 
     m_string = (char*)newStr;
+    m_size.store(npos, std::memory_order_relaxed);
 
     free(newStr);
 
@@ -425,52 +734,33 @@ String& String::Normalize(String::NormForm form)
 
 String String::substr( String::size_type start, String::size_type length ) const
 {
-    String str;
-
-    const_iterator startIt = begin();
-    while(start > 0 && startIt != end())
-    {
-        ++startIt;
-        --start;
-    }
-    if(start > 0) //We reach the end of the string before the start position
+    if(start > size()) //The end of the string is before the start position
         throw std::out_of_range("[gd::String::substr] starting pos greater than size");
 
-    const_iterator endIt = startIt;
-    while(length > 0 && endIt != end())
-    {
-        ++endIt;
-        --length;
-    }
+    length = std::min(length, size() - start);
+    std::string::size_type first = GetBytePosition(start);
 
-    str.m_string = std::string( startIt.base(), endIt.base() );
+    String str;
+    str.m_string = m_string.substr( first, GetBytePosition(length, first) - first );
+    str.m_size.store(length, std::memory_order_relaxed);
 
     return str;
 }
 
 String::size_type String::find( const String &search, String::size_type pos ) const
 {
-    const_iterator it = begin();
-
-    //Move to pos
-    if(pos < size())
-        std::advance( it, pos );
-    else
+    if(pos >= size())
         return npos;
 
     //Use the standard std::string to find a string (using their internal std::strings).
-    //Use the raw std::string iterator to get the offset as a **byte** count for the starting
-    //position.
-    std::string::size_type findPos =
-        m_string.find( search.m_string, std::distance( m_string.begin(), it.base() ) );
+    //The starting position is converted to a **byte** count.
+    std::string::size_type startPos = GetBytePosition(pos);
+    std::string::size_type findPos = m_string.find( search.m_string, startPos );
 
     if( findPos != std::string::npos )
     {
-        //Create a String::iterator from the std::string::iterator pointing to the find result.
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance in **characters** count (that's why we need a String::iterator).
-        return std::distance( begin(), findPosIt );
+        //Return the position in **characters** count.
+        return pos + CountCharacters( startPos, findPos );
     }
     else
         return npos;
@@ -488,32 +778,17 @@ String::size_type String::find( const String::value_type search, String::size_ty
 
 String::size_type String::rfind( const String &search, String::size_type pos ) const
 {
-    //Move to pos + 1 (we will then get the last byte of the character at pos)
-    const_iterator it = begin();
-    std::string::const_iterator baseIt;
-    if( pos < size() ) //little optimization by testing npos directly (avoid calculating size())
-    {
-        std::advance( it, pos + 1 );
-        baseIt = it.base();
-        --baseIt; //Decrement the std::string::iterator by one because we need
-        //it to point to the last byte of the character at pos
-    }
-
     //The last character is included, so we need to put the position
-    //of the last byte of the character at the position "pos"
+    //of the last byte of the character at the position "pos" (which is the byte
+    //before the character at pos + 1).
     std::string::size_type findPos = m_string.rfind( search.m_string,
-        pos < size() ? std::distance( m_string.begin(), baseIt ) : std::string::npos
+        pos < size() ? GetBytePosition( pos + 1 ) - 1 : std::string::npos
         );
 
     if( findPos != std::string::npos )
     {
-        //Create a String::iterator to the find position to be able to get the real
-        //distance as characters count (it would be a distance as bytes count
-        //with a std::string::iterator)
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance (which is a distance as characters count)
-        return std::distance( begin(), findPosIt );
+        //Return the position in **characters** count.
+        return CountCharacters( 0, findPos );
     }
     else
         return npos;
@@ -540,11 +815,11 @@ namespace priv
         else
             return String::npos;
 
-        for( ; it != str.end(); ++it )
+        for( String::size_type position = startPos; it != str.end(); ++it, ++position )
         {
             //Search the current char in the match string
             if( ( std::find( match.begin(), match.end(), (*it) ) != match.end() ) != not_of )
-                return std::distance( str.begin(), it );
+                return position;
         }
 
         return String::npos;
@@ -553,11 +828,17 @@ namespace priv
 
 String::size_type String::find_first_of( const String &match, size_type startPos ) const
 {
+    if(HasSingleByteCharacters() && match.HasSingleByteCharacters())
+        return m_string.find_first_of(match.m_string, startPos);
+
     return priv::find_first_of(*this, match, startPos, false);
 }
 
 String::size_type String::find_first_not_of( const String &match, size_type startPos ) const
 {
+    if(HasSingleByteCharacters() && match.HasSingleByteCharacters())
+        return m_string.find_first_not_of(match.m_string, startPos);
+
     return priv::find_first_of(*this, match, startPos, true);
 }
 
@@ -570,15 +851,20 @@ namespace priv
         String::size_type strSize = str.size();
 
         String::const_iterator it = str.end();
+        String::size_type position = strSize;
         if( endPos < strSize )
+        {
             std::advance( it, endPos - strSize + 1 );
+            position = endPos + 1;
+        }
 
         while( it != str.begin() )
         {
             --it;
+            --position;
 
             if( ( std::find( match.begin(), match.end(), (*it) ) != match.end() ) != not_of )
-                return std::distance( str.begin(), it );
+                return position;
         }
 
         return String::npos;
@@ -587,11 +873,17 @@ namespace priv
 
 String::size_type String::find_last_of( const String &match, size_type endPos ) const
 {
+    if(HasSingleByteCharacters() && match.HasSingleByteCharacters())
+        return m_string.find_last_of(match.m_string, endPos);
+
     return priv::find_last_of( *this, match, endPos, false );
 }
 
 String::size_type String::find_last_not_of( const String &match, size_type endPos ) const
 {
+    if(HasSingleByteCharacters() && match.HasSingleByteCharacters())
+        return m_string.find_last_not_of(match.m_string, endPos);
+
     return priv::find_last_of( *this, match, endPos, true );
 }
 
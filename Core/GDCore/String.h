@@ -7,11 +7,14 @@
 #ifndef GDCORE_UTF8_STRING_H
 #define GDCORE_UTF8_STRING_H
 
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <SFML/System/String.hpp>
 
@@ -126,6 +129,19 @@ public:
      */
     String(const sf::String &string);
 
+    String(const String &other) :
+        m_string(other.m_string),
+        m_size(other.m_size.load(std::memory_order_relaxed))
+    {
+    }
+
+    String(String &&other) noexcept :
+        m_string(std::move(other.m_string)),
+        m_size(other.m_size.load(std::memory_order_relaxed))
+    {
+        other.m_size.store(npos, std::memory_order_relaxed);
+    }
+
 /**
  * \}
  */
@@ -150,6 +166,21 @@ public:
 
     String& operator=(const std::u32string &string);
 
+    String& operator=(const String &other)
+    {
+        m_string = other.m_string;
+        m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    String& operator=(String &&other) noexcept
+    {
+        m_string = std::move(other.m_string);
+        m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.m_size.store(npos, std::memory_order_relaxed);
+        return *this;
+    }
+
 /**
  * \}
  */
@@ -166,6 +197,9 @@ public:
 
     /**
      * \brief Returns the string's length.
+     *
+     * The length is computed when first needed and then kept until the string
+     * is modified, so that calling size() in a loop is cheap.
      */
     size_type size() const;
 
@@ -179,7 +213,7 @@ public:
      *
      * **Iterators :** Obviously, all iterators are invalidated.
      */
-    void clear() { m_string.clear(); }
+    void clear() { m_string.clear(); m_size.store(0, std::memory_order_relaxed); }
 
 /**
  * \}
@@ -222,6 +256,9 @@ public:
     /**
      * \brief Method to create a gd::String from a number (float, double, int, ...)
      * \return a gd::String created from **value**.
+     *
+     * Numbers are formatted like a std::ostringstream would do (with a precision of 6 for
+     * floating point numbers), without using a stream and whatever the current locale is.
      */
     template<typename T>
     static String From(T value)
@@ -229,14 +266,15 @@ public:
         static_assert(!std::is_same<T, std::string>::value, "Can't use gd::String::From with std::string.");
         static_assert(!std::is_same<T, sf::String>::value, "Can't use gd::String::From with sf::String.");
 
-        std::ostringstream oss;
-        oss << value;
-        return gd::String(oss.str().c_str());
+        return FromValue(value, IsNumber<T>());
     }
 
     /**
      * \brief Method to convert the string to a number
      * \return the string converted to the type **T**
+     *
+     * Numbers are read like a std::istringstream would do, without using a stream and whatever
+     * the current locale is. 0 is returned if the string does not start with a number.
      */
     template<typename T>
     T To() const
@@ -245,8 +283,7 @@ public:
         static_assert(!std::is_same<T, sf::String>::value, "Can't use gd::String::To with sf::String.");
 
         T value;
-        std::istringstream oss(m_string);
-        oss >> value;
+        ToValue(value, IsNumber<T>());
         return value;
     }
 
@@ -366,16 +403,20 @@ public:
 
     /**
      * \brief Returns the code point at the specified position
-     * \warning This operator has a linear complexity on the character's
-     * position. You should avoid to use it in a loop and use the iterators
-     * provided by this class instead.
+     * \warning Unless all the characters of the string are ASCII, this
+     * operator has a linear complexity on the character's position. You should
+     * avoid to use it in a loop and use the iterators provided by this class
+     * instead.
      */
     value_type operator[]( const size_type position ) const;
 
     /**
      * \brief Get the raw UTF8-encoded std::string
+     *
+     * \warning The returned reference must not be used to modify the string
+     * after another method of the String has been called.
      */
-    std::string& Raw() { return m_string; }
+    std::string& Raw() { m_size.store(npos, std::memory_order_relaxed); return m_string; }
 
     /**
      * \brief Get the raw UTF8-encoded std::string
@@ -633,7 +674,109 @@ public:
  */
 
 private:
+    /**
+     * True for the types converted by From and To without a stream: numbers, but not bool and
+     * the character types, that streams write as characters.
+     */
+    template<typename T>
+    struct IsNumber : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+        !std::is_same<T, bool>::value && !std::is_same<T, char>::value &&
+        !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value> {};
+
+    template<typename T>
+    static String FromValue(T value, std::false_type)
+    {
+        std::ostringstream oss;
+        oss << value;
+        return gd::String(oss.str().c_str());
+    }
+
+    template<typename T>
+    static String FromValue(T value, std::true_type)
+    {
+        //Streams write integers as long or unsigned long, and floats as doubles.
+        using Number = typename std::conditional<std::is_floating_point<T>::value,
+            typename std::conditional<std::is_same<T, long double>::value, long double, double>::type,
+            typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type>::type;
+        return FromNumber(static_cast<Number>(value));
+    }
+
+    static String FromNumber(long long value);
+    static String FromNumber(unsigned long long value);
+    static String FromNumber(double value);
+    static String FromNumber(long double value);
+
+    template<typename T>
+    void ToValue(T &value, std::false_type) const
+    {
+        std::istringstream oss(m_string);
+        oss >> value;
+    }
+
+    template<typename T>
+    void ToValue(T &value, std::true_type) const
+    {
+        ToNumber(value);
+    }
+
+    /**
+     * Read an integer like std::num_get: the magnitude is saturated at the maximum of **T** (or
+     * at its minimum for negative numbers of a signed type), and negative numbers are wrapped
+     * for unsigned types.
+     */
+    template<typename T>
+    void ToNumber(T &value) const
+    {
+        bool negative, overflow;
+        unsigned long long magnitude;
+        if(!ReadInteger(negative, overflow, magnitude))
+        {
+            value = 0;
+            return;
+        }
+
+        const unsigned long long max = std::numeric_limits<T>::max();
+        if(std::is_signed<T>::value && negative)
+            value = overflow || magnitude > max ? std::numeric_limits<T>::min() : static_cast<T>(0 - magnitude);
+        else if(overflow || magnitude > max)
+            value = std::numeric_limits<T>::max();
+        else
+            value = static_cast<T>(negative ? 0 - magnitude : magnitude);
+    }
+
+    void ToNumber(float &value) const;
+    void ToNumber(double &value) const;
+    void ToNumber(long double &value) const;
+
+    /**
+     * Read the sign and the magnitude of the integer at the beginning of the string.
+     * **overflow** is set to true if the magnitude doesn't fit in an unsigned long long.
+     * \return false if the string does not start with an integer.
+     */
+    bool ReadInteger(bool &negative, bool &overflow, unsigned long long &magnitude) const;
+
+    /**
+     * \return true if each character is stored in a single byte, which is the
+     * case for ASCII strings: positions in characters are then the same as
+     * positions in bytes.
+     */
+    bool HasSingleByteCharacters() const { return size() == m_string.size(); }
+
+    /**
+     * \return the position, in bytes, of the character **count** characters
+     * after the byte at **from**, or the size of the raw string if the end is
+     * reached before.
+     */
+    std::string::size_type GetBytePosition( size_type count, std::string::size_type from = 0 ) const;
+
+    /**
+     * \return the number of characters between the bytes at **first** and
+     * **last**.
+     */
+    size_type CountCharacters( std::string::size_type first, std::string::size_type last ) const;
+
     std::string m_string; ///< Internal std::string container
+    mutable std::atomic<size_type> m_size; ///< The number of characters, or npos if not computed since the last modification. Atomic so that const methods stay usable from several threads.
 
 };
 
@@ -812,7 +955,9 @@ namespace std
  * The UTF8 encoding has the advantage to reduce the RAM consumption compared to UTF16 or UTF32 for strings using a lot
  * of latin characters. But the characters variable length brings some performance issues compared to fixed size encoding.
  * That's why the complexity of each methods is written in their documentation. For instance, the size() method is linear
- * on the string size and so is the operator[]().
+ * on the string size the first time it's called after a modification (the result is then kept) and so is the
+ * operator[](). For strings containing only ASCII characters, positions are the same in characters and in bytes: the
+ * operator[](), substr(), find() and the other methods using positions then don't have to iterate on the characters.
  *
  * \section Conversion Conversions from/to other string types
  * The String handles implicit conversion with sf::String (implicit constructor and implicit conversion
@@ -4,8 +4,59 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCore/IDE/AbstractFileSystem.h"
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <string>
+#include "GDCore/Tools/FileStream.h"
 #include "catch.hpp"
 
+namespace {
+class WrittenFilesFileSystem : public gd::AbstractFileSystem {
+ public:
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) {
+    return files.find(path) != files.end();
+  };
+  virtual gd::String FileNameFrom(const gd::String& file) { return file; };
+  virtual gd::String DirNameFrom(const gd::String& file) { return ""; };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return false;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return false;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) { return false; };
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    return false;
+  };
+  virtual bool ClearDir(const gd::String& directory) { return true; };
+  virtual bool WriteToFile(const gd::String& file, const gd::String& content) {
+    files[file] = content;
+    return true;
+  };
+  virtual gd::String ReadFile(const gd::String& file) { return files[file]; };
+  virtual gd::String GetTempDir() { return "/tmp"; };
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  };
+
+  std::map<gd::String, gd::String> files;
+};
+
+class LocalFileSystem : public WrittenFilesFileSystem {
+ public:
+  virtual bool StreamToFile(const gd::String& file,
+                            std::function<void(std::ostream&)> writer) {
+    return StreamToLocalFile(file, writer);
+  };
+};
+}  // namespace
+
 TEST_CASE("AbstractFileSystem", "[common]") {
   SECTION("Basics") {
     REQUIRE(gd::AbstractFileSystem::NormalizeSeparator(u8"C:\\Test\\Test2\\") ==
@@ -15,4 +66,31 @@ TEST_CASE("AbstractFileSystem", "[common]") {
     REQUIRE(gd::AbstractFileSystem::NormalizeSeparator(u8"/TestԘ/Test2") ==
             u8"/TestԘ/Test2");
   }
+  SECTION("Streaming to a file") {
+    WrittenFilesFileSystem fs;
+    REQUIRE(fs.StreamToFile("file.txt", [](std::ostream& output) {
+      output << u8"Hello " << 42 << u8" 官话";
+    }));
+    REQUIRE(fs.ReadFile("file.txt") == u8"Hello 42 官话");
+  }
+  SECTION("Streaming to a file of the computer") {
+    LocalFileSystem fs;
+    REQUIRE(fs.StreamToFile("AbstractFileSystemTest.txt",
+                            [](std::ostream& output) {
+                              for (int i = 0; i < 10000; ++i)
+                                output << u8"Hello 官话 " << i << "\n";
+                            }));
+    REQUIRE(fs.files.empty());
+
+    gd::FileStream file("AbstractFileSystemTest.txt", std::ios_base::in);
+    std::string line;
+    int linesCount = 0;
+    while (std::getline(file, line)) {
+      REQUIRE(line == u8"Hello 官话 " + std::to_string(linesCount));
+      linesCount++;
+    }
+    REQUIRE(linesCount == 10000);
+    file.close();
+    std::remove("AbstractFileSystemTest.txt");
+  }
 }
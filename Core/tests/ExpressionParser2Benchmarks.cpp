@@ -4,6 +4,8 @@
  * reserved. This project is released under the MIT License.
  */
 #include <chrono>
+#include <cstdlib>
+#include <new>
 #include <numeric>
 #include "DummyPlatform.h"
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
@@ -11,9 +13,46 @@
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/IDE/Events/ExpressionValidator.h"
 #include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
 #include "GDCore/Project/Project.h"
 #include "catch.hpp"
 
+namespace {
+// The allocations counter of the current thread, if any (see
+// ScopedAllocationsCounter).
+thread_local std::size_t *allocationsCounter = nullptr;
+
+/**
+ * \brief Count the allocations done by the current thread while this object
+ * exists. Outside of it, allocations are not counted.
+ */
+class ScopedAllocationsCounter {
+ public:
+  ScopedAllocationsCounter() : count(0), previousCounter(allocationsCounter) {
+    allocationsCounter = &count;
+  }
+  ~ScopedAllocationsCounter() { allocationsCounter = previousCounter; }
+
+  std::size_t GetCount() const { return count; }
+
+ private:
+  std::size_t count;
+  std::size_t *previousCounter;
+};
+}  // namespace
+
+// Allocations are only counted inside a ScopedAllocationsCounter: otherwise,
+// these are the same as the default allocation functions, so that the other
+// tests of the binary are not affected. The array forms call these ones.
+void *operator new(std::size_t size) {
+  if (allocationsCounter) (*allocationsCounter)++;
+  void *pointer = std::malloc(size ? size : 1);
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
 TEST_CASE("ExpressionParser2 - Benchmarks", "[common][events]") {
   gd::Project project;
   gd::Platform platform;
@@ -42,12 +81,19 @@ TEST_CASE("ExpressionParser2 - Benchmarks", "[common][events]") {
 
   auto doBenchmark = [](const gd::String &benchmarkName,
                         const size_t runsCount,
+                        const gd::String &expression,
                         std::function<void()> func) {
     std::vector<long long> timesInMicroseconds;
+    timesInMicroseconds.reserve(runsCount);
+    std::size_t allocationsCount = 0;
 
     for (size_t i = 0; i < runsCount; i++) {
       auto start = std::chrono::steady_clock::now();
-      func();
+      {
+        ScopedAllocationsCounter allocationsCounter;
+        func();
+        allocationsCount += allocationsCounter.GetCount();
+      }
       auto end = std::chrono::steady_clock::now();
 
       timesInMicroseconds.push_back(
@@ -55,17 +101,24 @@ TEST_CASE("ExpressionParser2 - Benchmarks", "[common][events]") {
               .count());
     }
 
-    std::cout << benchmarkName << " benchmark (" << runsCount << " runs): "
-              << (float)std::accumulate(timesInMicroseconds.begin(),
-                                        timesInMicroseconds.end(),
-                                        0) /
-                     (float)runsCount
-              << " microseconds" << std::endl;
+    // Each run parses the expression with the 8 types.
+    const std::size_t parsesCount = runsCount * 8;
+    float averageTime = (float)std::accumulate(timesInMicroseconds.begin(),
+                                               timesInMicroseconds.end(),
+                                               0LL) /
+                        (float)runsCount;
+    float throughput = averageTime > 0
+                           ? (float)(expression.Raw().size() * 8) / averageTime
+                           : 0;  // Bytes per microsecond are MB/s.
+    std::cout << benchmarkName << " benchmark (" << runsCount
+              << " runs): " << averageTime << " microseconds, "
+              << allocationsCount / parsesCount
+              << " allocations per parse, " << throughput << "MB/s"
+              << std::endl;
   };
 
   SECTION("Parse long expression") {
-    doBenchmark("Parse long expression", 10, [&]() {
-      REQUIRE_NOTHROW(parseExpression(
+    gd::String expression =
           "MySpriteObject.X()+MySpriteObject.X()/cos(3.123456789)+"
           "MySpriteObject.X()+MySpriteObject.X()/cos(3.123456789)+"
           "MySpriteObject.X()+MySpriteObject.X()+MySpriteObject.X()/"
@@ -107,16 +160,69 @@ TEST_CASE("ExpressionParser2 - Benchmarks", "[common][events]") {
           "MySpriteObject.X()+MySpriteObject.X()+MySpriteObject.X()/"
           "cos(3.123456789)+"
           "MySpriteObject.X()+MySpriteObject.X()/"
-          "cos(3.123456789)+MySpriteObject.X()+0"));
+          "cos(3.123456789)+MySpriteObject.X()+0";
+    doBenchmark("Parse long expression", 10, expression, [&]() {
+      REQUIRE_NOTHROW(parseExpression(expression));
     });
   }
 
-  SECTION("Parse long expression") {
-    doBenchmark("Long identifier", 100, [&]() {
-      REQUIRE_NOTHROW(parseExpression(
-          "MyLoooooongIdentifierThatNeverStoooooopsAndContinueAgainAndAgainAndA"
-          "gainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgain"
-          "AndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgain"));
+  SECTION("Long identifier") {
+    gd::String expression =
+        "MyLoooooongIdentifierThatNeverStoooooopsAndContinueAgainAndAgainAndA"
+        "gainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgain"
+        "AndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgain";
+    doBenchmark("Long identifier", 100, expression, [&]() {
+      REQUIRE_NOTHROW(parseExpression(expression));
+    });
+  }
+
+  SECTION("Texts with non ASCII characters") {
+    gd::String expression;
+    for (std::size_t i = 0; i < 50; ++i) {
+      expression += u8"\"Un texte spécial, avec des caractères 官话\" + "
+                    u8"MySpriteObject.X() + \"à la fin\" + ";
+    }
+    expression += "\"\"";
+    doBenchmark("Texts with non ASCII characters", 10, expression, [&]() {
+      REQUIRE_NOTHROW(parseExpression(expression));
+    });
+  }
+
+  SECTION("Expression with a lot of functions") {
+    // Add extensions to have as many as in a real platform, so that searching
+    // the metadata of the functions is as long.
+    for (std::size_t i = 0; i < 30; ++i) {
+      auto extension = std::make_shared<gd::PlatformExtension>();
+      extension->SetExtensionInformation(
+          "BenchmarkExtension" + gd::String::From(i), "", "", "", "");
+      for (std::size_t j = 0; j < 20; ++j) {
+        extension->AddExpression(
+            "Expression" + gd::String::From(j), "", "", "", "");
+        extension->AddObject<gd::Object>(
+            "Object" + gd::String::From(j), "", "", "");
+      }
+      platform.AddExtension(extension);
+    }
+
+    gd::String expression;
+    for (std::size_t i = 0; i < 100; ++i) {
+      expression +=
+          "MySpriteObject.GetObjectNumber() + MyExtension::GetNumber() + "
+          "BenchmarkExtension29::Expression19() + MySpriteObject.Unknown() + ";
+    }
+    expression += "0";
+    doBenchmark("Expression with a lot of functions", 10, expression, [&]() {
+      REQUIRE_NOTHROW(parseExpression(expression));
+    });
+  }
+
+  SECTION("Short expression") {
+    // An expression as typed in the IDE, parsed on each keystroke.
+    gd::String expression =
+        "MySpriteObject.GetObjectNumber() + 2 * "
+        "GetNumberWith3Params(MySpriteObject.GetObjectNumber(), \"Text\")";
+    doBenchmark("Short expression", 1000, expression, [&]() {
+      REQUIRE_NOTHROW(parseExpression(expression));
     });
   }
 }
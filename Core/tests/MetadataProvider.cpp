@@ -0,0 +1,111 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the search of metadata in the extensions of a platform.
+ */
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/MetadataCache.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+std::shared_ptr<gd::PlatformExtension> CreateOtherExtension() {
+  std::shared_ptr<gd::PlatformExtension> extension =
+      std::make_shared<gd::PlatformExtension>();
+  extension->SetExtensionInformation(
+      "OtherExtension", "Another testing extension", "", "", "");
+  extension->AddExpression("GetOtherNumber", "Get another number", "", "", "")
+      .SetFunctionName("getOtherNumber");
+  return extension;
+}
+}  // namespace
+
+TEST_CASE("MetadataProvider", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  SECTION("Expressions") {
+    const gd::ExpressionMetadata &metadata =
+        gd::MetadataProvider::GetExpressionMetadata(platform,
+                                                    "MyExtension::GetNumber");
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(metadata));
+    REQUIRE(metadata.codeExtraInformation.functionCallName == "getNumber");
+    REQUIRE(&gd::MetadataProvider::GetExpressionMetadata(
+                platform, "MyExtension::GetNumber") == &metadata);
+
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(platform,
+                                                    "MyExtension::Unknown")));
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetStrExpressionMetadata(
+            platform, "MyExtension::GetNumber")));
+  }
+  SECTION("Object and behavior expressions") {
+    REQUIRE(gd::MetadataProvider::GetObjectExpressionMetadata(
+                platform, "MyExtension::Sprite", "GetObjectNumber")
+                .codeExtraInformation.functionCallName == "getObjectNumber");
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "MyExtension::Sprite", "Unknown")));
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "MyExtension::Unknown", "GetObjectNumber")));
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetBehaviorExpressionMetadata(
+            platform, "MyExtension::Unknown", "GetObjectNumber")));
+  }
+  SECTION("Expressions not found are memoized up to a limit") {
+    const gd::MetadataCache &cache = platform.GetMetadataCache();
+    gd::MetadataProvider::GetExpressionMetadata(platform,
+                                                "MyExtension::GetNumber");
+    gd::MetadataProvider::GetExpressionMetadata(platform,
+                                                "MyExtension::Unknown");
+    REQUIRE(cache.GetFoundExpressionsCount() == 1);
+    REQUIRE(cache.GetNotFoundExpressionsCount() == 1);
+
+    const std::size_t maxCount = gd::MetadataCache::MaxNotFoundExpressionsCount;
+    for (std::size_t i = 0; i < maxCount * 2; ++i) {
+      gd::String name = "MyExtension::Unknown" + gd::String::From(i);
+      REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+          gd::MetadataProvider::GetExpressionMetadata(platform, name)));
+      REQUIRE(cache.GetNotFoundExpressionsCount() <= maxCount);
+    }
+    REQUIRE(cache.GetFoundExpressionsCount() == 1);
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(platform,
+                                                    "MyExtension::GetNumber")));
+  }
+  SECTION("Adding and removing extensions") {
+    // Search the expression before the extension is added...
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(
+            platform, "OtherExtension::GetOtherNumber")));
+
+    // ...so that it's not wrongly found as missing after.
+    platform.AddExtension(CreateOtherExtension());
+    const gd::ExpressionMetadata &metadata =
+        gd::MetadataProvider::GetExpressionMetadata(
+            platform, "OtherExtension::GetOtherNumber");
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(metadata));
+    REQUIRE(metadata.codeExtraInformation.functionCallName ==
+            "getOtherNumber");
+
+    // Replacing the extension must not return the metadata of the old one.
+    platform.AddExtension(CreateOtherExtension());
+    REQUIRE(&gd::MetadataProvider::GetExpressionMetadata(
+                platform, "OtherExtension::GetOtherNumber") != &metadata);
+
+    platform.RemoveExtension("OtherExtension");
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(
+            platform, "OtherExtension::GetOtherNumber")));
+  }
+}
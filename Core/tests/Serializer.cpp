@@ -7,6 +7,9 @@
  * @file Tests covering serialization to JSON.
  */
 #include "GDCore/Serialization/Serializer.h"
+#include <clocale>
+#include <cmath>
+#include <sstream>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Event.h"
@@ -81,6 +84,62 @@ TEST_CASE("SerializerElement", "[common]") {
     REQUIRE(element.GetChild(2).GetDoubleValue() == 45.6);
   }
 
+  SECTION("Many children") {
+    // Enough children for them to be indexed by name.
+    SerializerElement element;
+    for (std::size_t i = 0; i < 50; ++i)
+      element.AddChild("child" + gd::String::From(i)).SetIntValue(i);
+    element.AddChild("child10").SetIntValue(100);
+    element.AddChild("oldName").SetIntValue(1000);
+
+    REQUIRE(element.GetAllChildren().size() == 51);
+    REQUIRE(element.HasChild("child49"));
+    REQUIRE(!element.HasChild("child50"));
+    REQUIRE(element.GetChild("child10").GetIntValue() == 100);
+    REQUIRE(element.GetChild("child42").GetIntValue() == 42);
+    REQUIRE(element.GetChild("newName", 0, "oldName").GetIntValue() == 1000);
+    REQUIRE(element.GetChildrenCount("child3") == 1);
+
+    element.RemoveChild("child10");
+    REQUIRE(!element.HasChild("child10"));
+    REQUIRE(element.GetChild("child11").GetIntValue() == 11);
+    REQUIRE(element.GetChild("oldName").GetIntValue() == 1000);
+
+    SerializerElement copiedElement = element;
+    REQUIRE(copiedElement.GetChild("child42").GetIntValue() == 42);
+    REQUIRE(!copiedElement.HasChild("child10"));
+  }
+
+  SECTION("Arrays with children of different names") {
+    // Children with different names, as loaded from old XML projects.
+    SerializerElement element;
+    for (std::size_t i = 0; i < 20; ++i) {
+      gd::String name = i % 2 ? "Objet" : "instance";
+      element.ConsiderAsArrayOf(name);
+      element.AddChild(name).SetIntValue(i);
+    }
+    element.ConsiderAsArrayOf("other");
+    element.AddChild("other").SetIntValue(-1);
+    element.ConsiderAsArrayOf("instance", "Objet");
+
+    REQUIRE(element.GetChildrenCount() == 20);
+    REQUIRE(element.GetChild(0).GetIntValue() == 0);
+    REQUIRE(element.GetChild(5).GetIntValue() == 5);
+    REQUIRE(element.GetChild(19).GetIntValue() == 19);
+    REQUIRE(&element.GetChild(20) == &SerializerElement::nullElement);
+
+    SerializerElement sameNameElement;
+    sameNameElement.ConsiderAsArrayOf("Objet");
+    for (std::size_t i = 0; i < 20; ++i)
+      sameNameElement.AddChild("Objet").SetIntValue(i);
+    sameNameElement.ConsiderAsArrayOf("instance", "Objet");
+    REQUIRE(sameNameElement.GetChildrenCount() == 20);
+    REQUIRE(sameNameElement.GetChild(7).GetIntValue() == 7);
+    REQUIRE(&sameNameElement.GetChild(20) == &SerializerElement::nullElement);
+    sameNameElement.ConsiderAsArrayOf("instance");
+    REQUIRE(sameNameElement.GetChildrenCount() == 0);
+  }
+
   SECTION("(Deprecated) attributes") {
     SerializerElement element;
     element.AddChild("child1").SetStringValue("value123");
@@ -144,6 +203,140 @@ TEST_CASE("Serializer", "[common]") {
     REQUIRE(json == originalJSON);
   }
 
+  SECTION("Streaming JSON") {
+    gd::String originalJSON =
+        u8"{\"a\": 1,\"b\": [{},[],-3.5,\"4 \\\"官话\\\"\\n\"],\"c\": "
+        u8"{\"d\": true}}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+
+    std::ostringstream output;
+    Serializer::ToJSON(element, output);
+    REQUIRE(gd::String::FromUTF8(output.str()) == originalJSON);
+    REQUIRE(gd::String::FromUTF8(output.str()) == Serializer::ToJSON(element));
+  }
+
+  SECTION("Numbers whatever the locale") {
+    // Use a locale with a comma as the decimal separator, if one is installed.
+    gd::String previousLocale = std::setlocale(LC_NUMERIC, nullptr);
+    bool commaLocale = false;
+    for (const char *name :
+         {"fr_FR.UTF-8", "fr_FR.utf8", "de_DE.UTF-8", "de_DE.utf8", "French"}) {
+      if (std::setlocale(LC_NUMERIC, name)) {
+        commaLocale = true;
+        break;
+      }
+    }
+    if (!commaLocale)
+      WARN("No locale with a comma as decimal separator, using the C one.");
+
+    gd::String originalJSON = "{\"a\": -3.5,\"b\": 125.25,\"c\": 2e-3}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+    double a = element.GetChild("a").GetDoubleValue();
+    double b = element.GetChild("b").GetDoubleValue();
+    double c = element.GetChild("c").GetDoubleValue();
+    gd::String json = Serializer::ToJSON(element);
+    std::setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    REQUIRE(a == -3.5);
+    REQUIRE(b == 125.25);
+    REQUIRE(c == 0.002);
+    REQUIRE(json == "{\"a\": -3.5,\"b\": 125.25,\"c\": 0.002}");
+  }
+
+  SECTION("Escaped characters") {
+    gd::String originalJSON =
+        "{\"backslash\": \"\\\\\",\"unicode\": \"\\u00e9\\u5B98\\uD83D\\uDE00"
+        "\\u001F\",\"slash\": \"\\/\",\"lone surrogate\": \"\\uD83D!\"}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+    REQUIRE(element.GetChild("backslash").GetStringValue() == "\\");
+    REQUIRE(element.GetChild("unicode").GetStringValue() ==
+            u8"\u00e9\u5B98\U0001F600\u001F");
+    REQUIRE(element.GetChild("slash").GetStringValue() == "/");
+    REQUIRE(element.GetChild("lone surrogate").GetStringValue() ==
+            u8"\uFFFD!");
+  }
+
+  SECTION("Invalid UTF-8") {
+    gd::String originalJSON;
+    originalJSON.Raw() = "{\"a\": \"\xC3\x28\",\"b\": \"ok\"}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+    REQUIRE(element.GetChild("a").GetStringValue().IsValid());
+    REQUIRE(element.GetChild("b").GetStringValue() == "ok");
+  }
+
+  SECTION("Buffers and errors") {
+    // The JSON does not have to be null terminated.
+    std::string json = "[1,2,3]garbage";
+    std::size_t errorPosition = 0;
+    SerializerElement element =
+        Serializer::FromJSON(json.data(), 7, &errorPosition);
+    REQUIRE(errorPosition == std::string::npos);
+    REQUIRE(Serializer::ToJSON(element) == "[1,2,3]");
+
+    json = "{\"a\": 1,\"b\" 2}";
+    Serializer::FromJSON(json.data(), json.size(), &errorPosition);
+    REQUIRE(errorPosition == 12);
+
+    json = "{\"a\": [1,2}";
+    Serializer::FromJSON(json.data(), json.size(), &errorPosition);
+    REQUIRE(errorPosition == 10);
+
+    json = "{\"a\": \"unterminated}";
+    Serializer::FromJSON(json.data(), json.size(), &errorPosition);
+    REQUIRE(errorPosition == json.size());
+  }
+
+  SECTION("Binary format") {
+    SerializerElement element;
+    element.AddChild("bool").SetBoolValue(true);
+    element.AddChild("int").SetIntValue(-123456);
+    element.AddChild("integerDouble").SetDoubleValue(-42);
+    element.AddChild("double").SetDoubleValue(0.1);
+    element.AddChild("negativeZero").SetDoubleValue(-0.0);
+    element.AddChild("string").SetStringValue(u8"Hello \"官话\"\n");
+    element.SetAttribute("attribute", 3);
+    SerializerElement& array = element.AddChild("array");
+    array.ConsiderAsArrayOf("item");
+    array.AddChild("item").SetStringValue("a");
+    array.AddChild("item").AddChild("bool").SetBoolValue(false);
+    array.AddChild("item").ConsiderAsArray();
+
+    std::string binary = Serializer::ToBinary(element);
+    REQUIRE(Serializer::IsBinary(binary.data(), binary.size()));
+    std::size_t errorPosition = 0;
+    SerializerElement binaryElement =
+        Serializer::FromBinary(binary.data(), binary.size(), &errorPosition);
+    REQUIRE(errorPosition == std::string::npos);
+    REQUIRE(Serializer::ToJSON(binaryElement) == Serializer::ToJSON(element));
+    REQUIRE(binaryElement.GetChild("int").GetValue().IsInt());
+    REQUIRE(binaryElement.GetChild("integerDouble").GetValue().IsDouble());
+    REQUIRE(binaryElement.GetChild("double").GetDoubleValue() == 0.1);
+    REQUIRE(std::signbit(
+        binaryElement.GetChild("negativeZero").GetDoubleValue()));
+    REQUIRE(binaryElement.GetIntAttribute("attribute") == 3);
+    REQUIRE(binaryElement.GetChild("array").ConsideredAsArrayOf() == "item");
+    REQUIRE(binaryElement.GetChild("array").GetChildrenCount() == 3);
+
+    // Names are stored once.
+    std::size_t itemsCount = 0;
+    for (std::size_t pos = binary.find("item"); pos != std::string::npos;
+         pos = binary.find("item", pos + 1))
+      itemsCount++;
+    REQUIRE(itemsCount == 1);
+
+    // Errors
+    REQUIRE(!Serializer::IsBinary("{}", 2));
+    Serializer::FromBinary("{}", 2, &errorPosition);
+    REQUIRE(errorPosition == 0);
+    Serializer::FromBinary(binary.data(), binary.size() - 1, &errorPosition);
+    REQUIRE(errorPosition == binary.size() - 1);
+    std::string otherVersion = binary;
+    otherVersion[4] = 2;
+    Serializer::FromBinary(
+        otherVersion.data(), otherVersion.size(), &errorPosition);
+    REQUIRE(errorPosition == 4);
+  }
+
   SECTION("Idempotency of unserializing and serializing again") {
     auto unserializeAndSerializeToJSON = [](const gd::String& originalJSON) {
       SerializerElement element = Serializer::FromJSON(originalJSON);
@@ -0,0 +1,124 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <iostream>
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * Fill an element with something looking like the objects of a large project:
+ * names, numbers, booleans, nested arrays and strings needing escapes.
+ */
+void FillObjectsElement(gd::SerializerElement& element, std::size_t count) {
+  gd::SerializerElement& objects = element.AddChild("objects");
+  objects.ConsiderAsArrayOf("object");
+  for (std::size_t i = 0; i < count; ++i) {
+    gd::SerializerElement& object = objects.AddChild("object");
+    object.AddChild("name").SetStringValue("MyObject" + gd::String::From(i));
+    object.AddChild("type").SetStringValue("Sprite");
+    object.AddChild("hidden").SetBoolValue(i % 2 == 0);
+    object.AddChild("angle").SetDoubleValue(i * 0.75);
+    object.AddChild("comment").SetStringValue(
+        u8"Un objet \"spécial\"\n\tavec des caractères 官话 \\ à échapper");
+
+    gd::SerializerElement& points = object.AddChild("points");
+    points.ConsiderAsArrayOf("point");
+    for (std::size_t j = 0; j < 8; ++j) {
+      gd::SerializerElement& point = points.AddChild("point");
+      point.AddChild("name").SetStringValue("Point" + gd::String::From(j));
+      point.AddChild("x").SetDoubleValue(j * 12.5);
+      point.AddChild("y").SetIntValue(-static_cast<int>(j));
+    }
+  }
+}
+
+long long GetElapsedMilliseconds(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+}  // namespace
+
+TEST_CASE("Serializer - Benchmarks", "[common]") {
+  gd::SerializerElement element;
+  element.AddChild("name").SetStringValue("Benchmark project");
+  FillObjectsElement(element, 50000);
+  gd::String json = gd::Serializer::ToJSON(element);
+  const std::string& utf8Json = json.Raw();
+
+  auto start = std::chrono::steady_clock::now();
+  gd::SerializerElement parsedElement = gd::Serializer::FromJSON(utf8Json);
+
+  std::cout << "Parsing " << utf8Json.size() / 1000000
+            << "MB of JSON: " << GetElapsedMilliseconds(start) << "ms"
+            << std::endl;
+  REQUIRE(gd::Serializer::ToJSON(parsedElement) == json);
+
+  std::string binary = gd::Serializer::ToBinary(element);
+  start = std::chrono::steady_clock::now();
+  gd::SerializerElement binaryElement =
+      gd::Serializer::FromBinary(binary.data(), binary.size());
+
+  std::cout << "Reading the same element from " << binary.size() / 1000000
+            << "MB of binary: " << GetElapsedMilliseconds(start) << "ms"
+            << std::endl;
+  REQUIRE(gd::Serializer::ToJSON(binaryElement) == json);
+}
+
+TEST_CASE("SerializerElement - Benchmarks", "[common]") {
+  SECTION("Loading a layout with 100000 instances") {
+    gd::InitialInstancesContainer instances;
+    for (std::size_t i = 0; i < 100000; ++i) {
+      gd::InitialInstance& instance = instances.InsertNewInitialInstance();
+      instance.SetObjectName("MyObject" + gd::String::From(i % 100));
+      instance.SetX(i);
+      instance.SetY(i * 2);
+      instance.SetLayer("Layer" + gd::String::From(i % 3));
+      instance.SetRawFloatProperty("animation", 2);
+      instance.SetRawStringProperty("text", "Hello");
+    }
+    gd::SerializerElement element;
+    instances.SerializeTo(element);
+    gd::String json = gd::Serializer::ToJSON(element);
+
+    auto start = std::chrono::steady_clock::now();
+    gd::SerializerElement parsedElement = gd::Serializer::FromJSON(json);
+    long long parsingTime = GetElapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    gd::InitialInstancesContainer loadedInstances;
+    loadedInstances.UnserializeFrom(parsedElement);
+    long long loadingTime = GetElapsedMilliseconds(start);
+
+    std::cout << "Parsing the instances: " << parsingTime
+              << "ms, loading them: " << loadingTime << "ms" << std::endl;
+    REQUIRE(loadedInstances.GetInstancesCount() == 100000);
+    gd::SerializerElement loadedElement;
+    loadedInstances.SerializeTo(loadedElement);
+    REQUIRE(gd::Serializer::ToJSON(loadedElement) == json);
+  }
+  SECTION("Accessing the children of a wide element") {
+    gd::SerializerElement element;
+    for (std::size_t i = 0; i < 20000; ++i)
+      element.AddChild("child" + gd::String::From(i)).SetIntValue(i);
+
+    auto start = std::chrono::steady_clock::now();
+    int sum = 0;
+    for (std::size_t i = 0; i < 20000; ++i) {
+      gd::String name = "child" + gd::String::From(i);
+      if (element.HasChild(name)) sum += element.GetChild(name).GetIntValue();
+    }
+    std::cout << "Accessing the children of a wide element: "
+              << GetElapsedMilliseconds(start) << "ms" << std::endl;
+    REQUIRE(sum == 20000 * 19999 / 2);
+  }
+}
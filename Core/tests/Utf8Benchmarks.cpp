@@ -0,0 +1,82 @@
+/*
+ * GDevelop Core
+ * Copyright 2015-2016 Victor Levasseur (victorlevasseur52@gmail.com)
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the utf8 strings of GDevelop Core.
+ */
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+TEST_CASE("Utf8 String - Benchmarks", "[common][utf8]") {
+  SECTION("Positions in ASCII and multibyte strings") {
+    const std::size_t size = 20000;
+    gd::String ascii, multibyte;
+    for (std::size_t i = 0; i < size / 4; ++i) {
+      ascii += "ab_c";
+      multibyte += u8"aé_€";
+    }
+
+    auto benchmark = [](const gd::String& str, const char* name) {
+      auto start = std::chrono::steady_clock::now();
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < str.size(); ++i)
+        if (str[i] == U'_') count++;
+
+      std::size_t pos = 0;
+      while ((pos = str.find("_", pos)) != gd::String::npos) {
+        count++;
+        pos++;
+      }
+
+      for (std::size_t i = 0; i + 4 <= str.size(); i += 4)
+        if (str.substr(i, 4)[2] == U'_') count++;
+
+      std::cout << "Indexing, finding and extracting in a " << name
+                << " string: "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count()
+                << "ms" << std::endl;
+      return count;
+    };
+
+    REQUIRE(benchmark(ascii, "ASCII") == 3 * size / 4);
+    REQUIRE(benchmark(multibyte, "multibyte") == 3 * size / 4);
+  }
+  SECTION("Conversions from/to numbers") {
+    const int count = 200000;
+    auto start = std::chrono::steady_clock::now();
+    double streamSum = 0;
+    for (int i = 0; i < count; ++i) {
+      std::ostringstream oss;
+      oss << i * 0.25;
+      std::istringstream iss(oss.str());
+      double value;
+      iss >> value;
+      streamSum += value;
+    }
+    auto streamDuration = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    double sum = 0;
+    for (int i = 0; i < count; ++i)
+      sum += gd::String::From(i * 0.25).To<double>();
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Converting " << count << " numbers to strings and back: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     duration)
+                     .count()
+              << "ms (with streams: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     streamDuration)
+                     .count()
+              << "ms)" << std::endl;
+    REQUIRE(sum == streamSum);
+  }
+}
@@ -8,13 +8,50 @@
  */
 
 #include <SFML/System/String.hpp>
+#include <clocale>
+#include <cmath>
 #include <exception>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
 #include <vector>
 #include "GDCore/String.h"
 #include "catch.hpp"
 
+namespace {
+template <typename T>
+std::string StreamFrom(T value) {
+  std::ostringstream oss;
+  oss << value;
+  return oss.str();
+}
+
+template <typename T>
+T StreamTo(const std::string& str) {
+  T value = 0;
+  std::istringstream iss(str);
+  iss >> value;
+  return value;
+}
+
+template <typename T>
+void RequireSameAsStreams(const std::vector<T>& values,
+                          const std::vector<std::string>& strings) {
+  for (T value : values) {
+    INFO(StreamFrom(value));
+    REQUIRE(gd::String::From(value).Raw() == StreamFrom(value));
+  }
+  for (const std::string& str : strings) {
+    INFO(str);
+    T value = gd::String(str.c_str()).To<T>();
+    T streamValue = StreamTo<T>(str);
+    REQUIRE(value == streamValue);
+    REQUIRE(std::signbit(value) == std::signbit(streamValue));
+  }
+}
+}  // namespace
+
 TEST_CASE("Utf8 String", "[common][utf8]") {
   SECTION("ctor & conversions") {
     gd::String str = u8"UTF8 a été testé !";
@@ -196,6 +233,83 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
     REQUIRE(gd::String("15").To<unsigned int>() == 15);
     REQUIRE(gd::String("15.6").To<float>() == 15.6f);
     REQUIRE(gd::String("15.6").To<double>() == 15.6);
+
+    REQUIRE(gd::String::From('a') == "a");
+    REQUIRE(gd::String("").To<int>() == 0);
+    REQUIRE(gd::String("abc").To<double>() == 0);
+  }
+
+  SECTION("conversions from/to numbers are the same as with streams") {
+    std::vector<std::string> integers = {
+        "0", "42", "-42", "+7", "  \t\n12", "12abc", "abc", "-", "+",
+        "0x10", "007", "2147483647", "2147483648", "-2147483648",
+        "-2147483649", "65535", "65536", "-1", "-70000",
+        "9223372036854775807", "9223372036854775808",
+        "-9223372036854775808", "-9223372036854775809",
+        "18446744073709551615", "18446744073709551616",
+        "-18446744073709551615", "99999999999999999999999", "1.5", "1e3"};
+    RequireSameAsStreams<int>(
+        {0, 1, -1, 42, std::numeric_limits<int>::max(),
+         std::numeric_limits<int>::min()},
+        integers);
+    RequireSameAsStreams<unsigned int>(
+        {0, 42, std::numeric_limits<unsigned int>::max()}, integers);
+    RequireSameAsStreams<unsigned short>({0, 42, 65535}, integers);
+    RequireSameAsStreams<long long>(
+        {0, -5, std::numeric_limits<long long>::max(),
+         std::numeric_limits<long long>::min()},
+        integers);
+    RequireSameAsStreams<std::size_t>(
+        {0, 42, std::numeric_limits<std::size_t>::max()}, integers);
+
+    std::vector<std::string> floatingPointNumbers = {
+        "0", "-0", "15.6", "  -15.6", "+.5", ".5", "5.", ".", "-", "1e",
+        "1e+", "1e-3", "1E3", "2.5e+2xyz", "1.2.3", "1e2e3", "e5", "inf",
+        "nan", "0x1p3", "3.4e39", "-3.4e39", "1e400", "-1e400", "1e-400",
+        "123456789012345678901234567890", "0.1", "3.14159265358979"};
+    RequireSameAsStreams<float>(
+        {0.f, -0.f, 15.6f, 0.1f, 1e-5f, 1e20f, 123456.f, 1234567.f,
+         std::numeric_limits<float>::max(),
+         std::numeric_limits<float>::infinity()},
+        floatingPointNumbers);
+    RequireSameAsStreams<double>(
+        {0., -0., 15.6, 0.1 + 0.2, 1. / 3, -2.5e-7, 1e20, 999999.5,
+         999999., -999999., 1e6, 123456789., 1e100, std::numeric_limits<double>::max(),
+         std::numeric_limits<double>::denorm_min(),
+         -std::numeric_limits<double>::infinity()},
+        floatingPointNumbers);
+    RequireSameAsStreams<long double>({0.L, 15.6L, 1e300L * 1e300L},
+                                      floatingPointNumbers);
+    REQUIRE(gd::String::From(std::numeric_limits<double>::quiet_NaN()).Raw() ==
+            StreamFrom(std::numeric_limits<double>::quiet_NaN()));
+  }
+
+  SECTION("conversions from/to numbers whatever the locale") {
+    // Use a locale with a comma as the decimal separator, if one is installed.
+    gd::String previousLocale = std::setlocale(LC_NUMERIC, nullptr);
+    bool commaLocale = false;
+    for (const char* name :
+         {"fr_FR.UTF-8", "fr_FR.utf8", "de_DE.UTF-8", "de_DE.utf8", "French"}) {
+      if (std::setlocale(LC_NUMERIC, name)) {
+        commaLocale = true;
+        break;
+      }
+    }
+    if (!commaLocale)
+      WARN("No locale with a comma as decimal separator, using the C one.");
+
+    gd::String fromDouble = gd::String::From(-15.25);
+    gd::String fromFloat = gd::String::From(0.5f);
+    double toDouble = gd::String("-15.25").To<double>();
+    float toFloat = gd::String("0.5").To<float>();
+    double roundTrip = gd::String::From(1234.5).To<double>();
+    std::setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    REQUIRE(fromDouble == "-15.25");
+    REQUIRE(fromFloat == "0.5");
+    REQUIRE(toDouble == -15.25);
+    REQUIRE(toFloat == 0.5f);
+    REQUIRE(roundTrip == 1234.5);
   }
 
   SECTION("operator+=") {
@@ -289,4 +403,54 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
     gd::String str6 = u8"ßßß";
     REQUIRE(str6.FindAndReplace(u8"ßß", u8"ß") == u8"ßß");
   }
+
+  SECTION("size after modifications") {
+    gd::String str = "ASCII";
+    REQUIRE(str.size() == 5);
+    str += u8" et accentué";
+    REQUIRE(str.size() == 17);
+    REQUIRE(str[16] == U'é');
+    str.push_back(U'€');
+    REQUIRE(str.size() == 18);
+    str.insert(0, u8"Début ");
+    REQUIRE(str.size() == 24);
+    REQUIRE(str == u8"Début ASCII et accentué€");
+    str.erase(0, 6);
+    REQUIRE(str.size() == 18);
+    str.replace(0, 5, "Texte");
+    REQUIRE(str.size() == 18);
+    str.replace(str.begin(), str.end(), "ASCII");
+    REQUIRE(str.size() == 5);
+    REQUIRE(str[4] == U'I');
+    str.pop_back();
+    REQUIRE(str.size() == 4);
+
+    // Modifying the raw string resets the size.
+    str.Raw() += u8"é";
+    REQUIRE(str.size() == 5);
+    REQUIRE(str[4] == U'é');
+    str.Raw() = "A";
+    REQUIRE(str.size() == 1);
+
+    gd::String copy = str;
+    gd::String moved = std::move(copy);
+    REQUIRE(moved.size() == 1);
+    moved.clear();
+    REQUIRE(moved.size() == 0);
+  }
+
+  SECTION("ASCII strings") {
+    gd::String str = "An ASCII sentence";
+
+    REQUIRE(str[3] == U'A');
+    REQUIRE(str.substr(3, 5) == "ASCII");
+    REQUIRE(str.substr(9, 100) == "sentence");
+    REQUIRE(str.substr(17) == "");
+    REQUIRE_THROWS_AS(str.substr(18), std::out_of_range);
+    REQUIRE(str.find("sentence", 4) == 9);
+    REQUIRE(str.rfind("n", 12) == 11);
+    REQUIRE(str.find_first_of("CS") == 4);
+    REQUIRE(str.find_last_not_of("ecn") == 12);
+    REQUIRE(str.find_first_of(u8"é") == gd::String::npos);
+  }
 }
@@ -45,6 +45,7 @@ class AnchorBehaviorCppExtension : public ExtensionBase {
     AddRuntimeBehavior<AnchorRuntimeBehavior>(
         GetBehaviorMetadata("AnchorBehavior::AnchorBehavior"),
         "AnchorRuntimeBehavior");
+    GetBehaviorMetadata("AnchorBehavior::AnchorBehavior").SetObjectLocal();
     GetBehaviorMetadata("AnchorBehavior::AnchorBehavior")
         .SetIncludeFile("AnchorBehavior/AnchorRuntimeBehavior.h");
 
@@ -0,0 +1,643 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingPathsService.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <tuple>
+#include "ScenePathfindingObstaclesManager.h"
+
+/**
+ * \brief Internal tool class representing the position of a node when looking
+ * for a path.
+ */
+class NodePosition {
+ public:
+  NodePosition(int x_, int y_) : x(x_), y(y_){};
+
+  int x;
+  int y;
+};
+
+std::ostream& operator<<(std::ostream& stream, const NodePosition& nodePos) {
+  stream << nodePos.x << ";" << nodePos.y;
+  return stream;
+}
+
+bool operator==(const NodePosition& a, const NodePosition& b) {
+  return ((a.x == b.x) && (a.y == b.y));
+}
+
+namespace {
+/**
+ * \brief Internal tool class representing a node when looking for a path
+ */
+class Node {
+ public:
+  Node(const NodePosition& pos_)
+      : pos(pos_),
+        cost(0),
+        smallestCost(-1),
+        estimateCost(-1),
+        parent(NoParent),
+        openSequence(0),
+        open(true){};
+
+  static const std::size_t NoParent = static_cast<std::size_t>(-1);
+
+  NodePosition pos;
+  float cost;          ///< The cost for traveling on this node
+  float smallestCost;  ///< the cost to go to this node (when considering the
+                       ///< shortest path).
+  float estimateCost;  ///< the estimate cost total to go to the destination
+                       ///< through this node (when considering the shortest
+                       ///< path).
+  std::size_t parent;  ///< The index of the previous node to be visited to go
+                       ///< to this node (when considering the shortest path),
+                       ///< or NoParent.
+  std::size_t openSequence;  ///< The sequence of the last entry of the node in
+                             ///< the open nodes (see OpenNode).
+  bool open;  ///< true if the node is "open" (must be explored), false if
+              ///< "close" (already explored)
+};
+
+/**
+ * \brief An entry of the open nodes heap.
+ *
+ * When the estimate cost of a node is updated, a new entry is added and the
+ * old one is ignored when it reaches the top of the heap (its sequence is not
+ * the one of the node anymore).
+ */
+struct OpenNode {
+  float estimateCost;
+  std::size_t sequence;  ///< Incremented for each entry added, so that nodes
+                         ///< with the same estimate cost are explored in the
+                         ///< order they were opened.
+  std::size_t node;      ///< The index of the node.
+
+  /**
+   * \brief Tool function used to store the most promising entry at the top of
+   * a heap.
+   */
+  class IsExploredAfter {
+   public:
+    bool operator()(const OpenNode& a, const OpenNode& b) const {
+      if (a.estimateCost != b.estimateCost)
+        return a.estimateCost > b.estimateCost;
+      return a.sequence > b.sequence;
+    }
+  };
+};
+
+typedef float (*DistanceFunPtr)(const NodePosition&, const NodePosition&);
+
+/**
+ * \brief Internal tool class containing the structures used by A* and members
+ * functions related to them.
+ *
+ * The nodes are stored in a vector, and found from their position thanks to
+ * an open addressing hash table. The open nodes are stored in a binary heap.
+ */
+class SearchContext {
+ public:
+  SearchContext(const ScenePathfindingObstaclesManager& obstacles_,
+                bool allowsDiagonal_ = true)
+      : obstacles(obstacles_),
+        finalNode(Node::NoParent),
+        start(0, 0),
+        destination(0, 0),
+        allowsDiagonal(allowsDiagonal_),
+        maxComplexityFactor(50),
+        cellWidth(20),
+        cellHeight(20),
+        leftBorder(0),
+        rightBorder(0),
+        topBorder(0),
+        bottomBorder(0),
+        openSequence(0) {
+    distanceFunction = allowsDiagonal ? &SearchContext::EuclideanDistance
+                                      : &SearchContext::ManhattanDistance;
+  }
+
+  /**
+   * \brief Set the start position, in "node" coordinates.
+   */
+  SearchContext& SetStartPosition(const NodePosition& start_) {
+    start = start_;
+    return *this;
+  }
+
+  /**
+   * \brief Set the size to be considered for the object for which the path will
+   * be planned.
+   */
+  SearchContext& SetObjectSize(float leftBorder_,
+                               float topBorder_,
+                               float rightBorder_,
+                               float bottomBorder_) {
+    leftBorder = leftBorder_;
+    rightBorder = rightBorder_;
+    topBorder = topBorder_;
+    bottomBorder = bottomBorder_;
+    return *this;
+  }
+
+  /**
+   * \brief Change the size of a virtual cell, in pixels.
+   */
+  SearchContext& SetCellSize(unsigned int cellWidth_,
+                             unsigned int cellHeight_) {
+    cellWidth = cellWidth_;
+    cellHeight = cellHeight_;
+    return *this;
+  }
+
+  /**
+   * \brief Compute a path to the specified position, considering the obstacles
+   * and the start position.
+   * \return true if computation found a path, in which case you can call
+   * GetFinalNode method to construct the path. \param destination_ The
+   * target position, in "node" coordinates.
+   */
+  bool ComputePathTo(const NodePosition& destination_) {
+    destination = destination_;
+
+    // Initialize the algorithm. The search usually stays around the rectangle
+    // between the start and the destination: the table is sized for it.
+    std::size_t expectedNodesCount =
+        std::min<std::size_t>((std::abs(destination.x - start.x) + 3) *
+                                  (std::abs(destination.y - start.y) + 3),
+                              MaxInitialNodesCount);
+    std::size_t tableSize = 256;
+    while (tableSize < expectedNodesCount * 2) tableSize *= 2;
+    nodes.clear();
+    nodes.reserve(tableSize / 2);
+    nodesTable.assign(tableSize, EmptySlot);
+    openNodes.clear();
+
+    std::size_t startNodeIndex = GetNode(start);
+    Node& startNode = nodes[startNodeIndex];
+    startNode.smallestCost = 0;
+    startNode.estimateCost = 0 + distanceFunction(start, destination);
+    Open(startNodeIndex);
+
+    // A* algorithm main loop
+    std::size_t iterationCount = 0;
+    std::size_t maxIterationCount =
+        nodes[startNodeIndex].estimateCost * maxComplexityFactor;
+    while (!openNodes.empty()) {
+      // Get the most promising node...
+      std::pop_heap(
+          openNodes.begin(), openNodes.end(), OpenNode::IsExploredAfter());
+      OpenNode openNode = openNodes.back();
+      openNodes.pop_back();
+
+      Node& n = nodes[openNode.node];
+      if (!n.open || n.openSequence != openNode.sequence)
+        continue;  // The node was opened again since this entry was added.
+
+      if (iterationCount++ > maxIterationCount)
+        return false;  // Make sure we do not search forever.
+
+      n.open = false;  //...and flag it as explored
+
+      // Check if we reached destination?
+      if (n.pos.x == destination.x && n.pos.y == destination.y) {
+        finalNode = openNode.node;
+        return true;
+      }
+
+      // No, so add neighbors to the nodes to explore.
+      InsertNeighbors(openNode.node);
+    }
+
+    return false;
+  }
+
+  /**
+   * @return The final node of the computed path.
+   * Iterate using GetParent to create the path. Beware, the coordinates of
+   * the node must be multiplied by the cell size to get the "world" coordinates
+   * of the path.
+   */
+  const Node* GetFinalNode() const {
+    return finalNode != Node::NoParent ? &nodes[finalNode] : NULL;
+  }
+
+  /**
+   * @return The node before \a node in the computed path, or NULL for the
+   * first node.
+   */
+  const Node* GetParent(const Node& node) const {
+    return node.parent != Node::NoParent ? &nodes[node.parent] : NULL;
+  }
+
+ private:
+  /**
+   * Insert the neighbors of the current node in the open list
+   * (Only if they are not closed, and if the cost is better than the already
+   * existing smallest cost).
+   */
+  void InsertNeighbors(std::size_t currentNode) {
+    const NodePosition pos = nodes[currentNode].pos;
+    AddOrUpdateNode(NodePosition(pos.x + 1, pos.y), currentNode, 1);
+    AddOrUpdateNode(NodePosition(pos.x - 1, pos.y), currentNode, 1);
+    AddOrUpdateNode(NodePosition(pos.x, pos.y + 1), currentNode, 1);
+    AddOrUpdateNode(NodePosition(pos.x, pos.y - 1), currentNode, 1);
+    if (allowsDiagonal) {
+      AddOrUpdateNode(NodePosition(pos.x + 1, pos.y + 1), currentNode, sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x + 1, pos.y - 1), currentNode, sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x - 1, pos.y - 1), currentNode, sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x - 1, pos.y + 1), currentNode, sqrt2);
+    }
+  }
+
+  /**
+   * \brief Get (or dynamically construct) a node, and return its index.
+   *
+   * *All* nodes should be created using this method: The cost of the node is
+   * computed thanks to the objects flagged as obstacles.
+   *
+   * \warning Creating a node invalidates the references to the other nodes.
+   */
+  std::size_t GetNode(const NodePosition& pos) {
+    std::size_t mask = nodesTable.size() - 1;
+    std::size_t slot = HashPosition(pos) & mask;
+    while (nodesTable[slot] != EmptySlot) {
+      if (nodes[nodesTable[slot]].pos == pos) return nodesTable[slot];
+      slot = (slot + 1) & mask;
+    }
+
+    Node newNode(pos);
+    ComputeNodeCost(newNode);
+
+    std::size_t index = nodes.size();
+    nodes.push_back(newNode);
+    nodesTable[slot] = index;
+    if (nodes.size() * 2 > nodesTable.size()) GrowNodesTable();
+    return index;
+  }
+
+  /**
+   * \brief Compute the cost of a node from the obstacles covering it.
+   */
+  void ComputeNodeCost(Node& node) {
+    // Only the obstacles around the cell can cover it (the area is enlarged by
+    // a cell to be sure that none is missed because of rounding).
+    float x = node.pos.x * cellWidth;
+    float y = node.pos.y * cellHeight;
+    bool objectsOnCell = false;
+    obstacles.ForEachObstacleInArea(
+        x - leftBorder - cellWidth,
+        y - topBorder - cellHeight,
+        x + rightBorder + cellWidth,
+        y + bottomBorder + cellHeight,
+        [&](const ScenePathfindingObstaclesManager::IndexedObstacle&
+                obstacle) {
+          if (node.cost < 0) return;  // The cell is impassable, stop here.
+
+          const ScenePathfindingObstaclesManager::Bounds& bounds =
+              obstacle.bounds;
+          int topLeftCellX = floor((bounds.left - rightBorder) / cellWidth);
+          int topLeftCellY = floor((bounds.top - bottomBorder) / cellHeight);
+          int bottomRightCellX =
+              ceil((bounds.right + leftBorder) / cellWidth);
+          int bottomRightCellY =
+              ceil((bounds.bottom + topBorder) / cellHeight);
+          if (topLeftCellX < node.pos.x && node.pos.x < bottomRightCellX &&
+              topLeftCellY < node.pos.y && node.pos.y < bottomRightCellY) {
+            objectsOnCell = true;
+            if (obstacle.impassable)
+              node.cost = -1;
+            else  // Superimpose obstacles
+              node.cost += obstacle.cost;
+          }
+        });
+
+    if (!objectsOnCell)
+      node.cost = 1;  // Default cost when no objects put on the cell.
+  }
+
+  /**
+   * \brief Double the size of the table of the nodes.
+   */
+  void GrowNodesTable() {
+    nodesTable.assign(nodesTable.size() * 2, EmptySlot);
+    std::size_t mask = nodesTable.size() - 1;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      std::size_t slot = HashPosition(nodes[i].pos) & mask;
+      while (nodesTable[slot] != EmptySlot) slot = (slot + 1) & mask;
+      nodesTable[slot] = i;
+    }
+  }
+
+  static std::size_t HashPosition(const NodePosition& pos) {
+    std::uint32_t hash = static_cast<std::uint32_t>(pos.x) * 0x9E3779B1u ^
+                         static_cast<std::uint32_t>(pos.y) * 0x85EBCA77u;
+    return hash ^ (hash >> 15);
+  }
+
+  /**
+   * \brief Add an entry for the node in the open nodes.
+   */
+  void Open(std::size_t node) {
+    OpenNode openNode;
+    openNode.estimateCost = nodes[node].estimateCost;
+    openNode.sequence = ++openSequence;
+    openNode.node = node;
+    nodes[node].openSequence = openNode.sequence;
+    openNodes.push_back(openNode);
+    std::push_heap(
+        openNodes.begin(), openNodes.end(), OpenNode::IsExploredAfter());
+  }
+
+  /**
+   * Compute the euclidean distance between two positions.
+   */
+  static float EuclideanDistance(const NodePosition& a, const NodePosition& b) {
+    return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+  }
+
+  /**
+   * Compute the taxi distance between two positions.
+   */
+  static float ManhattanDistance(const NodePosition& a, const NodePosition& b) {
+    return abs(a.x - b.x) + abs(a.y - b.y);
+  }
+
+  /**
+   * Add a node to the openNodes (only if the cost to reach it is less than the
+   * existing cost, if any).
+   */
+  void AddOrUpdateNode(const NodePosition& newNodePosition,
+                       std::size_t currentNodeIndex,
+                       float factor) {
+    std::size_t neighborIndex = GetNode(newNodePosition);
+    Node& neighbor = nodes[neighborIndex];
+    const Node& currentNode = nodes[currentNodeIndex];
+    if (!neighbor.open ||
+        neighbor.cost < 0)  // cost < 0 means impassable obstacle
+      return;
+
+    // Update the node costs and parent if the path coming from currentNode is
+    // better (if the node was already opened, its previous entry in the open
+    // nodes will be ignored):
+    if (neighbor.smallestCost == -1 ||
+        neighbor.smallestCost >
+            currentNode.smallestCost +
+                (currentNode.cost + neighbor.cost) / 2.0 * factor) {
+      neighbor.smallestCost = currentNode.smallestCost +
+                              (currentNode.cost + neighbor.cost) / 2.0 * factor;
+      neighbor.parent = currentNodeIndex;
+      neighbor.estimateCost =
+          neighbor.smallestCost + distanceFunction(neighbor.pos, destination);
+
+      Open(neighborIndex);
+    }
+  }
+
+  static const std::size_t EmptySlot = static_cast<std::size_t>(-1);
+  static const std::size_t MaxInitialNodesCount = 16384;
+
+  std::vector<Node> nodes;  ///< All the nodes
+  std::vector<std::size_t>
+      nodesTable;  ///< The indices of the nodes in nodes (or EmptySlot), at a
+                   ///< slot found from the hash of their position.
+  std::vector<OpenNode> openNodes;  ///< The binary heap of the open nodes.
+  const ScenePathfindingObstaclesManager&
+      obstacles;           ///< A reference to all the obstacles of the scene
+  std::size_t finalNode;  ///< If computation succeeded, the index of the final
+                          ///< node.
+  NodePosition start;
+  NodePosition destination;
+  DistanceFunPtr distanceFunction;
+  bool allowsDiagonal;  ///< True to allow diagonals when planning the path.
+  std::size_t maxComplexityFactor;
+  float cellWidth;
+  float cellHeight;
+  float leftBorder;
+  float rightBorder;
+  float topBorder;
+  float bottomBorder;
+  std::size_t openSequence;  ///< The sequence of the last entry added to the
+                             ///< open nodes.
+
+  static const float sqrt2;
+};
+
+const std::size_t Node::NoParent;
+const std::size_t SearchContext::EmptySlot;
+const std::size_t SearchContext::MaxInitialNodesCount;
+const float SearchContext::sqrt2 = 1.414213562;
+
+}  // namespace
+
+bool PathfindingRequest::operator<(const PathfindingRequest& other) const {
+  return std::tie(startCellX,
+                  startCellY,
+                  destinationCellX,
+                  destinationCellY,
+                  cellWidth,
+                  cellHeight,
+                  allowDiagonals,
+                  leftBorder,
+                  topBorder,
+                  rightBorder,
+                  bottomBorder) < std::tie(other.startCellX,
+                                           other.startCellY,
+                                           other.destinationCellX,
+                                           other.destinationCellY,
+                                           other.cellWidth,
+                                           other.cellHeight,
+                                           other.allowDiagonals,
+                                           other.leftBorder,
+                                           other.topBorder,
+                                           other.rightBorder,
+                                           other.bottomBorder);
+}
+
+PathfindingPathsService::PathfindingPathsService(
+    ScenePathfindingObstaclesManager& obstacles_)
+    : obstacles(obstacles_),
+      obstaclesVersion(0),
+      usesCount(0),
+      maxCachedPathsCount(256),
+      threadsCount(0),
+      cacheHitsCount(0),
+      searchesCount(0) {}
+
+std::shared_ptr<const PathfindingResult> PathfindingPathsService::FindPath(
+    const PathfindingRequest& request) {
+  UpdateObstacles();
+  std::shared_ptr<PathfindingResult> result = GetCachedPath(request);
+  if (result) return result;
+
+  auto pendingRequest = pendingRequests.find(request);
+  if (pendingRequest != pendingRequests.end()) {
+    // Solve it now rather than waiting for SolvePendingRequests.
+    result = pendingRequest->second;
+    pendingRequests.erase(pendingRequest);
+  } else {
+    result = std::make_shared<PathfindingResult>();
+  }
+
+  result->request = request;
+  Solve(request, *result);
+  searchesCount++;
+  result->solved = true;
+  result->obstaclesVersion = obstaclesVersion;
+  CachePath(request, result);
+  return result;
+}
+
+std::shared_ptr<const PathfindingResult> PathfindingPathsService::RequestPath(
+    const PathfindingRequest& request) {
+  UpdateObstacles();
+  std::shared_ptr<PathfindingResult> result = GetCachedPath(request);
+  if (result) return result;
+
+  std::shared_ptr<PathfindingResult>& pendingResult = pendingRequests[request];
+  if (pendingResult) {
+    cacheHitsCount++;
+  } else {
+    pendingResult = std::make_shared<PathfindingResult>();
+    pendingResult->request = request;
+  }
+
+  return pendingResult;
+}
+
+bool PathfindingPathsService::IsUpToDate(const PathfindingResult& result) {
+  if (!result.solved) return true;
+
+  UpdateObstacles();
+  return result.obstaclesVersion == obstaclesVersion;
+}
+
+std::size_t PathfindingPathsService::GetPendingRequestsCount() const {
+  return std::count_if(
+      pendingRequests.begin(),
+      pendingRequests.end(),
+      [](const std::pair<const PathfindingRequest,
+                         std::shared_ptr<PathfindingResult> >& pendingRequest) {
+        return !IsAbandoned(pendingRequest.second);
+      });
+}
+
+void PathfindingPathsService::SolvePendingRequests() {
+  for (auto it = pendingRequests.begin(); it != pendingRequests.end();) {
+    if (IsAbandoned(it->second))
+      it = pendingRequests.erase(it);
+    else
+      ++it;
+  }
+  if (pendingRequests.empty()) return;
+
+  // The index is not changed while the requests are solved: the threads only
+  // read it.
+  UpdateObstacles();
+  std::vector<std::pair<const PathfindingRequest*, PathfindingResult*> >
+      requests;
+  for (auto& pendingRequest : pendingRequests)
+    requests.push_back(
+        std::make_pair(&pendingRequest.first, pendingRequest.second.get()));
+
+  jobsPool.SetThreadsCount(threadsCount);
+  jobsPool.ParallelFor(
+      requests.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          Solve(*requests[i].first, *requests[i].second);
+      });
+  searchesCount += requests.size();
+
+  for (auto& pendingRequest : pendingRequests) {
+    pendingRequest.second->solved = true;
+    pendingRequest.second->obstaclesVersion = obstaclesVersion;
+    CachePath(pendingRequest.first, pendingRequest.second);
+  }
+  pendingRequests.clear();
+}
+
+void PathfindingPathsService::SetMaxCachedPathsCount(std::size_t count) {
+  maxCachedPathsCount = count;
+  while (cachedPaths.size() > maxCachedPathsCount) {
+    auto leastRecentlyUsed = leastRecentlyUsedPaths.begin();
+    cachedPaths.erase(leastRecentlyUsed->second);
+    leastRecentlyUsedPaths.erase(leastRecentlyUsed);
+  }
+}
+
+void PathfindingPathsService::ClearCache() {
+  cachedPaths.clear();
+  leastRecentlyUsedPaths.clear();
+}
+
+void PathfindingPathsService::UpdateObstacles() {
+  obstacles.UpdateObstaclesIndex();
+  if (obstacles.GetObstaclesVersion() != obstaclesVersion) {
+    ClearCache();
+    obstaclesVersion = obstacles.GetObstaclesVersion();
+  }
+}
+
+std::shared_ptr<PathfindingResult> PathfindingPathsService::GetCachedPath(
+    const PathfindingRequest& request) {
+  auto cachedPath = cachedPaths.find(request);
+  if (cachedPath == cachedPaths.end()) return nullptr;
+
+  cacheHitsCount++;
+  leastRecentlyUsedPaths.erase(
+      std::make_pair(cachedPath->second.lastUse, request));
+  cachedPath->second.lastUse = ++usesCount;
+  leastRecentlyUsedPaths.insert(
+      std::make_pair(cachedPath->second.lastUse, request));
+  return cachedPath->second.result;
+}
+
+void PathfindingPathsService::CachePath(
+    const PathfindingRequest& request,
+    const std::shared_ptr<PathfindingResult>& result) {
+  if (maxCachedPathsCount == 0) return;
+
+  if (cachedPaths.size() >= maxCachedPathsCount) {
+    auto leastRecentlyUsed = leastRecentlyUsedPaths.begin();
+    cachedPaths.erase(leastRecentlyUsed->second);
+    leastRecentlyUsedPaths.erase(leastRecentlyUsed);
+  }
+
+  CachedPath& cachedPath = cachedPaths[request];
+  cachedPath.result = result;
+  cachedPath.lastUse = ++usesCount;
+  leastRecentlyUsedPaths.insert(std::make_pair(cachedPath.lastUse, request));
+}
+
+void PathfindingPathsService::Solve(const PathfindingRequest& request,
+                                    PathfindingResult& result) const {
+  ::SearchContext ctx(obstacles, request.allowDiagonals);
+  ctx.SetCellSize(request.cellWidth, request.cellHeight)
+      .SetStartPosition(
+          NodePosition(request.startCellX, request.startCellY));
+  ctx.SetObjectSize(request.leftBorder,
+                    request.topBorder,
+                    request.rightBorder,
+                    request.bottomBorder);
+
+  result.path.clear();
+  result.found = ctx.ComputePathTo(
+      NodePosition(request.destinationCellX, request.destinationCellY));
+  if (!result.found) return;
+
+  const ::Node* node = ctx.GetFinalNode();
+  while (node) {
+    result.path.push_back(
+        sf::Vector2f(node->pos.x * (float)request.cellWidth,
+                     node->pos.y * (float)request.cellHeight));
+    node = ctx.GetParent(*node);
+  }
+  std::reverse(result.path.begin(), result.path.end());
+}
@@ -0,0 +1,211 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGPATHSSERVICE_H
+#define PATHFINDINGPATHSSERVICE_H
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "GDCpp/Runtime/JobsPool.h"
+class ScenePathfindingObstaclesManager;
+
+/**
+ * \brief The parameters of a path search: two searches with the same
+ * parameters give the same path, as long as the obstacles are not changed.
+ */
+struct PathfindingRequest {
+  int startCellX;
+  int startCellY;
+  int destinationCellX;
+  int destinationCellY;
+  unsigned int cellWidth;
+  unsigned int cellHeight;
+  bool allowDiagonals;
+  float leftBorder;  ///< The size of the object moving on the path, around
+                     ///< its position.
+  float topBorder;
+  float rightBorder;
+  float bottomBorder;
+
+  bool operator<(const PathfindingRequest& other) const;
+};
+
+/**
+ * \brief The result of a path search.
+ */
+struct PathfindingResult {
+  PathfindingResult() : solved(false), found(false), obstaclesVersion(0){};
+
+  PathfindingRequest request;
+  bool solved;  ///< False while the request is waiting to be solved.
+  bool found;   ///< True if a path was found.
+  std::vector<sf::Vector2f> path;  ///< The nodes of the path, in "world"
+                                   ///< coordinates.
+  std::size_t obstaclesVersion;  ///< The version of the obstacles for which
+                                 ///< the path was computed.
+};
+
+/**
+ * \brief Compute the paths avoiding the obstacles of a scene.
+ *
+ * The paths are cached, so that objects going to the same destination from
+ * the same place only compute it once. The cache is cleared when an obstacle
+ * is changed.
+ *
+ * Requests can also be queued, to be solved together on several threads by
+ * SolvePendingRequests. Identical requests are solved only once. The result of
+ * a request does not depend on the other requests or on the number of
+ * threads.
+ *
+ * \see ScenePathfindingObstaclesManager::GetPathsService
+ */
+class PathfindingPathsService {
+ public:
+  PathfindingPathsService(ScenePathfindingObstaclesManager& obstacles_);
+
+  PathfindingPathsService(const PathfindingPathsService&) = delete;
+  PathfindingPathsService& operator=(const PathfindingPathsService&) = delete;
+
+  /**
+   * \brief Return the path for the request, computing it if it is not cached.
+   */
+  std::shared_ptr<const PathfindingResult> FindPath(
+      const PathfindingRequest& request);
+
+  /**
+   * \brief Queue a request, to be solved by the next call to
+   * SolvePendingRequests.
+   *
+   * The request is dropped if the result is released before being solved
+   * (for example when an object requests another path, or is deleted).
+   *
+   * \return The result, already solved if the path was cached. Otherwise, it
+   * is solved (PathfindingResult::solved is true) after the next call to
+   * SolvePendingRequests.
+   */
+  std::shared_ptr<const PathfindingResult> RequestPath(
+      const PathfindingRequest& request);
+
+  /**
+   * \brief Solve the queued requests still used, using several threads.
+   */
+  void SolvePendingRequests();
+
+  /**
+   * \brief Return false if the result was solved and the obstacles changed
+   * since, in which case the path must be requested again.
+   */
+  bool IsUpToDate(const PathfindingResult& result);
+
+  /**
+   * \brief Return the number of different requests waiting to be solved.
+   */
+  std::size_t GetPendingRequestsCount() const;
+
+  /**
+   * \brief Change the number of threads used by SolvePendingRequests. 0 (the
+   * default) means the number of hardware threads.
+   */
+  void SetThreadsCount(std::size_t threadsCount_) {
+    threadsCount = threadsCount_;
+  }
+
+  /**
+   * \brief Change the maximum number of paths kept in the cache (256 by
+   * default). The least recently used paths are removed first.
+   */
+  void SetMaxCachedPathsCount(std::size_t count);
+
+  /**
+   * \brief Return the number of paths in the cache.
+   */
+  std::size_t GetCachedPathsCount() const { return cachedPaths.size(); }
+
+  /**
+   * \brief Remove all the paths from the cache.
+   */
+  void ClearCache();
+
+  /**
+   * \brief Return the number of requests which got a path already computed,
+   * or which were already queued by RequestPath.
+   */
+  std::size_t GetCacheHitsCount() const { return cacheHitsCount; }
+
+  /**
+   * \brief Return the number of path searches run.
+   */
+  std::size_t GetSearchesCount() const { return searchesCount; }
+
+ private:
+  /**
+   * \brief A path kept in the cache.
+   */
+  struct CachedPath {
+    std::shared_ptr<PathfindingResult> result;
+    std::uint64_t lastUse;  ///< The value of usesCount when last used.
+  };
+
+  /**
+   * \brief Return true if nothing but the pending requests uses the result.
+   */
+  static bool IsAbandoned(const std::shared_ptr<PathfindingResult>& result) {
+    return result.use_count() == 1;
+  }
+
+  /**
+   * \brief Update the index of the obstacles, and clear the cache if
+   * obstacles changed.
+   */
+  void UpdateObstacles();
+
+  /**
+   * \brief Return the cached path for the request (and mark it as the most
+   * recently used), or nullptr.
+   */
+  std::shared_ptr<PathfindingResult> GetCachedPath(
+      const PathfindingRequest& request);
+
+  /**
+   * \brief Add a solved path to the cache, removing the least recently used
+   * paths if necessary.
+   */
+  void CachePath(const PathfindingRequest& request,
+                 const std::shared_ptr<PathfindingResult>& result);
+
+  /**
+   * \brief Compute the path of a request.
+   * \note Only read the index of the obstacles, so that it can be called by
+   * several threads at once.
+   */
+  void Solve(const PathfindingRequest& request,
+             PathfindingResult& result) const;
+
+  ScenePathfindingObstaclesManager& obstacles;
+  std::size_t obstaclesVersion;  ///< The version of the obstacles for which the
+                                 ///< cached paths were computed.
+
+  std::map<PathfindingRequest, CachedPath> cachedPaths;
+  std::set<std::pair<std::uint64_t, PathfindingRequest> >
+      leastRecentlyUsedPaths;  ///< The last use and the request of the cached
+                               ///< paths, the least recently used first.
+  std::uint64_t usesCount;
+  std::size_t maxCachedPathsCount;
+
+  std::map<PathfindingRequest, std::shared_ptr<PathfindingResult> >
+      pendingRequests;  ///< The requests to be solved by SolvePendingRequests.
+  JobsPool jobsPool;
+  std::size_t threadsCount;
+
+  std::size_t cacheHitsCount;
+  std::size_t searchesCount;
+};
+
+#endif  // PATHFINDINGPATHSSERVICE_H
@@ -8,6 +8,7 @@ This project is released under the MIT License.
 #ifndef PATHFINDINGRUNTIMEBEHAVIOR_H
 #define PATHFINDINGRUNTIMEBEHAVIOR_H
 #include <SFML/System/Vector2.hpp>
+#include <memory>
 #include <vector>
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
@@ -17,6 +18,8 @@ class Layout;
 class RuntimeScene;
 class PlatformBehavior;
 class ScenePathfindingObstaclesManager;
+struct PathfindingRequest;
+struct PathfindingResult;
 namespace gd {
 class SerializerElement;
 }
@@ -36,6 +39,22 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
    */
   void MoveTo(RuntimeScene& scene, float x, float y);
 
+  /**
+   * \brief Queue the computation of the path to the specified destination.
+   *
+   * The paths requested by the objects of the scene are computed together, on
+   * several threads, and the object starts moving on its path the next time
+   * the behavior is stepped. Until then, the object keeps moving on its
+   * previous path.
+   */
+  void RequestMoveTo(RuntimeScene& scene, float x, float y);
+
+  /**
+   * \brief Return true if a path requested by RequestMoveTo is not yet
+   * followed by the object.
+   */
+  bool IsPathRequested() const { return requestedPath != nullptr; }
+
   // Path information:
   /**
    * \brief Return true if the latest call to MoveTo succeeded.
@@ -90,12 +109,23 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   virtual void DoStepPreEvents(RuntimeScene& scene);
   virtual void DoStepPostEvents(RuntimeScene& scene);
   void EnterSegment(std::size_t segmentNumber);
+  void UpdateSceneManager(RuntimeScene& scene);
+
+  /**
+   * \brief Return true if the destination is on the cell of the object, in
+   * which case the object moves directly to it.
+   */
+  bool IsOnDestinationCell(float x, float y) const;
+  PathfindingRequest GetPathRequest(float x, float y) const;
+  void FollowPath(const PathfindingResult& result);
 
   RuntimeScene* parentScene;  ///< The scene the object belongs to.
   ScenePathfindingObstaclesManager*
       sceneManager;  ///< The platform objects manager associated to the scene.
   std::vector<sf::Vector2f> path;  ///< The computed path
   bool pathFound;
+  std::shared_ptr<const PathfindingResult>
+      requestedPath;  ///< The path requested by RequestMoveTo, if any.
 
   // Behavior configuration:
   bool allowDiagonals;
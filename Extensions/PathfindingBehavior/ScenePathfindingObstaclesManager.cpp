@@ -6,6 +6,7 @@ This project is released under the MIT License.
 */
 #include "ScenePathfindingObstaclesManager.h"
 #include <iostream>
+#include "GDCpp/Runtime/RuntimeObject.h"
 #include "PathfindingObstacleRuntimeBehavior.h"
 
 std::map<RuntimeScene*, ScenePathfindingObstaclesManager>
@@ -27,4 +28,120 @@ void ScenePathfindingObstaclesManager::AddObstacle(
 void ScenePathfindingObstaclesManager::RemoveObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
   allObstacles.erase(obstacle);
+
+  auto indexed = indexedObstacles.find(obstacle);
+  if (indexed != indexedObstacles.end()) {
+    RemoveFromIndex(indexed->second);
+    indexedObstacles.erase(indexed);
+    obstaclesVersion++;
+  }
+}
+
+void ScenePathfindingObstaclesManager::UpdateObstaclesIndex() {
+  for (PathfindingObstacleRuntimeBehavior* obstacle : allObstacles) {
+    IndexedObstacle newIndexed = GetIndexedObstacle(obstacle);
+    auto indexed = indexedObstacles.find(obstacle);
+    if (indexed == indexedObstacles.end()) {
+      AddToIndex(newIndexed);
+      indexedObstacles[obstacle] = newIndexed;
+      obstaclesVersion++;
+      continue;
+    }
+
+    IndexedObstacle& oldIndexed = indexed->second;
+    const Bounds& oldBounds = oldIndexed.bounds;
+    const Bounds& bounds = newIndexed.bounds;
+    if (oldBounds.left == bounds.left && oldBounds.top == bounds.top &&
+        oldBounds.right == bounds.right && oldBounds.bottom == bounds.bottom &&
+        oldIndexed.impassable == newIndexed.impassable &&
+        oldIndexed.cost == newIndexed.cost)
+      continue;
+
+    RemoveFromIndex(oldIndexed);
+    AddToIndex(newIndexed);
+    oldIndexed = newIndexed;
+    obstaclesVersion++;
+  }
+}
+
+ScenePathfindingObstaclesManager::IndexedObstacle
+ScenePathfindingObstaclesManager::GetIndexedObstacle(
+    PathfindingObstacleRuntimeBehavior* obstacle) {
+  RuntimeObject* object = obstacle->GetObject();
+  IndexedObstacle indexed;
+  indexed.obstacle = obstacle;
+  indexed.bounds.left = object->GetDrawableX();
+  indexed.bounds.top = object->GetDrawableY();
+  indexed.bounds.right = indexed.bounds.left + object->GetWidth();
+  indexed.bounds.bottom = indexed.bounds.top + object->GetHeight();
+  indexed.impassable = obstacle->IsImpassable();
+  indexed.cost = obstacle->GetCost();
+  return indexed;
+}
+
+bool ScenePathfindingObstaclesManager::IsLarge(const Bounds& bounds) {
+  // Obstacles with non-finite bounds are not put in the buckets.
+  if (!std::isfinite(bounds.left) || !std::isfinite(bounds.top) ||
+      !std::isfinite(bounds.right) || !std::isfinite(bounds.bottom))
+    return true;
+
+  // Computed with floats to avoid overflows with huge obstacles.
+  float bucketsCount =
+      (float(GetBucketCoordinate(bounds.right)) -
+       GetBucketCoordinate(bounds.left) + 1) *
+      (float(GetBucketCoordinate(bounds.bottom)) -
+       GetBucketCoordinate(bounds.top) + 1);
+  return bucketsCount > MaxBucketsPerObstacle;
+}
+
+void ScenePathfindingObstaclesManager::AddToIndex(
+    const IndexedObstacle& indexed) {
+  const Bounds& bounds = indexed.bounds;
+  if (IsLarge(bounds)) {
+    largeObstacles.push_back(indexed);
+    return;
+  }
+
+  for (int x = GetBucketCoordinate(bounds.left);
+       x <= GetBucketCoordinate(bounds.right);
+       ++x) {
+    for (int y = GetBucketCoordinate(bounds.top);
+         y <= GetBucketCoordinate(bounds.bottom);
+         ++y)
+      buckets[GetBucketKey(x, y)].push_back(indexed);
+  }
+}
+
+void ScenePathfindingObstaclesManager::RemoveFromIndex(
+    const IndexedObstacle& indexed) {
+  PathfindingObstacleRuntimeBehavior* obstacle = indexed.obstacle;
+  const Bounds& bounds = indexed.bounds;
+  auto removeFrom = [obstacle](std::vector<IndexedObstacle>& list) {
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      if (list[i].obstacle == obstacle) {
+        list[i] = list.back();
+        list.pop_back();
+        return;
+      }
+    }
+  };
+
+  if (IsLarge(bounds)) {
+    removeFrom(largeObstacles);
+    return;
+  }
+
+  for (int x = GetBucketCoordinate(bounds.left);
+       x <= GetBucketCoordinate(bounds.right);
+       ++x) {
+    for (int y = GetBucketCoordinate(bounds.top);
+         y <= GetBucketCoordinate(bounds.bottom);
+         ++y) {
+      auto bucket = buckets.find(GetBucketKey(x, y));
+      if (bucket == buckets.end()) continue;
+
+      removeFrom(bucket->second);
+      if (bucket->second.empty()) buckets.erase(bucket);
+    }
+  }
 }
@@ -6,16 +6,26 @@ This project is released under the MIT License.
 */
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "PathfindingPathsService.h"
 class PathfindingObstacleRuntimeBehavior;
 
 /**
  * \brief Contains lists of all obstacle related objects of a scene.
  *
- * \note Could be drastically improved by using spatial hashing (see JS
- * implementation).
+ * The obstacles are also stored in a grid of buckets (a spatial hash), so that
+ * the obstacles covering a cell of a path can be found without iterating on
+ * all of them.
+ *
+ * The paths are computed by the PathfindingPathsService of the manager.
  */
 class ScenePathfindingObstaclesManager {
  public:
@@ -25,7 +35,42 @@ class ScenePathfindingObstaclesManager {
    */
   static std::map<RuntimeScene*, ScenePathfindingObstaclesManager> managers;
 
-  ScenePathfindingObstaclesManager(){};
+  /**
+   * \brief The size of the buckets of the spatial index, in pixels.
+   */
+  static const int BucketSize = 128;
+
+  /**
+   * \brief The maximum number of buckets covered by an obstacle. Larger
+   * obstacles are stored apart and checked by every query.
+   */
+  static const int MaxBucketsPerObstacle = 256;
+
+  /**
+   * \brief The bounding box of an obstacle.
+   */
+  struct Bounds {
+    float left;
+    float top;
+    float right;
+    float bottom;
+  };
+
+  /**
+   * \brief An obstacle, as it was when the index was last updated.
+   *
+   * Paths are computed from these copies only, so that they can be computed by
+   * other threads without reading the objects.
+   */
+  struct IndexedObstacle {
+    PathfindingObstacleRuntimeBehavior* obstacle;
+    Bounds bounds;
+    bool impassable;
+    float cost;
+  };
+
+  ScenePathfindingObstaclesManager()
+      : obstaclesVersion(0), pathsService(*this){};
   virtual ~ScenePathfindingObstaclesManager();
 
   /**
@@ -47,9 +92,111 @@ class ScenePathfindingObstaclesManager {
     return allObstacles;
   }
 
+  /**
+   * \brief Update the spatial index with the current position and size of the
+   * obstacles. Only the obstacles that moved or were resized are moved in the
+   * index.
+   *
+   * Must be called before ForEachObstacleInArea if obstacles may have changed.
+   */
+  void UpdateObstaclesIndex();
+
+  /**
+   * \brief Return a number incremented each time UpdateObstaclesIndex finds
+   * that an obstacle was added, removed, moved, resized or had its cost
+   * changed.
+   */
+  std::size_t GetObstaclesVersion() const { return obstaclesVersion; }
+
+  /**
+   * \brief Call \a func with the IndexedObstacle of each obstacle whose
+   * bounding box (as of the last call to UpdateObstaclesIndex) intersects the
+   * given area. Each obstacle is given only once.
+   */
+  template <typename Function>
+  void ForEachObstacleInArea(
+      float left, float top, float right, float bottom, Function func) const {
+    Bounds area = {left, top, right, bottom};
+    for (const IndexedObstacle& indexed : largeObstacles) {
+      if (Intersects(indexed.bounds, area)) func(indexed);
+    }
+    if (!(left <= right && top <= bottom)) return;  // Empty area, or NaN.
+
+    int minX = GetBucketCoordinate(left);
+    int minY = GetBucketCoordinate(top);
+    int maxX = GetBucketCoordinate(right);
+    int maxY = GetBucketCoordinate(bottom);
+    for (int x = minX; x <= maxX; ++x) {
+      for (int y = minY; y <= maxY; ++y) {
+        auto bucket = buckets.find(GetBucketKey(x, y));
+        if (bucket == buckets.end()) continue;
+
+        for (const IndexedObstacle& indexed : bucket->second) {
+          if (!Intersects(indexed.bounds, area)) continue;
+
+          // An obstacle is stored in all the buckets it covers: only give it
+          // for the bucket containing the top-left corner of its intersection
+          // with the area.
+          if (GetBucketCoordinate(std::max(left, indexed.bounds.left)) != x ||
+              GetBucketCoordinate(std::max(top, indexed.bounds.top)) != y)
+            continue;
+
+          func(indexed);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Return the service computing the paths avoiding the obstacles.
+   */
+  PathfindingPathsService& GetPathsService() { return pathsService; }
+
  private:
+  static bool Intersects(const Bounds& a, const Bounds& b) {
+    return a.left <= b.right && a.right >= b.left && a.top <= b.bottom &&
+           a.bottom >= b.top;
+  }
+
+  /**
+   * \brief Return the coordinate of the bucket containing the position.
+   *
+   * Positions far outside the grid are clamped, as converting them to an int
+   * would be undefined. The maximum is INT_MAX - 1, so that the loops on the
+   * buckets (`x <= max; ++x`) cannot overflow. NaN gives INT_MIN.
+   */
+  static int GetBucketCoordinate(float position) {
+    double coordinate = std::floor(position / BucketSize);
+    if (!(coordinate > std::numeric_limits<int>::min()))
+      return std::numeric_limits<int>::min();
+    if (coordinate >= std::numeric_limits<int>::max() - 1)
+      return std::numeric_limits<int>::max() - 1;
+
+    return static_cast<int>(coordinate);
+  }
+
+  static std::uint64_t GetBucketKey(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+           static_cast<std::uint32_t>(y);
+  }
+
+  static IndexedObstacle GetIndexedObstacle(
+      PathfindingObstacleRuntimeBehavior* obstacle);
+  static bool IsLarge(const Bounds& bounds);
+  void AddToIndex(const IndexedObstacle& indexed);
+  void RemoveFromIndex(const IndexedObstacle& indexed);
+
   std::set<PathfindingObstacleRuntimeBehavior*>
       allObstacles;  ///< The list of all obstacles of the scene.
+  std::unordered_map<PathfindingObstacleRuntimeBehavior*, IndexedObstacle>
+      indexedObstacles;  ///< The obstacles, as stored in the index.
+  std::unordered_map<std::uint64_t, std::vector<IndexedObstacle>>
+      buckets;  ///< The obstacles covering each bucket.
+  std::vector<IndexedObstacle>
+      largeObstacles;  ///< The obstacles covering too many buckets.
+  std::size_t obstaclesVersion;
+
+  PathfindingPathsService pathsService;
 };
 
 #endif
@@ -9,9 +9,13 @@ This project is released under the MIT License.
  */
 #define CATCH_CONFIG_MAIN
 #include "../PathfindingBehavior.h"
+#include <cmath>
+#include <limits>
 #include "../PathfindingObstacleBehavior.h"
 #include "../PathfindingObstacleRuntimeBehavior.h"
+#include "../PathfindingPathsService.h"
 #include "../PathfindingRuntimeBehavior.h"
+#include "../ScenePathfindingObstaclesManager.h"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
@@ -20,34 +24,9 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "PathfindingTestsTools.h"
 #include "catch.hpp"
 
-// Mock objects that can have a specific size
-class ResizableRuntimeObject : public RuntimeObject {
- public:
-  ResizableRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
-      : RuntimeObject(scene, obj) {}
-
-  float GetWidth() const override { return width; }
-  float GetHeight() const override { return height; }
-  void SetWidth(float newWidth) override { width = newWidth; }
-  void SetHeight(float newHeight) override { height = newHeight; }
-
- private:
-  float width;
-  float height;
-};
-
-namespace {
-template <class TRuntimeBehavior, class TBehavior>
-std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
-  gd::SerializerElement behaviorContent;
-  TBehavior behavior;
-  behavior.InitializeContent(behaviorContent);
-  return std::move(gd::make_unique<TRuntimeBehavior>(behaviorContent));
-};
-}  // namespace
-
 TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
   SECTION("Basics") {
     // Prepare some objects and the context
@@ -234,3 +213,231 @@ TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
     REQUIRE(runtimeBehavior->GetNodeY(4) == 80);
   }
 }
+
+TEST_CASE("ScenePathfindingObstaclesManager", "[game-engine][pathfinding]") {
+  RuntimeGame game;
+  gd::Object obstacleObj("obstacle");
+  RuntimeScene scene(NULL, &game);
+
+  auto addObstacle = [&](float x, float y, float width, float height) {
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(x);
+    obstacle->SetY(y);
+    obstacle->SetWidth(width);
+    obstacle->SetHeight(height);
+    return obstacle;
+  };
+  auto *smallObstacle = addObstacle(10, 10, 20, 20);
+  auto *mediumObstacle = addObstacle(100, 100, 300, 300);
+  auto *hugeObstacle = addObstacle(-5000, -5000, 10000, 10000);
+  auto *negativeObstacle = addObstacle(-300, -300, 20, 20);
+  scene.RenderAndStep();
+
+  ScenePathfindingObstaclesManager &manager =
+      ScenePathfindingObstaclesManager::managers[&scene];
+  auto getObstaclesInArea = [&](float left,
+                                float top,
+                                float right,
+                                float bottom) {
+    std::vector<RuntimeObject *> objects;
+    manager.ForEachObstacleInArea(
+        left,
+        top,
+        right,
+        bottom,
+        [&](const ScenePathfindingObstaclesManager::IndexedObstacle &indexed) {
+          objects.push_back(indexed.obstacle->GetObject());
+        });
+    return objects;
+  };
+  auto contains = [](const std::vector<RuntimeObject *> &objects,
+                     RuntimeObject *object) {
+    return std::count(objects.begin(), objects.end(), object);
+  };
+
+  manager.UpdateObstaclesIndex();
+  auto objects = getObstaclesInArea(0, 0, 1000, 1000);
+  REQUIRE(objects.size() == 3);  // Each obstacle is given once.
+  REQUIRE(contains(objects, smallObstacle) == 1);
+  REQUIRE(contains(objects, mediumObstacle) == 1);
+  REQUIRE(contains(objects, hugeObstacle) == 1);
+
+  objects = getObstaclesInArea(350, 350, 360, 360);
+  REQUIRE(objects.size() == 2);
+  REQUIRE(contains(objects, mediumObstacle) == 1);
+  REQUIRE(contains(objects, hugeObstacle) == 1);
+
+  REQUIRE(getObstaclesInArea(6000, 6000, 6100, 6100).size() == 0);
+
+  objects = getObstaclesInArea(-310, -310, -290, -290);
+  REQUIRE(objects.size() == 2);
+  REQUIRE(contains(objects, negativeObstacle) == 1);
+  REQUIRE(contains(objects, hugeObstacle) == 1);
+
+  // Move an obstacle: the index is updated.
+  smallObstacle->SetX(6050);
+  smallObstacle->SetY(6050);
+  manager.UpdateObstaclesIndex();
+  objects = getObstaclesInArea(6000, 6000, 6100, 6100);
+  REQUIRE(objects.size() == 1);
+  REQUIRE(contains(objects, smallObstacle) == 1);
+  REQUIRE(contains(getObstaclesInArea(0, 0, 50, 50), smallObstacle) == 0);
+
+  // Deactivate an obstacle: it is removed from the index.
+  mediumObstacle->GetBehaviorRawPointer("PathfindingObstacle")
+      ->Activate(false);
+  manager.UpdateObstaclesIndex();
+  REQUIRE(contains(getObstaclesInArea(0, 0, 1000, 1000), mediumObstacle) == 0);
+
+  // Positions outside of the grid of buckets, or not finite.
+  auto *farObstacle = addObstacle(1e12, -1e12, 20, 20);
+  auto *infiniteObstacle =
+      addObstacle(0, 0, std::numeric_limits<float>::infinity(), 20);
+  auto *nanObstacle = addObstacle(std::nan(""), 0, 20, 20);
+  scene.RenderAndStep();
+  manager.UpdateObstaclesIndex();
+  objects =
+      getObstaclesInArea(1e12 - 100, -1e12 - 100, 1e12 + 100, -1e12 + 100);
+  REQUIRE(objects.size() == 1);
+  REQUIRE(contains(objects, farObstacle) == 1);
+  objects = getObstaclesInArea(1e20, 0, 1e20 + 100, 10);
+  REQUIRE(objects.size() == 1);
+  REQUIRE(contains(objects, infiniteObstacle) == 1);
+  REQUIRE(contains(getObstaclesInArea(0, 0, 1000, 1000), nanObstacle) == 0);
+  REQUIRE(getObstaclesInArea(std::nan(""), 0, 100, 100).size() == 0);
+}
+
+TEST_CASE("PathfindingPathsService", "[game-engine][pathfinding]") {
+  RuntimeGame game;
+  gd::Object agentObj("agent");
+  gd::Object obstacleObj("obstacle");
+  RuntimeScene scene(NULL, &game);
+
+  auto *obstacle =
+      scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+          new ResizableRuntimeObject(scene, obstacleObj)));
+  obstacle->AddBehavior(
+      "PathfindingObstacle",
+      CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                               PathfindingObstacleBehavior>());
+  obstacle->SetX(300);
+  obstacle->SetY(600);
+  obstacle->SetWidth(600);
+  obstacle->SetHeight(32);
+
+  std::vector<PathfindingRuntimeBehavior *> behaviors;
+  for (std::size_t i = 0; i < 8; ++i) {
+    auto *agent = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, agentObj)));
+    agent->AddBehavior("Pathfinding",
+                       CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                PathfindingBehavior>());
+    agent->SetX(i % 2 == 0 ? 0 : 100);  // Two groups of agents.
+    auto *behavior = static_cast<PathfindingRuntimeBehavior *>(
+        agent->GetBehaviorRawPointer("Pathfinding"));
+    behavior->SetAcceleration(0);  // The agents don't move on their paths.
+    behavior->SetMaxSpeed(0);
+    behaviors.push_back(behavior);
+  }
+  scene.RenderAndStep();
+
+  PathfindingPathsService &service =
+      ScenePathfindingObstaclesManager::managers[&scene].GetPathsService();
+  service.ClearCache();
+  auto getPath = [](const PathfindingRuntimeBehavior &behavior) {
+    std::vector<sf::Vector2f> path;
+    for (std::size_t i = 0; i < behavior.GetNodeCount(); ++i)
+      path.push_back(sf::Vector2f(behavior.GetNodeX(i), behavior.GetNodeY(i)));
+    return path;
+  };
+
+  SECTION("Paths are cached") {
+    std::size_t searchesCount = service.GetSearchesCount();
+    behaviors[0]->MoveTo(scene, 1200, 1300);
+    REQUIRE(behaviors[0]->PathFound() == true);
+    REQUIRE(behaviors[0]->GetNodeCount() == 77);
+    REQUIRE(service.GetSearchesCount() == searchesCount + 1);
+
+    behaviors[2]->MoveTo(scene, 1200, 1300);
+    REQUIRE(service.GetSearchesCount() == searchesCount + 1);
+    REQUIRE(getPath(*behaviors[2]) == getPath(*behaviors[0]));
+
+    // Moving an obstacle clears the cache.
+    obstacle->SetX(0);
+    obstacle->SetWidth(1300);
+    behaviors[2]->MoveTo(scene, 1200, 1300);
+    REQUIRE(service.GetSearchesCount() == searchesCount + 2);
+    REQUIRE(behaviors[2]->GetNodeCount() == 92);
+  }
+  SECTION("Requests not used anymore are dropped") {
+    std::size_t searchesCount = service.GetSearchesCount();
+    behaviors[0]->RequestMoveTo(scene, 1200, 1300);
+    behaviors[0]->RequestMoveTo(scene, 1000, 1300);
+    REQUIRE(service.GetPendingRequestsCount() == 1);
+    behaviors[0]->MoveTo(scene, 20, 20);
+    REQUIRE(service.GetPendingRequestsCount() == 0);
+
+    scene.RenderAndStep();
+    REQUIRE(service.GetSearchesCount() == searchesCount + 1);
+    REQUIRE(behaviors[0]->GetNodeCount() == 2);
+
+    // A pending request solved by MoveTo is not a cache hit.
+    behaviors[0]->RequestMoveTo(scene, 1200, 1300);
+    std::size_t cacheHitsCount = service.GetCacheHitsCount();
+    behaviors[2]->MoveTo(scene, 1200, 1300);
+    REQUIRE(service.GetCacheHitsCount() == cacheHitsCount);
+    REQUIRE(service.GetSearchesCount() == searchesCount + 2);
+  }
+  SECTION("Cached paths are checked again before being followed") {
+    behaviors[0]->MoveTo(scene, 1200, 1300);
+    behaviors[2]->RequestMoveTo(scene, 1200, 1300);
+    REQUIRE(service.GetPendingRequestsCount() == 0);  // Found in the cache.
+
+    obstacle->SetX(0);
+    obstacle->SetWidth(1300);
+    scene.RenderAndStep();
+    REQUIRE(behaviors[2]->IsPathRequested() == false);
+    REQUIRE(behaviors[2]->GetNodeCount() == 92);
+  }
+  SECTION("Requests are deduplicated and solved before the next step") {
+    // Compute the expected paths synchronously, without the cache.
+    service.SetMaxCachedPathsCount(0);
+    behaviors[0]->MoveTo(scene, 1200, 1300);
+    behaviors[1]->MoveTo(scene, 1200, 1300);
+    std::vector<sf::Vector2f> expectedPath0 = getPath(*behaviors[0]);
+    std::vector<sf::Vector2f> expectedPath1 = getPath(*behaviors[1]);
+    REQUIRE(expectedPath0 != expectedPath1);
+    service.SetMaxCachedPathsCount(256);
+
+    for (std::size_t threadsCount : {1, 4}) {
+      service.ClearCache();
+      service.SetThreadsCount(threadsCount);
+      for (auto *behavior : behaviors) behavior->MoveTo(scene, 20, 20);
+
+      std::size_t searchesCount = service.GetSearchesCount();
+      for (auto *behavior : behaviors) {
+        behavior->RequestMoveTo(scene, 1200, 1300);
+        REQUIRE(behavior->IsPathRequested() == true);
+      }
+      REQUIRE(service.GetPendingRequestsCount() == 2);
+      // The agents follow their previous path until the next step.
+      REQUIRE(behaviors[0]->GetNodeCount() == 2);
+
+      scene.RenderAndStep();
+      REQUIRE(service.GetPendingRequestsCount() == 0);
+      REQUIRE(service.GetSearchesCount() == searchesCount + 2);
+      for (std::size_t i = 0; i < behaviors.size(); ++i) {
+        REQUIRE(behaviors[i]->IsPathRequested() == false);
+        REQUIRE(behaviors[i]->PathFound() == true);
+        REQUIRE(getPath(*behaviors[i]) ==
+                (i % 2 == 0 ? expectedPath0 : expectedPath1));
+      }
+    }
+  }
+}
@@ -0,0 +1,112 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Benchmarks of the computation of paths in a scene with many
+ * obstacles, one after the other or in a batch solved by several threads.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "../PathfindingBehavior.h"
+#include "../PathfindingObstacleBehavior.h"
+#include "../PathfindingObstacleRuntimeBehavior.h"
+#include "../PathfindingPathsService.h"
+#include "../PathfindingRuntimeBehavior.h"
+#include "../ScenePathfindingObstaclesManager.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "PathfindingTestsTools.h"
+#include "catch.hpp"
+
+TEST_CASE("PathfindingRuntimeBehavior - Benchmarks",
+          "[game-engine][pathfinding]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object agentObj("agent");
+  gd::Object obstacleObj("obstacle");
+
+  // 800 obstacles scattered in a 4000x4000 area, the agents moving across it.
+  const std::size_t obstaclesCount = 800;
+  const std::size_t agentsCount = 200;
+  unsigned int seed = 42;
+  auto random = [&seed](int max) {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<int>((seed >> 16) % max);
+  };
+  for (std::size_t i = 0; i < obstaclesCount; ++i) {
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(random(4000));
+    obstacle->SetY(random(4000));
+    obstacle->SetWidth(20 + random(60));
+    obstacle->SetHeight(20 + random(60));
+  }
+
+  std::vector<PathfindingRuntimeBehavior *> agents;
+  for (std::size_t i = 0; i < agentsCount; ++i) {
+    auto *agent = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, agentObj)));
+    agent->AddBehavior(
+        "Pathfinding",
+        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                 PathfindingBehavior>());
+    agent->SetX(random(4000));
+    agent->SetY(random(4000));
+    agents.push_back(static_cast<PathfindingRuntimeBehavior *>(
+        agent->GetBehaviorRawPointer("Pathfinding")));
+  }
+  scene.RenderAndStep();
+
+  std::vector<sf::Vector2f> destinations;
+  for (std::size_t i = 0; i < agentsCount; ++i)
+    destinations.push_back(sf::Vector2f(random(4000), random(4000)));
+
+  PathfindingPathsService &pathsService =
+      ScenePathfindingObstaclesManager::managers[&scene].GetPathsService();
+  auto doBenchmark = [&](const gd::String &name, std::function<void()> run) {
+    pathsService.ClearCache();
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+
+    std::size_t pathsFound = 0;
+    for (PathfindingRuntimeBehavior *agent : agents)
+      if (agent->PathFound()) pathsFound++;
+    std::cout << "Computing the paths of " << agentsCount << " agents among "
+              << obstaclesCount << " obstacles " << name << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds (" << pathsFound << " paths found)"
+              << std::endl;
+    REQUIRE(pathsFound > 0);
+  };
+
+  doBenchmark("one after the other", [&]() {
+    for (std::size_t i = 0; i < agentsCount; ++i)
+      agents[i]->MoveTo(scene, destinations[i].x, destinations[i].y);
+  });
+  doBenchmark("in a batch", [&]() {
+    for (std::size_t i = 0; i < agentsCount; ++i)
+      agents[i]->RequestMoveTo(scene, destinations[i].x, destinations[i].y);
+    pathsService.SolvePendingRequests();
+
+    // Follow the paths now (they are found in the cache).
+    for (std::size_t i = 0; i < agentsCount; ++i)
+      agents[i]->MoveTo(scene, destinations[i].x, destinations[i].y);
+  });
+}
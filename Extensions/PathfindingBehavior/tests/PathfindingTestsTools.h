@@ -0,0 +1,43 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Tools shared by the tests of the Pathfinding extension.
+ */
+#ifndef PATHFINDINGTESTSTOOLS_H
+#define PATHFINDINGTESTSTOOLS_H
+#include <memory>
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+
+// Mock objects that can have a specific size
+class ResizableRuntimeObject : public RuntimeObject {
+ public:
+  ResizableRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
+      : RuntimeObject(scene, obj) {}
+
+  float GetWidth() const override { return width; }
+  float GetHeight() const override { return height; }
+  void SetWidth(float newWidth) override { width = newWidth; }
+  void SetHeight(float newHeight) override { height = newHeight; }
+
+ private:
+  float width;
+  float height;
+};
+
+template <class TRuntimeBehavior, class TBehavior>
+std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
+  gd::SerializerElement behaviorContent;
+  TBehavior behavior;
+  behavior.InitializeContent(behaviorContent);
+  return gd::make_unique<TRuntimeBehavior>(behaviorContent);
+};
+
+#endif  // PATHFINDINGTESTSTOOLS_H
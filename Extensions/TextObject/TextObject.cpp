@@ -10,7 +10,6 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/FontManager.h"
 #include "GDCpp/Runtime/ImageManager.h"
-#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/Project/InitialInstance.h"
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
@@ -109,19 +108,6 @@ void RuntimeTextObject::OnPositionChanged() {
   text.setPosition(GetX() + text.getOrigin().x, GetY() + text.getOrigin().y);
 }
 
-/**
- * RuntimeTextObject provides a basic bounding box.
- */
-std::vector<Polygon2d> RuntimeTextObject::GetHitBoxes() const {
-  std::vector<Polygon2d> mask;
-  Polygon2d rectangle = Polygon2d::CreateRectangle(GetWidth(), GetHeight());
-  rectangle.Rotate(GetAngle() / 180 * 3.14159);
-  rectangle.Move(GetX() + GetCenterX(), GetY() + GetCenterY());
-
-  mask.push_back(rectangle);
-  return mask;
-}
-
 /**
  * Get the real X position of the sprite
  */
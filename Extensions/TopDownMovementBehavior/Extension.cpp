@@ -492,6 +492,8 @@ class TopDownMovementBehaviorCppExtension : public ExtensionBase {
     AddRuntimeBehavior<TopDownMovementRuntimeBehavior>(
         GetBehaviorMetadata("TopDownMovementBehavior::TopDownMovementBehavior"),
         "TopDownMovementRuntimeBehavior");
+    GetBehaviorMetadata("TopDownMovementBehavior::TopDownMovementBehavior")
+        .SetObjectLocal();
     GetBehaviorMetadata("TopDownMovementBehavior::TopDownMovementBehavior")
         .SetIncludeFile("TopDownMovementBehavior/TopDownMovementRuntimeBehavior.h");
 
@@ -88,9 +88,9 @@ gd::String EventsCodeGenerator::GenerateObjectBehaviorFunctionCall(
              codeInfo.functionCallName + "(" + parametersStr + "))";
     else
       return "(static_cast<" + autoInfo.className + "*>(" +
-             ManObjListName(objectListName) + "[i]->GetBehaviorRawPointer(\"" +
-             behaviorName + "\"))->" + codeInfo.functionCallName + "(" +
-             parametersStr + "))";
+             ManObjListName(objectListName) + "[i]->GetBehaviorRawPointer(" +
+             GenerateGetBehaviorNameCode(behaviorName) + "))->" +
+             codeInfo.functionCallName + "(" + parametersStr + "))";
   } else {
     if (!castNeeded)
       return "(( " + ManObjListName(objectListName) + ".empty() ) ? " +
@@ -374,7 +374,7 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(
 gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
     const gd::String& behaviorName) {
   if (HasProjectAndLayout()) {
-    return ConvertToStringExplicit(behaviorName);
+    return GenerateNameIdCode(behaviorName);
   } else {
     // No support for events function in C++ generated code.
     // See GDJS for an example of proper implementation.
@@ -382,6 +382,28 @@ gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
   }
 }
 
+gd::String EventsCodeGenerator::GenerateGetObjectNameCode(
+    const gd::String& objectName) {
+  return GenerateNameIdCode(objectName);
+}
+
+gd::String EventsCodeGenerator::GenerateNameIdCode(const gd::String& name) {
+  auto it = namesIdsVariables.find(name);
+  if (it != namesIdsVariables.end()) return it->second;
+
+  // Names are interned once, when the generated code is loaded, so that
+  // objects and behaviors can be found without comparing strings.
+  gd::String variableName =
+      "GDNameId" + gd::String::From(namesIdsVariables.size());
+  AddIncludeFile("GDCpp/Runtime/NamesTable.h");
+  AddCustomCodeOutsideMain("static const std::size_t " + variableName +
+                           " = NamesTable::GetId(" +
+                           ConvertToStringExplicit(name) + ");\n");
+
+  namesIdsVariables[name] = variableName;
+  return variableName;
+}
+
 gd::String EventsCodeGenerator::GenerateObject(
     const gd::String& objectName,
     const gd::String& type,
@@ -8,6 +8,7 @@
 
 #ifndef EventsCodeGenerator_H
 #define EventsCodeGenerator_H
+#include <map>
 #include <string>
 #include <vector>
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
@@ -156,11 +157,27 @@ class GD_API EventsCodeGenerator : public gd::EventsCodeGenerator {
 
   virtual gd::String GenerateGetBehaviorNameCode(const gd::String& behaviorName);
 
+  virtual gd::String GenerateGetObjectNameCode(const gd::String& objectName);
+
+  /**
+   * \brief Generate the code of a variable containing the identifier of the
+   * specified name (see NamesTable).
+   *
+   * The variable is declared, and the name interned, the first time the
+   * generated code is loaded.
+   */
+  gd::String GenerateNameIdCode(const gd::String& name);
+
   /**
    * \brief Construct a code generator for the specified project and layout.
    */
   EventsCodeGenerator(gd::Project& project, const gd::Layout& layout);
   virtual ~EventsCodeGenerator();
+
+ private:
+  std::map<gd::String, gd::String>
+      namesIdsVariables;  ///< The variables declared by GenerateNameIdCode,
+                          ///< for each name.
 };
 
 #endif  // EventsCodeGenerator_H
@@ -11,6 +11,7 @@
 #if defined(GD_IDE_ONLY)
 #include "GDCore/Events/Builtin/CommentEvent.h"
 #include "GDCore/Events/Builtin/ForEachEvent.h"
+#include "GDCore/Events/Builtin/GroupEvent.h"
 #include "GDCore/Events/Builtin/LinkEvent.h"
 #include "GDCore/Events/Builtin/RepeatEvent.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
@@ -562,11 +563,21 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
       });
 
   GetAllEvents()["BuiltinCommonInstructions::Group"].SetCodeGenerator(
-      [](gd::BaseEvent& event,
+      [](gd::BaseEvent& event_,
          gd::EventsCodeGenerator& codeGenerator,
          gd::EventsCodeGenerationContext& context) {
-        return codeGenerator.GenerateEventsListCode(event.GetSubEvents(),
-                                                    context);
+        gd::GroupEvent& event = dynamic_cast<gd::GroupEvent&>(event_);
+
+        // Time the events of the group (when FrameProfiler is enabled).
+        codeGenerator.AddIncludeFile("GDCpp/Runtime/FrameProfiler.h");
+        gd::String groupName =
+            event.GetName().empty() ? "Events group" : event.GetName();
+
+        return "{\nGD_PROFILE_SCOPE(\"" +
+               codeGenerator.ConvertToString(groupName) + "\");\n" +
+               codeGenerator.GenerateEventsListCode(event.GetSubEvents(),
+                                                    context) +
+               "}\n";
       });
 
   AddEvent("CppCode",
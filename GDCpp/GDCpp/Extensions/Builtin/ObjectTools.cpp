@@ -34,10 +34,13 @@ bool GD_API HitBoxesCollision(
     bool conditionInverted,
     RuntimeScene & /*scene*/,
     bool ignoreTouchingEdges) {
-  return TwoObjectListsTest(
+  // Objects with bounding circles too far from each other are never colliding,
+  // so the broadphase can be used.
+  return TwoObjectListsTestWithBroadphase(
       objectsLists1,
       objectsLists2,
       conditionInverted,
+      0,
       [ignoreTouchingEdges](RuntimeObject *obj1, RuntimeObject *obj2) {
         return obj1->IsCollidingWith(obj2, ignoreTouchingEdges);
       });
@@ -70,11 +73,13 @@ float GD_API DistanceBetweenObjects(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
     float length,
     bool conditionInverted) {
+  float maxDistance = std::abs(length);
   length *= length;
-  return TwoObjectListsTest(
+  return TwoObjectListsTestWithBroadphase(
       objectsLists1,
       objectsLists2,
       conditionInverted,
+      maxDistance,
       [length](RuntimeObject *obj1, RuntimeObject *obj2) {
         float X = obj1->GetDrawableX() + obj1->GetCenterX() -
                   (obj2->GetDrawableX() + obj2->GetCenterX());
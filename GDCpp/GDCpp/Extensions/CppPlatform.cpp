@@ -115,6 +115,10 @@ bool CppPlatform::AddExtension(
         extension->GetRuntimeBehaviorCreationFunctionPtr(behaviorType);
     behaviorsRuntimeSharedDataCreationFunctionTable[behaviorType] =
         extension->GetBehaviorsRuntimeSharedDataFunctionPtr(behaviorType);
+    if (extension->GetBehaviorMetadata(behaviorType).IsObjectLocal())
+      objectLocalBehaviorsTypes.insert(behaviorType);
+    else
+      objectLocalBehaviorsTypes.erase(behaviorType);
   }
   return true;
 }
@@ -153,7 +157,13 @@ std::unique_ptr<RuntimeBehavior> CppPlatform::CreateRuntimeBehavior(
   }
 
   // Create a new behavior with the type we want.
-  return runtimeBehaviorCreationFunctionTable[type](behaviorContent);
+  std::unique_ptr<RuntimeBehavior> behavior =
+      runtimeBehaviorCreationFunctionTable[type](behaviorContent);
+  if (behavior)
+    behavior->SetObjectLocal(objectLocalBehaviorsTypes.find(type) !=
+                             objectLocalBehaviorsTypes.end());
+
+  return behavior;
 }
 
 std::unique_ptr<BehaviorsRuntimeSharedData>
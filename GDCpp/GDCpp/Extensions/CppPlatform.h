@@ -6,6 +6,7 @@
 
 #ifndef PLATFORM_H
 #define PLATFORM_H
+#include <set>
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/Tools/Localization.h"
@@ -137,6 +138,9 @@ class GD_API CppPlatform : public gd::Platform {
                                                         ///< functions to create
                                                         ///< runtime behaviors
                                                         ///< shared data.
+  std::set<gd::String>
+      objectLocalBehaviorsTypes;  ///< The behaviors declared as object-local
+                                  ///< in their metadata.
 
   static CppPlatform* singleton;
 };
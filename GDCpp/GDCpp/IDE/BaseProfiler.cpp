@@ -23,6 +23,7 @@ BaseProfiler::BaseProfiler()
       lastRenderingTime(0),
       totalSceneTime(0),
       totalEventsTime(0),
+      lastFrameAllocationsCount(0),
       stepTime(50) {
   // ctor
 }
@@ -39,6 +40,7 @@ void BaseProfiler::Reset() {
   lastRenderingTime = 0;
   totalSceneTime = 0;
   totalEventsTime = 0;
+  lastFrameAllocationsCount = 0;
 
   for (std::size_t i = 0; i < profileEventsInformation.size(); ++i) {
     profileEventsInformation[i].time = 0;
@@ -0,0 +1,21 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/AllocationsCounter.h"
+#include <atomic>
+
+namespace {
+// Zero-initialized before any dynamic initialization, so allocations made
+// before main are counted too.
+std::atomic<std::size_t> allocationsCount(0);
+}  // namespace
+
+void AllocationsCounter::Increment() {
+  allocationsCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t AllocationsCounter::GetCount() {
+  return allocationsCount.load(std::memory_order_relaxed);
+}
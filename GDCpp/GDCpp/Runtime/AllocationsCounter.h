@@ -0,0 +1,36 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef ALLOCATIONSCOUNTER_H
+#define ALLOCATIONSCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * \brief Count the heap allocations made by the game, to check that a frame
+ * is not allocating memory.
+ *
+ * The game engine does not replace the global allocation functions: an
+ * executable wanting to count allocations (like the tests) must replace
+ * `operator new` and call AllocationsCounter::Increment from it. Otherwise,
+ * the count stays 0.
+ *
+ * \see BaseProfiler::lastFrameAllocationsCount
+ * \ingroup GameEngine
+ */
+class GD_API AllocationsCounter {
+ public:
+  /**
+   * \brief Register a new allocation. Can be called from any thread.
+   */
+  static void Increment();
+
+  /**
+   * \brief Return the number of allocations made since the start of the game.
+   */
+  static std::size_t GetCount();
+};
+
+#endif  // ALLOCATIONSCOUNTER_H
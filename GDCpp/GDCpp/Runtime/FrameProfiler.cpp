@@ -0,0 +1,217 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include "GDCore/Tools/FileStream.h"
+#include "GDCpp/Runtime/NamesTable.h"
+
+namespace {
+struct ProfilerState {
+  ProfilerState() : enabled(false), threadsCount(0) {
+    Reset(120);
+  }
+
+  /**
+   * Remove all the frames and start recording a new one.
+   */
+  void Reset(std::size_t maximumFramesCount) {
+    // One more frame than the maximum, for the frame being recorded.
+    frames.clear();
+    frames.resize(maximumFramesCount + 1);
+    currentFrame = 0;
+    completeFramesCount = 0;
+    frames[0].number = 0;
+    frames[0].start = FrameProfiler::GetTime();
+  }
+
+  std::atomic<bool> enabled;
+  std::atomic<std::size_t> threadsCount;
+
+  std::mutex framesMutex;  ///< Protect the frame being recorded.
+  std::vector<FrameProfiler::Frame> frames;  ///< The ring buffer of frames.
+  std::size_t currentFrame;         ///< The index of the frame being recorded.
+  std::size_t completeFramesCount;  ///< The number of frames before it.
+};
+
+ProfilerState& GetState() {
+  static ProfilerState state;
+  return state;
+}
+
+std::size_t GetThreadIndex() {
+  thread_local std::size_t threadIndex = GetState().threadsCount++;
+  return threadIndex;
+}
+
+void WriteJsonString(std::ostream& output, const char* str) {
+  output << '"';
+  for (const char* c = str; *c; ++c) {
+    if (*c == '"' || *c == '\\')
+      output << '\\' << *c;
+    else if (static_cast<unsigned char>(*c) < 0x20)
+      output << ' ';  // Control characters are not useful in a trace.
+    else
+      output << *c;
+  }
+  output << '"';
+}
+
+void WriteEvent(std::ostream& output, const FrameProfiler::Event& event) {
+  output << "{\"name\":";
+  WriteJsonString(output, event.GetName());
+  output << ",\"ph\":\"X\",\"ts\":" << event.start
+         << ",\"dur\":" << event.duration
+         << ",\"pid\":0,\"tid\":" << event.threadIndex << "}";
+}
+
+void WriteCounter(std::ostream& output,
+                  const FrameProfiler::Counter& counter,
+                  std::int64_t time) {
+  output << "{\"name\":";
+  WriteJsonString(output, counter.name);
+  output << ",\"ph\":\"C\",\"ts\":" << time
+         << ",\"pid\":0,\"args\":{\"value\":" << counter.value << "}}";
+}
+}  // namespace
+
+const char* FrameProfiler::Event::GetName() const {
+  return name ? name : NamesTable::GetName(nameId).c_str();
+}
+
+void FrameProfiler::SetEnabled(bool enable) {
+  ProfilerState& state = GetState();
+  if (enable && !state.enabled) state.Reset(state.frames.size() - 1);
+
+  state.enabled = enable;
+}
+
+bool FrameProfiler::IsEnabled() {
+  return GetState().enabled.load(std::memory_order_relaxed);
+}
+
+void FrameProfiler::SetMaximumFramesCount(std::size_t count) {
+  GetState().Reset(count);
+}
+
+void FrameProfiler::EndFrame() {
+  ProfilerState& state = GetState();
+  if (!state.enabled) return;
+
+  std::int64_t time = GetTime();
+  std::lock_guard<std::mutex> lock(state.framesMutex);
+  Frame& frame = state.frames[state.currentFrame];
+  frame.end = time;
+
+  Event frameEvent;
+  frameEvent.name = "Frame";
+  frameEvent.nameId = 0;
+  frameEvent.start = frame.start;
+  frameEvent.duration = frame.end - frame.start;
+  frameEvent.threadIndex = GetThreadIndex();
+  frame.events.push_back(frameEvent);
+
+  state.currentFrame = (state.currentFrame + 1) % state.frames.size();
+  if (state.completeFramesCount < state.frames.size() - 1)
+    state.completeFramesCount++;
+
+  // Reuse the memory of the oldest frame for the new one.
+  Frame& newFrame = state.frames[state.currentFrame];
+  newFrame.number = frame.number + 1;
+  newFrame.start = time;
+  newFrame.events.clear();
+  newFrame.counters.clear();
+}
+
+std::size_t FrameProfiler::GetFramesCount() {
+  return GetState().completeFramesCount;
+}
+
+const FrameProfiler::Frame& FrameProfiler::GetFrame(std::size_t index) {
+  ProfilerState& state = GetState();
+  std::size_t framesCount = state.frames.size();
+  return state.frames[(state.currentFrame + framesCount -
+                       state.completeFramesCount + index) %
+                      framesCount];
+}
+
+void FrameProfiler::ExportChromeTrace(std::ostream& output) {
+  output << "{\"traceEvents\":[";
+  bool first = true;
+  for (std::size_t i = 0; i < GetFramesCount(); ++i) {
+    const Frame& frame = GetFrame(i);
+    for (const Event& event : frame.events) {
+      if (!first) output << ",";
+      output << "\n";
+      WriteEvent(output, event);
+      first = false;
+    }
+    for (const Counter& counter : frame.counters) {
+      if (!first) output << ",";
+      output << "\n";
+      WriteCounter(output, counter, frame.end);
+      first = false;
+    }
+  }
+  output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool FrameProfiler::ExportChromeTrace(const gd::String& filename) {
+  gd::FileStream file(filename, std::ios_base::out);
+  if (!file.is_open()) return false;
+
+  ExportChromeTrace(file);
+  return true;
+}
+
+std::int64_t FrameProfiler::GetTime() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void FrameProfiler::AddEvent(const char* name,
+                             std::size_t nameId,
+                             std::int64_t start,
+                             std::int64_t end) {
+  Event event;
+  event.name = name;
+  event.nameId = nameId;
+  event.start = start;
+  event.duration = end - start;
+  event.threadIndex = GetThreadIndex();
+
+  ProfilerState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.framesMutex);
+  state.frames[state.currentFrame].events.push_back(event);
+}
+
+void FrameProfiler::SetCounter(const char* name, std::int64_t value) {
+  ProfilerState& state = GetState();
+  if (!state.enabled) return;
+
+  std::lock_guard<std::mutex> lock(state.framesMutex);
+  std::vector<Counter>& counters = state.frames[state.currentFrame].counters;
+  for (Counter& counter : counters) {
+    if (counter.name == name) {
+      counter.value = value;
+      return;
+    }
+  }
+
+  Counter counter;
+  counter.name = name;
+  counter.value = value;
+  counters.push_back(counter);
+}
+
+std::int64_t ProfileScope::Start(const gd::String& name_) {
+  nameId = NamesTable::GetId(name_);
+  return FrameProfiler::GetTime();
+}
@@ -0,0 +1,198 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief Record the time spent in the scopes of the game engine (events,
+ * behaviors, rendering of each layer, extensions, resources loading...) during
+ * the last frames, so that they can be exported and opened in a trace viewer.
+ *
+ * Scopes are timed using GD_PROFILE_SCOPE. The profiler is disabled by
+ * default: scopes then only cost a check of FrameProfiler::IsEnabled.
+ *
+ * The frames are kept in a ring buffer: when it is full, the oldest frame is
+ * replaced by the new one.
+ *
+ * \note Scopes can be recorded by any thread, but the other methods must be
+ * called by the main thread, when no jobs are running.
+ *
+ * \see ProfileScope
+ * \ingroup GameEngine
+ */
+class GD_API FrameProfiler {
+ public:
+  /**
+   * \brief A timed scope.
+   */
+  struct Event {
+    const char* name;    ///< The name of the scope, or nullptr if nameId is
+                         ///< used.
+    std::size_t nameId;  ///< The identifier of the name of the scope (see
+                         ///< NamesTable), used if name is nullptr.
+    std::int64_t start;  ///< The start of the scope, in microseconds.
+    std::int64_t duration;    ///< The duration of the scope, in microseconds.
+    std::size_t threadIndex;  ///< A small number identifying the thread.
+
+    /**
+     * \brief Return the name of the scope.
+     */
+    const char* GetName() const;
+  };
+
+  /**
+   * \brief The value of a counter (memory used, cache hits...) at the end of
+   * a frame.
+   */
+  struct Counter {
+    const char* name;  ///< The name of the counter.
+    std::int64_t value;
+  };
+
+  /**
+   * \brief The scopes recorded during a frame.
+   */
+  struct Frame {
+    std::size_t number;  ///< The number of the frame since the profiler was
+                         ///< enabled.
+    std::int64_t start;  ///< The start of the frame, in microseconds.
+    std::int64_t end;    ///< The end of the frame, in microseconds.
+    std::vector<Event> events;  ///< The scopes, in the order they ended. The
+                                ///< last one is the frame itself.
+    std::vector<Counter> counters;  ///< The counters set during the frame.
+  };
+
+  /**
+   * \brief Enable or disable the profiler. Frames already recorded are
+   * removed when the profiler is enabled.
+   */
+  static void SetEnabled(bool enable = true);
+
+  /**
+   * \brief Return true if the profiler is recording scopes.
+   */
+  static bool IsEnabled();
+
+  /**
+   * \brief Change the number of frames kept by the profiler (120 by
+   * default). Frames already recorded are removed.
+   */
+  static void SetMaximumFramesCount(std::size_t count);
+
+  /**
+   * \brief Mark the end of the current frame: the next scopes are recorded in
+   * a new frame. Called by RuntimeScene::RenderAndStep.
+   */
+  static void EndFrame();
+
+  /**
+   * \brief Return the number of complete frames kept by the profiler.
+   */
+  static std::size_t GetFramesCount();
+
+  /**
+   * \brief Return a complete frame, 0 being the oldest one.
+   */
+  static const Frame& GetFrame(std::size_t index);
+
+  /**
+   * \brief Set the value of a counter for the current frame, replacing the
+   * value set previously during the frame if any.
+   *
+   * \param name The name of the counter, that must stay valid for the whole
+   * game (usually a string literal).
+   * \note Nothing is recorded if the profiler is disabled.
+   */
+  static void SetCounter(const char* name, std::int64_t value);
+
+  /**
+   * \brief Write the complete frames in the Chrome trace event JSON format,
+   * that can be opened by chrome://tracing or other trace viewers.
+   */
+  static void ExportChromeTrace(std::ostream& output);
+
+  /**
+   * \brief Write the complete frames in the Chrome trace event JSON format in
+   * the specified file.
+   * \return true if the file was written.
+   */
+  static bool ExportChromeTrace(const gd::String& filename);
+
+  /**
+   * \brief Return the current time, in microseconds, as used for the scopes.
+   */
+  static std::int64_t GetTime();
+
+  /**
+   * \brief Record a scope in the current frame. Can be called from any
+   * thread.
+   */
+  static void AddEvent(const char* name,
+                       std::size_t nameId,
+                       std::int64_t start,
+                       std::int64_t end);
+};
+
+/**
+ * \brief Time the scope in which it is declared, if FrameProfiler is enabled.
+ * Use GD_PROFILE_SCOPE to declare one.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API ProfileScope {
+ public:
+  /**
+   * \brief Start timing a scope with a name that must stay valid for the
+   * whole game (usually a string literal).
+   */
+  ProfileScope(const char* name_)
+      : name(name_),
+        nameId(0),
+        start(FrameProfiler::IsEnabled() ? FrameProfiler::GetTime() : -1){};
+
+  /**
+   * \brief Start timing a scope with a name that can be changed or destroyed
+   * later (a layer or an extension name). The name is interned in NamesTable.
+   * \warning Only usable by the main thread (see NamesTable).
+   */
+  ProfileScope(const gd::String& name_)
+      : name(nullptr),
+        nameId(0),
+        start(FrameProfiler::IsEnabled() ? Start(name_) : -1){};
+
+  ~ProfileScope() {
+    if (start >= 0)
+      FrameProfiler::AddEvent(name, nameId, start, FrameProfiler::GetTime());
+  }
+
+ private:
+  std::int64_t Start(const gd::String& name_);
+
+  const char* name;
+  std::size_t nameId;
+  std::int64_t start;  ///< The start of the scope, or -1 if not timed.
+};
+
+#if !defined(GD_NO_FRAME_PROFILER)
+#define GD_PROFILE_SCOPE_CONCAT2(a, b) a##b
+#define GD_PROFILE_SCOPE_CONCAT(a, b) GD_PROFILE_SCOPE_CONCAT2(a, b)
+/**
+ * \brief Time the current scope with the specified name (see ProfileScope).
+ * Define GD_NO_FRAME_PROFILER to remove all the scopes from the build.
+ */
+#define GD_PROFILE_SCOPE(name) \
+  ::ProfileScope GD_PROFILE_SCOPE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define GD_PROFILE_SCOPE(name)
+#endif
+
+#endif  // FRAMEPROFILER_H
@@ -0,0 +1,151 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/JobsPool.h"
+#include <algorithm>
+
+JobsPool::JobsPool(std::size_t threadsCount)
+    : chunksRanges(new ChunksRange[1]),
+      jobIndex(0),
+      finishedWorkersCount(0),
+      stopping(false),
+      jobFunction(nullptr),
+      jobFunctionData(nullptr),
+      jobCount(0),
+      jobChunkSize(1) {
+  chunksRanges[0].front = chunksRanges[0].back = 0;
+  SetThreadsCount(threadsCount);
+}
+
+JobsPool::~JobsPool() { StopWorkers(); }
+
+std::size_t JobsPool::GetHardwareThreadsCount() {
+#if defined(EMSCRIPTEN)
+  return 1;
+#else
+  return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+void JobsPool::SetThreadsCount(std::size_t threadsCount) {
+  if (threadsCount == 0) threadsCount = GetHardwareThreadsCount();
+#if defined(EMSCRIPTEN)
+  threadsCount = 1;
+#endif
+  if (threadsCount == GetThreadsCount()) return;
+
+  StopWorkers();
+  chunksRanges.reset(new ChunksRange[threadsCount]);
+  for (std::size_t i = 0; i < threadsCount; ++i)
+    chunksRanges[i].front = chunksRanges[i].back = 0;
+
+  stopping = false;
+  finishedWorkersCount = 0;
+  for (std::size_t i = 1; i < threadsCount; ++i)
+    workers.emplace_back(&JobsPool::WorkerLoop, this, i, jobIndex);
+}
+
+void JobsPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  jobStarted.notify_all();
+  for (auto& worker : workers) worker.join();
+  workers.clear();
+}
+
+void JobsPool::RunJob(std::size_t count,
+                      std::size_t chunkSize,
+                      JobFunction function,
+                      void* functionData) {
+  if (count == 0) return;
+  if (chunkSize == 0) chunkSize = 1;
+
+  std::size_t chunksCount = (count + chunkSize - 1) / chunkSize;
+  if (workers.empty() || chunksCount == 1) {
+    for (std::size_t begin = 0; begin < count; begin += chunkSize)
+      function(functionData, begin, std::min(count, begin + chunkSize));
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobFunction = function;
+    jobFunctionData = functionData;
+    jobCount = count;
+    jobChunkSize = chunkSize;
+
+    // Give each thread a contiguous range of chunks.
+    std::size_t threadsCount = GetThreadsCount();
+    for (std::size_t i = 0; i < threadsCount; ++i) {
+      std::lock_guard<std::mutex> rangeLock(chunksRanges[i].mutex);
+      chunksRanges[i].front = chunksCount * i / threadsCount;
+      chunksRanges[i].back = chunksCount * (i + 1) / threadsCount;
+    }
+
+    finishedWorkersCount = 0;
+    ++jobIndex;
+  }
+  jobStarted.notify_all();
+
+  RunChunks(0);
+
+  // Wait for all the workers, even the ones that had nothing to do, so that
+  // none of them is still using the job when this function returns.
+  std::unique_lock<std::mutex> lock(mutex);
+  jobFinished.wait(lock,
+                   [this]() { return finishedWorkersCount == workers.size(); });
+}
+
+void JobsPool::RunChunks(std::size_t threadIndex) {
+  std::size_t chunk;
+  while (TakeChunk(threadIndex, chunk)) {
+    std::size_t begin = chunk * jobChunkSize;
+    jobFunction(
+        jobFunctionData, begin, std::min(jobCount, begin + jobChunkSize));
+  }
+}
+
+bool JobsPool::TakeChunk(std::size_t threadIndex, std::size_t& chunk) {
+  {
+    ChunksRange& range = chunksRanges[threadIndex];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.front < range.back) {
+      chunk = range.front++;
+      return true;
+    }
+  }
+
+  // No more chunks for this thread: steal one from the others.
+  std::size_t threadsCount = GetThreadsCount();
+  for (std::size_t i = 1; i < threadsCount; ++i) {
+    ChunksRange& range = chunksRanges[(threadIndex + i) % threadsCount];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.front < range.back) {
+      chunk = --range.back;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void JobsPool::WorkerLoop(std::size_t threadIndex, std::size_t lastJobIndex) {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    jobStarted.wait(
+        lock, [&]() { return stopping || jobIndex != lastJobIndex; });
+    if (stopping) return;
+    lastJobIndex = jobIndex;
+
+    lock.unlock();
+    RunChunks(threadIndex);
+    lock.lock();
+
+    ++finishedWorkersCount;
+    if (finishedWorkersCount == workers.size()) jobFinished.notify_all();
+  }
+}
@@ -0,0 +1,122 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef JOBSPOOL_H
+#define JOBSPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief A pool of worker threads used to split a loop in chunks run in
+ * parallel.
+ *
+ * Each thread taking part to a job (the workers and the thread calling
+ * ParallelFor) is given a contiguous range of chunks. When a thread has run
+ * all its chunks, it steals the last chunks of the other threads, so that a
+ * thread with expensive chunks does not slow down the whole job.
+ *
+ * Running a job does not allocate memory. With one thread (the default), no
+ * worker is created and the chunks are run by the calling thread, in order.
+ *
+ * \note ParallelFor must not be called from a job, nor from several threads
+ * at the same time.
+ *
+ * \see RuntimeScene::SetBehaviorsThreadsCount
+ * \ingroup GameEngine
+ */
+class GD_API JobsPool {
+ public:
+  /**
+   * \brief Create a pool using \a threadsCount threads, including the thread
+   * calling ParallelFor.
+   */
+  JobsPool(std::size_t threadsCount = 1);
+  virtual ~JobsPool();
+
+  /**
+   * \brief Change the number of threads used to run the jobs, including the
+   * thread calling ParallelFor.
+   *
+   * 0 means the number of hardware threads. On platforms without threads
+   * support, the pool always uses only one thread.
+   */
+  void SetThreadsCount(std::size_t threadsCount);
+
+  /**
+   * \brief Return the number of threads used to run the jobs, including the
+   * thread calling ParallelFor.
+   */
+  std::size_t GetThreadsCount() const { return workers.size() + 1; }
+
+  /**
+   * \brief Call \a func(begin, end) for each chunk of at most \a chunkSize
+   * indices in [0, count), and return when all the chunks were run.
+   *
+   * The chunks are run in parallel, in no particular order: \a func must only
+   * modify data related to the indices it is given.
+   */
+  template <typename Function>
+  void ParallelFor(std::size_t count, std::size_t chunkSize, Function func) {
+    RunJob(count,
+           chunkSize,
+           [](void* function, std::size_t begin, std::size_t end) {
+             (*static_cast<Function*>(function))(begin, end);
+           },
+           &func);
+  }
+
+  /**
+   * \brief Return the number of threads that the hardware can run
+   * concurrently (at least 1).
+   */
+  static std::size_t GetHardwareThreadsCount();
+
+ private:
+  typedef void (*JobFunction)(void*, std::size_t, std::size_t);
+
+  /**
+   * \brief The range of chunks [front, back) not yet run of a thread.
+   * The thread owning the range takes chunks from the front, the other
+   * threads steal them from the back.
+   */
+  struct ChunksRange {
+    std::mutex mutex;
+    std::size_t front;
+    std::size_t back;
+  };
+
+  void RunJob(std::size_t count,
+              std::size_t chunkSize,
+              JobFunction function,
+              void* functionData);
+  void RunChunks(std::size_t threadIndex);
+  bool TakeChunk(std::size_t threadIndex, std::size_t& chunk);
+  void WorkerLoop(std::size_t threadIndex, std::size_t lastJobIndex);
+  void StopWorkers();
+
+  std::vector<std::thread> workers;
+  std::unique_ptr<ChunksRange[]>
+      chunksRanges;  ///< The chunks of each thread. The range of the thread
+                     ///< calling ParallelFor is the first one.
+
+  std::mutex mutex;  ///< Protect the members below.
+  std::condition_variable jobStarted;
+  std::condition_variable jobFinished;
+  std::size_t jobIndex;  ///< Incremented each time a job is started.
+  std::size_t finishedWorkersCount;  ///< The workers done with the last job.
+  bool stopping;
+
+  JobFunction jobFunction;
+  void* jobFunctionData;
+  std::size_t jobCount;
+  std::size_t jobChunkSize;
+};
+
+#endif  // JOBSPOOL_H
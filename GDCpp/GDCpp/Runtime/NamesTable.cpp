@@ -0,0 +1,45 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/NamesTable.h"
+#include <deque>
+#include <unordered_map>
+
+namespace {
+// The names are stored in a deque so that references returned by GetName stay
+// valid when new names are interned.
+std::deque<gd::String>& GetNames() {
+  static std::deque<gd::String> names;
+  return names;
+}
+
+std::unordered_map<gd::String, std::size_t>& GetIds() {
+  static std::unordered_map<gd::String, std::size_t> ids;
+  return ids;
+}
+}  // namespace
+
+const std::size_t NamesTable::npos;
+
+std::size_t NamesTable::GetId(const gd::String& name) {
+  auto it = GetIds().find(name);
+  if (it != GetIds().end()) return it->second;
+
+  std::size_t id = GetNames().size();
+  GetNames().push_back(name);
+  GetIds()[name] = id;
+  return id;
+}
+
+std::size_t NamesTable::GetIdIfExists(const gd::String& name) {
+  auto it = GetIds().find(name);
+  return it != GetIds().end() ? it->second : npos;
+}
+
+const gd::String& NamesTable::GetName(std::size_t id) {
+  return GetNames()[id];
+}
+
+std::size_t NamesTable::GetCount() { return GetNames().size(); }
@@ -0,0 +1,57 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef NAMESTABLE_H
+#define NAMESTABLE_H
+
+#include <cstddef>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief Intern the names of objects, layers and behaviors into small
+ * integer identifiers.
+ *
+ * The identifier of a name is stable for the whole life of the game: it can be
+ * computed once (when a scene or the events code is loaded) and then used
+ * instead of the name for the lookups done at each frame. Identifiers start
+ * at 0 and are contiguous, so that they can be used as indices in vectors.
+ *
+ * \warning Names must be interned by the main thread.
+ *
+ * \see ObjInstancesHolder::GetObjects
+ * \see RuntimeScene::GetRuntimeLayer
+ * \see RuntimeObject::GetBehaviorRawPointer
+ * \ingroup GameEngine
+ */
+class GD_API NamesTable {
+ public:
+  static const std::size_t npos = -1;  ///< Returned by GetIdIfExists for
+                                       ///< names that were never interned.
+
+  /**
+   * \brief Return the identifier of the specified name, creating it if the
+   * name was never interned.
+   */
+  static std::size_t GetId(const gd::String& name);
+
+  /**
+   * \brief Return the identifier of the specified name, or NamesTable::npos
+   * if the name was never interned.
+   */
+  static std::size_t GetIdIfExists(const gd::String& name);
+
+  /**
+   * \brief Return the name associated to the specified identifier.
+   */
+  static const gd::String& GetName(std::size_t id);
+
+  /**
+   * \brief Return the number of names interned, which is also the identifier
+   * that the next new name will get.
+   */
+  static std::size_t GetCount();
+};
+
+#endif  // NAMESTABLE_H
@@ -4,59 +4,174 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include <algorithm>
+#include "GDCpp/Runtime/NamesTable.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/profile.h"
 
 RuntimeObject* ObjInstancesHolder::AddObject(RuntimeObjSPtr&& object) {
-  auto it = objectsInstances[object->GetName()].insert(
-      objectsInstances[object->GetName()].end(), std::move(object));
-  objectsInstancesRefs[(*it)->GetName()].push_back(it->get());
+  RuntimeObject* newObject = InsertObject(std::move(object));
+  if (objectsTransforms) newObject->MoveToObjectsTransforms(objectsTransforms);
 
-  return it->get();
+  // The object is put at the end of the list of its layer, and will be moved
+  // to its place by UpdateLayersObjects.
+  layersObjects[newObject->GetLayer()].push_back(newObject);
+  newObject->SetRenderingOrderChanged(true);
+
+  return newObject;
 }
 
-RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
-    const gd::String& name) {
-  return objectsInstancesRefs[name];
+RuntimeObject* ObjInstancesHolder::InsertObject(RuntimeObjSPtr&& object) {
+  std::size_t nameId = NamesTable::GetId(object->GetName());
+  ObjectsList& list = GetObjectsList(nameId);
+
+  RuntimeObject* newObject = object.get();
+  newObject->instancesListNameId = nameId;
+  newObject->instancesListIndex = list.objects.size();
+  newObject->removedFromInstancesHolder = false;
+  list.objects.push_back(std::move(object));
+  list.objectsRefs.push_back(newObject);
+
+  return newObject;
 }
 
-void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
-  std::unique_ptr<RuntimeObject> theObject;  // We need the object to keep
-                                             // alive.
+RuntimeObjSPtr ObjInstancesHolder::TakeOutObject(const RuntimeObject* object) {
+  ObjectsList& list = objectsLists[object->instancesListNameId];
+  std::size_t index = object->instancesListIndex;
+
+  RuntimeObjSPtr theObject = std::move(list.objects[index]);
+  list.objectsRefs[index] = nullptr;
+  if (list.removedObjectsCount++ == 0)
+    listsWithRemovedObjects.push_back(object->instancesListNameId);
+
+  return theObject;
+}
+
+void ObjInstancesHolder::CompactObjectsList(ObjectsList& list) {
+  std::size_t finalSize = 0;
+  for (std::size_t i = 0; i < list.objects.size(); ++i) {
+    if (!list.objects[i]) continue;
+
+    if (i != finalSize) {
+      list.objects[finalSize] = std::move(list.objects[i]);
+      list.objectsRefs[finalSize] = list.objectsRefs[i];
+      list.objectsRefs[finalSize]->instancesListIndex = finalSize;
+    }
+    finalSize++;
+  }
+  list.objects.resize(finalSize);
+  list.objectsRefs.resize(finalSize);
+  list.removedObjectsCount = 0;
+}
+
+void ObjInstancesHolder::CompactObjectsLists() {
+  for (std::size_t nameId : listsWithRemovedObjects) {
+    ObjectsList& list = objectsLists[nameId];
+    if (list.removedObjectsCount) CompactObjectsList(list);
+  }
+  listsWithRemovedObjects.clear();
+}
+
+void ObjInstancesHolder::RemoveObjects(RuntimeObject* const* objects,
+                                       std::size_t count) {
+  // Flag the objects, and find the layers lists containing them. An object
+  // with its layer changed can still be in the list of its previous layer.
+  bool allLayersChanged = false;
+  changedLayersObjects.clear();
+  removedObjects.clear();
+  for (std::size_t i = 0; i < count; ++i) {
+    RuntimeObject* object = objects[i];
+    if (object->removedFromInstancesHolder) continue;  // Duplicate
 
-  // Find and erase the object from the object lists.
-  for (auto it = objectsInstances.begin(); it != objectsInstances.end(); ++it) {
-    RuntimeObjList& list = it->second;
+    object->removedFromInstancesHolder = true;
+    removedObjects.push_back(object);
+    if (object->HasRenderingOrderChanged())
+      allLayersChanged = true;
+    else
+      changedLayersObjects.push_back(&layersObjects[object->GetLayer()]);
+  }
+
+  // Remove them from the layers lists, in a single pass for each list...
+  auto isRemoved = [](const RuntimeObject* object) {
+    return object->removedFromInstancesHolder;
+  };
+  auto removeFromLayer = [&isRemoved](RuntimeObjNonOwningPtrList& list) {
+    list.erase(std::remove_if(list.begin(), list.end(), isRemoved), list.end());
+  };
+  if (allLayersChanged) {
+    for (auto& it : layersObjects) removeFromLayer(it.second);
+  } else {
+    std::sort(changedLayersObjects.begin(), changedLayersObjects.end());
+    auto end =
+        std::unique(changedLayersObjects.begin(), changedLayersObjects.end());
+    for (auto it = changedLayersObjects.begin(); it != end; ++it)
+      removeFromLayer(**it);
+  }
+
+  // ...and from the objects lists, which are then compacted.
+  for (RuntimeObject* object : removedObjects)
+    TakeOutObject(object);  // The object is destroyed.
+  CompactObjectsLists();
+}
+
+void ObjInstancesHolder::RemoveObjects(const gd::String& name) {
+  RemoveObjects(GetObjectsRawPointers(name));
+}
+
+void ObjInstancesHolder::UpdateLayersObjects() {
+  // Take out the objects that must be moved, keeping the others sorted.
+  movedObjects.clear();
+  sortedObjectsCounts.clear();
+  for (auto& it : layersObjects) {
+    RuntimeObjNonOwningPtrList& list = it.second;
+    std::size_t finalSize = 0;
     for (std::size_t i = 0; i < list.size(); ++i) {
-      if (list[i].get() == object) {
-        theObject = std::move(list[i]);
-        list.erase(list.begin() + i);
-        break;
-      }
+      if (list[i]->HasRenderingOrderChanged())
+        movedObjects.push_back(list[i]);
+      else
+        list[finalSize++] = list[i];
     }
+    list.resize(finalSize);
+    sortedObjectsCounts.push_back(std::make_pair(&list, finalSize));
   }
-  // Find and erase the object from the object raw pointers lists.
-  for (auto it = objectsInstancesRefs.begin(); it != objectsInstancesRefs.end();
-       ++it) {
-    RuntimeObjNonOwningPtrList& associatedList = it->second;
-    associatedList.erase(
-        std::remove(associatedList.begin(), associatedList.end(), object),
-        associatedList.end());
+  if (movedObjects.empty()) return;
+
+  // Put them at the end of the list of their (new) layer, sorted...
+  auto compareZOrder = [](const RuntimeObject* o1, const RuntimeObject* o2) {
+    return o1->GetZOrder() < o2->GetZOrder();
+  };
+  std::stable_sort(movedObjects.begin(), movedObjects.end(), compareZOrder);
+  for (RuntimeObject* object : movedObjects) {
+    object->SetRenderingOrderChanged(false);
+    layersObjects[object->GetLayer()].push_back(object);
+  }
+
+  // ...and merge them with the objects that were already sorted.
+  for (auto& it : sortedObjectsCounts) {
+    RuntimeObjNonOwningPtrList& list = *it.first;
+    if (it.second == 0 || it.second == list.size()) continue;
+
+    std::inplace_merge(list.begin(),
+                       list.begin() + it.second,
+                       list.end(),
+                       compareZOrder);
   }
+}
 
-  AddObject(std::move(theObject));
+void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
+  // The object is moved to the list of its new name. The list of its previous
+  // name will be compacted later.
+  InsertObject(TakeOutObject(object));
 }
 
 void ObjInstancesHolder::Init(const ObjInstancesHolder& other) {
-  objectsInstances.clear();
-  objectsInstancesRefs.clear();
-
-  for (auto it = other.objectsInstances.cbegin();
-       it != other.objectsInstances.cend();
-       ++it) {
-    for (std::size_t i = 0; i < it->second.size();
-         ++i)  // We need to really copy the objects
-      AddObject(std::unique_ptr<RuntimeObject>(it->second[i]->Clone()));
+  Clear();
+
+  for (const ObjectsList& list : other.objectsLists) {
+    for (const RuntimeObject* object : list.objectsRefs) {
+      if (object)  // We need to really copy the objects
+        AddObject(std::unique_ptr<RuntimeObject>(object->Clone()));
+    }
   }
 }
 
@@ -2,15 +2,18 @@
 #define OBJINSTANCESHOLDER_H
 
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "GDCpp/Runtime/NamesTable.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/String.h"
 
 class RuntimeObject;
+class ObjectsTransforms;
 
 using RuntimeObjList = std::vector<std::unique_ptr<RuntimeObject>>;
 using RuntimeObjNonOwningPtrList = std::vector<RuntimeObject*>;
@@ -50,35 +53,88 @@ class GD_API ObjInstancesHolder {
    * \brief Add a new object to the lists.
    * \note The object is then hold in the container and you can
    * forget the shared pointer to it.
+   * \note If the container has objects transforms, the position and the
+   * forces of the object are moved to them (see SetObjectsTransforms).
    */
   RuntimeObject* AddObject(RuntimeObjSPtr&& object);
 
+  /**
+   * \brief Set the storage of the positions and forces of the objects of the
+   * scene owning the container.
+   *
+   * The objects added to the container are then given a slot in these
+   * transforms, releasing the slot they had (for example in the transforms of
+   * the scene they were created for), and are moved by
+   * ObjectsTransforms::ApplyForces. The transforms are not copied with the
+   * container.
+   */
+  void SetObjectsTransforms(
+      const std::shared_ptr<ObjectsTransforms>& objectsTransforms_) {
+    objectsTransforms = objectsTransforms_;
+  }
+
   /**
    * \brief Get all objects with the specified name
+   *
+   * \warning The list is updated in place: iterators, pointers and indices to
+   * its elements are invalidated when an object is added, and when objects
+   * are removed or renamed (the list being compacted by RemoveObjects, or by
+   * the next call to GetObjects or GetObjectsRawPointers). The returned
+   * reference itself stays valid as long as the container.
    */
   inline const RuntimeObjList& GetObjects(const gd::String& name) {
-    return objectsInstances[name];
+    return GetObjects(NamesTable::GetId(name));
+  }
+
+  /**
+   * \brief Get all objects with the specified name identifier.
+   * \see NamesTable
+   * \see GetObjects(const gd::String&) for the invalidation of the list
+   * elements.
+   */
+  inline const RuntimeObjList& GetObjects(std::size_t nameId) {
+    return GetCompactedObjectsList(nameId).objects;
   }
 
   /**
    * \brief Get a "raw pointers" list to objects with the specified name
    */
-  RuntimeObjNonOwningPtrList GetObjectsRawPointers(const gd::String& name);
+  RuntimeObjNonOwningPtrList GetObjectsRawPointers(const gd::String& name) {
+    return GetObjectsRawPointers(NamesTable::GetId(name));
+  }
+
+  /**
+   * \brief Get a "raw pointers" list to objects with the specified name
+   * identifier.
+   * \see NamesTable
+   */
+  RuntimeObjNonOwningPtrList GetObjectsRawPointers(std::size_t nameId) {
+    return GetCompactedObjectsList(nameId).objectsRefs;
+  }
 
   /**
    * \brief Get a list of all objects contained.
    */
   inline RuntimeObjNonOwningPtrList GetAllObjects() {
     RuntimeObjNonOwningPtrList objList;
+    GetAllObjects(objList);
+
+    return objList;
+  }
 
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
-        objList.push_back(it2->get());
+  /**
+   * \brief Fill \a objList with all objects contained.
+   *
+   * \a objList is cleared first, but its memory is reused: use the same list
+   * at each frame to avoid allocating memory.
+   */
+  inline void GetAllObjects(RuntimeObjNonOwningPtrList& objList) {
+    objList.clear();
+    for (const ObjectsList& list : objectsLists) {
+      for (RuntimeObject* object : list.objectsRefs) {
+        if (object) objList.push_back(object);
       }
     }
-
-    return objList;
   }
 
   /**
@@ -89,37 +145,42 @@ class GD_API ObjInstancesHolder {
    * myObject->SetName(""); //The scene will take care of deleting the object
    * scene.objectsInstances.ObjectNameHasChanged(myObject);
    * \endcode
+   *
+   * \note This is linear in the number of objects of the lists containing
+   * the object (see RemoveObjects). To remove several objects, use
+   * RemoveObjects: the lists of objects are updated only once.
    */
-  inline void RemoveObject(RuntimeObject* object) {
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      RuntimeObjList& associatedList = it->second;
-      associatedList.erase(
-          std::remove_if(
-              associatedList.begin(),
-              associatedList.end(),
-              [&object](const std::unique_ptr<RuntimeObject>& objectPtr) {
-                return objectPtr.get() == object;
-              }),
-          associatedList.end());
-    }
-    for (auto it = objectsInstancesRefs.begin();
-         it != objectsInstancesRefs.end();
-         ++it) {
-      RuntimeObjNonOwningPtrList& associatedList = it->second;
-      associatedList.erase(
-          std::remove(associatedList.begin(), associatedList.end(), object),
-          associatedList.end());
-    }
+  inline void RemoveObject(RuntimeObject* object) { RemoveObjects(&object, 1); }
+
+  /**
+   * \brief Remove the specified objects.
+   *
+   * Each object is found in its list in constant time, using its stored
+   * position, but the lists containing removed objects (and the lists of
+   * their layers) are then compacted so that the order of the remaining
+   * objects is kept: this is linear in the size of these lists. Each list is
+   * updated only once, whatever the number of objects removed: this is the
+   * function to use when a lot of objects are destroyed at the same time.
+   *
+   * \warning The lists returned by GetObjects and GetObjectsOnLayer are
+   * updated in place: iterators and indices to their elements are
+   * invalidated. The copies returned by GetObjectsRawPointers are not updated
+   * and still point to the removed objects.
+   */
+  inline void RemoveObjects(const RuntimeObjNonOwningPtrList& objects) {
+    RemoveObjects(objects.data(), objects.size());
   }
 
+  /**
+   * \brief Remove the specified objects.
+   * \see RemoveObjects
+   */
+  void RemoveObjects(RuntimeObject* const* objects, std::size_t count);
+
   /**
    * \brief Remove an entire list of object with a given name
    */
-  inline void RemoveObjects(const gd::String& name) {
-    objectsInstances[name].clear();
-    objectsInstancesRefs[name].clear();
-  }
+  void RemoveObjects(const gd::String& name);
 
   /**
    * \brief To be called when an object has changed its name.
@@ -131,18 +192,124 @@ class GD_API ObjInstancesHolder {
    * \note All objects contained inside are destroyed.
    */
   inline void Clear() {
-    objectsInstances.clear();
-    objectsInstancesRefs.clear();
+    objectsLists.clear();
+    listsWithRemovedObjects.clear();
+    layersObjects.clear();
   }
 
+  /** \name Rendering
+   * Members functions used to render objects layer by layer.
+   */
+  ///@{
+  /**
+   * \brief Sort the objects of each layer by Z order.
+   *
+   * Only objects that were added, or which had their layer or Z order changed
+   * since the last call are moved: the lists of other objects are already
+   * sorted. Objects having the same Z order stay in the same order (newer
+   * objects being after older ones).
+   */
+  void UpdateLayersObjects();
+
+  /**
+   * \brief Get the objects on the specified layer, sorted by Z order.
+   * \note Call UpdateLayersObjects first to take into account objects added,
+   * or which had their layer or Z order changed.
+   */
+  const RuntimeObjNonOwningPtrList& GetObjectsOnLayer(const gd::String& layer) {
+    return layersObjects[layer];
+  }
+  ///@}
+
  private:
+  /**
+   * \brief The objects having a name, and "raw pointers" to them.
+   *
+   * When an object is removed or renamed, its element in the lists is
+   * replaced by a null pointer, and the lists are compacted later (see
+   * CompactObjectsList).
+   */
+  struct ObjectsList {
+    ObjectsList() : removedObjectsCount(0){};
+
+    RuntimeObjList objects;
+    RuntimeObjNonOwningPtrList objectsRefs;
+    std::size_t removedObjectsCount;  ///< The number of null pointers in the
+                                      ///< lists.
+  };
+
   void Init(const ObjInstancesHolder& other);
 
-  std::unordered_map<gd::String, RuntimeObjList>
-      objectsInstances;  ///< The list of all objects, classified by name
+  /**
+   * \brief Add the object to the containers, but not to the lists of objects
+   * sorted by layer.
+   */
+  RuntimeObject* InsertObject(RuntimeObjSPtr&& object);
+
+  /**
+   * \brief Return the list of objects having the name with the specified
+   * identifier, creating it if needed. The list can contain null pointers.
+   */
+  inline ObjectsList& GetObjectsList(std::size_t nameId) {
+    if (nameId >= objectsLists.size()) objectsLists.resize(nameId + 1);
+
+    return objectsLists[nameId];
+  }
+
+  /**
+   * \brief Return the list of objects having the name with the specified
+   * identifier, without null pointers.
+   */
+  inline ObjectsList& GetCompactedObjectsList(std::size_t nameId) {
+    ObjectsList& list = GetObjectsList(nameId);
+    if (list.removedObjectsCount) CompactObjectsList(list);
+
+    return list;
+  }
+
+  /**
+   * \brief Replace the element of the object in its list by a null pointer.
+   * \return The object, which is not owned by the container anymore.
+   */
+  RuntimeObjSPtr TakeOutObject(const RuntimeObject* object);
+
+  /**
+   * \brief Remove the null pointers from the list.
+   */
+  void CompactObjectsList(ObjectsList& list);
+
+  /**
+   * \brief Remove the null pointers from all the lists.
+   */
+  void CompactObjectsLists();
+
+  std::deque<ObjectsList>
+      objectsLists;  ///< The list of all objects, classified by the
+                     ///< identifiers of their names (see NamesTable). A deque
+                     ///< is used so that the lists are never moved.
+  std::vector<std::size_t>
+      listsWithRemovedObjects;  ///< The identifiers of the lists having null
+                                ///< pointers.
+  std::shared_ptr<ObjectsTransforms>
+      objectsTransforms;  ///< The transforms of the scene owning the
+                          ///< container, if any.
+  RuntimeObjNonOwningPtrList
+      removedObjects;  ///< Used by RemoveObjects, kept to avoid
+                       ///< reallocations.
+  std::vector<RuntimeObjNonOwningPtrList*>
+      changedLayersObjects;  ///< Used by RemoveObjects, kept to avoid
+                             ///< reallocations.
   std::unordered_map<gd::String, RuntimeObjNonOwningPtrList>
-      objectsInstancesRefs;  ///< Clones of the objectsInstances lists, but with
-                             ///< references instead.
+      layersObjects;  ///< The objects classified by layer, sorted by Z order
+                      ///< except for the objects having
+                      ///< RuntimeObject::HasRenderingOrderChanged returning
+                      ///< true.
+  RuntimeObjNonOwningPtrList
+      movedObjects;  ///< Used by UpdateLayersObjects, kept to avoid
+                     ///< reallocations.
+  std::vector<std::pair<RuntimeObjNonOwningPtrList*, std::size_t>>
+      sortedObjectsCounts;  ///< Used by UpdateLayersObjects, kept to avoid
+                            ///< reallocations.
 };
 
 #endif  // OBJINSTANCESHOLDER_H
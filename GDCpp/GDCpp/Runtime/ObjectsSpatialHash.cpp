@@ -0,0 +1,72 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
+#include <cmath>
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+namespace {
+const float maxCellCoordinate = 1 << 30;
+}
+
+ObjectsSpatialHash::ObjectsSpatialHash(float cellSize_) : queryStamp(0) {
+  Reset(cellSize_);
+}
+
+void ObjectsSpatialHash::Reset(float cellSize_) {
+  cellSize = cellSize_ > 1 ? cellSize_ : 1;
+  boxes.clear();
+  cells.clear();
+  lastQueryStamps.clear();
+  queryStamp = 0;
+}
+
+std::size_t ObjectsSpatialHash::Insert(const sf::FloatRect& box) {
+  std::size_t index = boxes.size();
+  boxes.push_back(box);
+  lastQueryStamps.push_back(queryStamp);
+
+  std::int64_t minX, minY, maxX, maxY;
+  GetCellsRange(box, minX, minY, maxX, maxY);
+  for (std::int64_t x = minX; x <= maxX; ++x) {
+    for (std::int64_t y = minY; y <= maxY; ++y) {
+      cells[GetCellKey(x, y)].push_back(index);
+    }
+  }
+
+  return index;
+}
+
+std::int64_t ObjectsSpatialHash::GetCellCoordinate(float position) const {
+  float coordinate = std::floor(position / cellSize);
+
+  // Also handles NaN, which fails every comparison.
+  if (!(coordinate >= -maxCellCoordinate)) return -maxCellCoordinate;
+  if (!(coordinate <= maxCellCoordinate)) return maxCellCoordinate;
+  return static_cast<std::int64_t>(coordinate);
+}
+
+void ObjectsSpatialHash::GetCellsRange(const sf::FloatRect& box,
+                                       std::int64_t& minX,
+                                       std::int64_t& minY,
+                                       std::int64_t& maxX,
+                                       std::int64_t& maxY) const {
+  minX = GetCellCoordinate(box.left);
+  minY = GetCellCoordinate(box.top);
+  maxX = GetCellCoordinate(box.left + box.width);
+  maxY = GetCellCoordinate(box.top + box.height);
+}
+
+sf::FloatRect ObjectsSpatialHash::GetBroadphaseBox(
+    const RuntimeObject& object) {
+  float width = object.GetWidth();
+  float height = object.GetHeight();
+  float radius = std::sqrt(width * width + height * height) / 2.0;
+  float centerX = object.GetDrawableX() + object.GetCenterX();
+  float centerY = object.GetDrawableY() + object.GetCenterY();
+
+  return sf::FloatRect(
+      centerX - radius, centerY - radius, radius * 2, radius * 2);
+}
@@ -0,0 +1,139 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSSPATIALHASH_H
+#define OBJECTSSPATIALHASH_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+class RuntimeObject;
+
+/**
+ * \brief A uniform grid used as a broadphase to find boxes that could be
+ * overlapping a given area.
+ *
+ * Boxes are identified by the index they were inserted with (see Insert). A
+ * box spanning several cells is stored in each of them, but is reported only
+ * once per query.
+ *
+ * \see TwoObjectListsTestWithBroadphase
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsSpatialHash {
+ public:
+  /**
+   * \brief Create an empty grid.
+   * \param cellSize The width and height of a cell, in pixels.
+   */
+  ObjectsSpatialHash(float cellSize = 128);
+
+  /**
+   * \brief Remove all the boxes and change the size of the cells.
+   */
+  void Reset(float cellSize);
+
+  /**
+   * \brief Remove all the boxes, keeping the same cell size.
+   */
+  void Clear() { Reset(cellSize); }
+
+  /**
+   * \brief Add a box to the grid.
+   * \return The index identifying the box, which is also the number of boxes
+   * inserted before this one.
+   */
+  std::size_t Insert(const sf::FloatRect& box);
+
+  /**
+   * \brief Return the number of boxes in the grid.
+   */
+  std::size_t GetBoxesCount() const { return boxes.size(); }
+
+  /**
+   * \brief Return the box that was inserted with the given index.
+   */
+  const sf::FloatRect& GetBox(std::size_t index) const { return boxes[index]; }
+
+  /**
+   * \brief Call \a callback with the index of each box overlapping \a area.
+   *
+   * Boxes touching the area by an edge are considered as overlapping.
+   */
+  template <typename Callback>
+  void QueryBoxes(const sf::FloatRect& area, Callback callback) const {
+    if (boxes.empty()) return;
+    ++queryStamp;
+
+    auto visitCell = [&](const std::vector<std::size_t>& cell) {
+      for (std::size_t index : cell) {
+        if (lastQueryStamps[index] == queryStamp) continue;
+        lastQueryStamps[index] = queryStamp;
+
+        if (Overlaps(boxes[index], area)) callback(index);
+      }
+    };
+
+    std::int64_t minX, minY, maxX, maxY;
+    GetCellsRange(area, minX, minY, maxX, maxY);
+    if ((maxX - minX + 1) * (maxY - minY + 1) >
+        static_cast<std::int64_t>(cells.size())) {
+      // The area covers more cells than there are cells used: iterate on
+      // the existing cells instead.
+      for (auto& it : cells) visitCell(it.second);
+      return;
+    }
+
+    for (std::int64_t x = minX; x <= maxX; ++x) {
+      for (std::int64_t y = minY; y <= maxY; ++y) {
+        auto it = cells.find(GetCellKey(x, y));
+        if (it != cells.end()) visitCell(it->second);
+      }
+    }
+  }
+
+  /**
+   * \brief Return true if the two boxes are overlapping or touching.
+   */
+  static bool Overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+           a.top <= b.top + b.height && b.top <= a.top + a.height;
+  }
+
+  /**
+   * \brief Return the box used to find the objects that could be colliding
+   * with \a object.
+   *
+   * This is the square containing the bounding circle of the object (the same
+   * circle that is used by RuntimeObject::IsCollidingWith to discard objects
+   * that are too far away): the box contains the object center, and two
+   * objects passing the bounding circle test always have overlapping boxes.
+   */
+  static sf::FloatRect GetBroadphaseBox(const RuntimeObject& object);
+
+ private:
+  void GetCellsRange(const sf::FloatRect& box,
+                     std::int64_t& minX,
+                     std::int64_t& minY,
+                     std::int64_t& maxX,
+                     std::int64_t& maxY) const;
+  std::int64_t GetCellCoordinate(float position) const;
+  static std::int64_t GetCellKey(std::int64_t x, std::int64_t y) {
+    return static_cast<std::int64_t>((static_cast<std::uint64_t>(x) << 32) ^
+                                     (static_cast<std::uint64_t>(y) &
+                                      0xFFFFFFFF));
+  }
+
+  float cellSize;
+  std::vector<sf::FloatRect> boxes;  ///< The boxes inserted, by index.
+  std::unordered_map<std::int64_t, std::vector<std::size_t>>
+      cells;  ///< The indices of the boxes, for each non empty cell.
+  mutable std::vector<unsigned int>
+      lastQueryStamps;  ///< For each box, the last query that visited it.
+  mutable unsigned int queryStamp;
+};
+
+#endif  // OBJECTSSPATIALHASH_H
@@ -0,0 +1,53 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+
+ObjectsTransforms::ObjectsTransforms() {}
+
+std::size_t ObjectsTransforms::AllocateSlot() {
+  if (!freeSlots.empty()) {
+    std::size_t index = freeSlots.back();
+    freeSlots.pop_back();
+    return index;
+  }
+
+  x.push_back(0);
+  y.push_back(0);
+  forceX.push_back(0);
+  forceY.push_back(0);
+  layersNamesIds.push_back(0);
+  inScene.push_back(0);
+  return x.size() - 1;
+}
+
+void ObjectsTransforms::ReleaseSlot(std::size_t index) {
+  // Reset the slot so that ApplyForces goes through it without effect.
+  x[index] = y[index] = 0;
+  forceX[index] = forceY[index] = 0;
+  layersNamesIds[index] = 0;
+  inScene[index] = 0;
+  freeSlots.push_back(index);
+}
+
+void ObjectsTransforms::ApplyForces(const std::vector<double>& elapsedTimes) {
+  float* xData = x.data();
+  float* yData = y.data();
+  const float* forceXData = forceX.data();
+  const float* forceYData = forceY.data();
+  const std::size_t* layersNamesIdsData = layersNamesIds.data();
+  const double* inSceneData = inScene.data();
+  const double* elapsedTimesData = elapsedTimes.data();
+
+  // A loop without branches on contiguous arrays, that the compiler can
+  // vectorize.
+  std::size_t count = x.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    double elapsedTime =
+        elapsedTimesData[layersNamesIdsData[i]] * inSceneData[i];
+    xData[i] += forceXData[i] * elapsedTime;
+    yData[i] += forceYData[i] * elapsedTime;
+  }
+}
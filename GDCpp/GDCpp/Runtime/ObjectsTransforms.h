@@ -0,0 +1,109 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSTRANSFORMS_H
+#define OBJECTSTRANSFORMS_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \brief Store the positions and the total forces of the objects of a scene
+ * in contiguous arrays (one array per member), so that moving all the objects
+ * according to their forces is a tight loop.
+ *
+ * Each RuntimeObject is given a slot when it is created, and releases it when
+ * destroyed. Released slots are reused by the next objects. Only the slots of
+ * the objects added to the scene are moved by ApplyForces: an object added
+ * to the instances of a scene is given a slot in the transforms of this scene
+ * (see ObjInstancesHolder::SetObjectsTransforms).
+ *
+ * \see RuntimeScene::GetObjectsTransforms
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsTransforms {
+ public:
+  ObjectsTransforms();
+  virtual ~ObjectsTransforms(){};
+
+  /**
+   * \brief Return the index of a new slot, with a position and a total force
+   * set to 0, not moved by ApplyForces until added to the scene.
+   */
+  std::size_t AllocateSlot();
+
+  /**
+   * \brief Release a slot, so that it can be reused.
+   */
+  void ReleaseSlot(std::size_t index);
+
+  /**
+   * \brief Return the number of slots, including the released ones.
+   */
+  std::size_t GetSlotsCount() const { return x.size(); }
+
+  float GetX(std::size_t index) const { return x[index]; }
+  float GetY(std::size_t index) const { return y[index]; }
+  void SetX(std::size_t index, float value) { x[index] = value; }
+  void SetY(std::size_t index, float value) { y[index] = value; }
+
+  float GetForceX(std::size_t index) const { return forceX[index]; }
+  float GetForceY(std::size_t index) const { return forceY[index]; }
+  void SetForce(std::size_t index, float forceX_, float forceY_) {
+    forceX[index] = forceX_;
+    forceY[index] = forceY_;
+  }
+
+  /**
+   * \brief Return true if the total force of the slot is not null.
+   */
+  bool IsMoving(std::size_t index) const {
+    return forceX[index] != 0 || forceY[index] != 0;
+  }
+
+  /**
+   * \brief Set the identifier of the name of the layer of the object using
+   * the slot (see NamesTable).
+   */
+  void SetLayerNameId(std::size_t index, std::size_t layerNameId) {
+    layersNamesIds[index] = layerNameId;
+  }
+
+  /**
+   * \brief Set if the object using the slot is in the scene, so that it is
+   * moved by ApplyForces.
+   */
+  void SetInScene(std::size_t index, bool inScene_) {
+    inScene[index] = inScene_ ? 1 : 0;
+  }
+
+  /**
+   * \brief Return true if the object using the slot is in the scene.
+   */
+  bool IsInScene(std::size_t index) const { return inScene[index] != 0; }
+
+  /**
+   * \brief Move each slot of the objects in the scene according to its
+   * total force.
+   *
+   * \param elapsedTimes The time elapsed since the last frame, in seconds,
+   * indexed by the identifiers of the layers names. It must contain an entry
+   * for each layer name identifier used by the slots.
+   */
+  void ApplyForces(const std::vector<double>& elapsedTimes);
+
+ private:
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> forceX;  ///< The sum of the forces of the objects.
+  std::vector<float> forceY;  ///< The sum of the forces of the objects.
+  std::vector<std::size_t> layersNamesIds;
+  std::vector<double> inScene;  ///< 1 for the objects in the scene, 0 for the
+                                ///< others, so that ApplyForces can move all
+                                ///< the slots without branches.
+  std::vector<std::size_t> freeSlots;  ///< The released slots.
+};
+
+#endif  // OBJECTSTRANSFORMS_H
@@ -7,8 +7,20 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <limits>
+#include <vector>
 #include "GDCpp/Runtime/Polygon2d.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GD_POLYGON_COLLISION_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GD_POLYGON_COLLISION_SSE2
+#endif
+
 namespace {
 
 void normalise(sf::Vector2f& v) {
@@ -33,25 +45,6 @@ float crossProduct(const sf::Vector2f a, const sf::Vector2f b) {
   return cp;
 }
 
-void project(const sf::Vector2f axis,
-             const Polygon2d& p,
-             float& min,
-             float& max) {
-  float dp = dotProduct(axis, p.vertices[0]);
-
-  min = dp;
-  max = dp;
-
-  for (std::size_t i = 1; i < p.vertices.size(); i++) {
-    dp = dotProduct(axis, p.vertices[i]);
-
-    if (dp < min)
-      min = dp;
-    else if (dp > max)
-      max = dp;
-  }
-}
-
 float distance(float minA, float maxA, float minB, float maxB) {
   if (minA < minB)
     return minB - maxA;
@@ -59,50 +52,88 @@ float distance(float minA, float maxA, float minB, float maxB) {
     return minA - maxB;
 }
 
-}  // namespace
+#if defined(GD_POLYGON_COLLISION_SSE2)
+/**
+ * Load 4 vectors, stored as x0, y0, x1, y1..., as x0, x1, x2, x3 and
+ * y0, y1, y2, y3.
+ */
+inline void load4(const sf::Vector2f* vectors, __m128& xs, __m128& ys) {
+  const float* data = reinterpret_cast<const float*>(vectors);
+  __m128 v01 = _mm_loadu_ps(data);
+  __m128 v23 = _mm_loadu_ps(data + 4);
+  xs = _mm_shuffle_ps(v01, v23, _MM_SHUFFLE(2, 0, 2, 0));
+  ys = _mm_shuffle_ps(v01, v23, _MM_SHUFFLE(3, 1, 3, 1));
+}
 
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
-                                            bool ignoreTouchingEdges) {
+inline float horizontalMin(__m128 v) {
+  v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+  return _mm_cvtss_f32(v);
+}
+
+inline float horizontalMax(__m128 v) {
+  v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+  return _mm_cvtss_f32(v);
+}
+#endif
+
+/**
+ * Do a collision test between the two polygons. The edges of \a p1 must be
+ * computed. If given, \a p1Axes and \a p1Projections are the axes of \a p1
+ * and the minimum and maximum projections of \a p1 on them.
+ */
+CollisionResult collisionTest(const Polygon2d& p1,
+                              const Polygon2d& p2,
+                              bool ignoreTouchingEdges,
+                              const sf::Vector2f* p1Axes,
+                              const float* p1Projections) {
+  CollisionResult result;
   if (p1.vertices.size() < 3 || p2.vertices.size() < 3) {
-    CollisionResult result;
     result.collision = false;
     result.move_axis.x = 0.0f;
     result.move_axis.y = 0.0f;
     return result;
   }
 
-  p1.ComputeEdges();
   p2.ComputeEdges();
 
   sf::Vector2f edge;
   sf::Vector2f move_axis(0, 0);
-  sf::Vector2f mtd(0, 0);
 
   float min_dist = FLT_MAX;
 
-  CollisionResult result;
-
   // Iterate over all the edges composing the polygons
   for (std::size_t i = 0; i < p1.vertices.size() + p2.vertices.size(); i++) {
-    if (i < p1.vertices.size())  // or <=
-    {
-      edge = p1.edges[i];
-    } else {
-      edge = p2.edges[i - p1.vertices.size()];
-    }
-
-    sf::Vector2f axis(
-        -edge.y, edge.x);  // Get the axis to which polygons will be projected
-    normalise(axis);
-
+    sf::Vector2f axis;
     float minA = 0;
     float minB = 0;
     float maxA = 0;
     float maxB = 0;
 
-    project(axis, p1, minA, maxA);
-    project(axis, p2, minB, maxB);
+    if (i < p1.vertices.size() && p1Axes) {
+      // The axes of p1 and its projections on them are known.
+      axis = p1Axes[i];
+      minA = p1Projections[i * 2];
+      maxA = p1Projections[i * 2 + 1];
+    } else {
+      if (i < p1.vertices.size())  // or <=
+      {
+        edge = p1.edges[i];
+      } else {
+        edge = p2.edges[i - p1.vertices.size()];
+      }
+
+      axis = sf::Vector2f(
+          -edge.y, edge.x);  // Get the axis to which polygons will be projected
+      normalise(axis);
+
+      ProjectVerticesOnAxis(
+          p1.vertices.data(), p1.vertices.size(), axis, minA, maxA);
+    }
+
+    ProjectVerticesOnAxis(
+        p2.vertices.data(), p2.vertices.size(), axis, minB, maxB);
 
     float dist = distance(minA, maxA, minB, maxB);
     if (dist > 0.0f || (dist == 0.0 && ignoreTouchingEdges)) {
@@ -132,8 +163,172 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
   return result;
 }
 
+}  // namespace
+
+bool GD_API PolygonSimdInstructionsAvailable() {
+#if defined(GD_POLYGON_COLLISION_SSE2)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void GD_API ProjectVerticesOnAxis(const sf::Vector2f* vertices,
+                                  std::size_t count,
+                                  const sf::Vector2f& axis,
+                                  float& min,
+                                  float& max,
+                                  bool useSimd) {
+  min = std::numeric_limits<float>::infinity();
+  max = -std::numeric_limits<float>::infinity();
+  std::size_t i = 0;
+
+#if defined(GD_POLYGON_COLLISION_AVX)
+  if (useSimd && count >= 8) {
+    __m256 axisX = _mm256_set1_ps(axis.x);
+    __m256 axisY = _mm256_set1_ps(axis.y);
+    __m256 mins = _mm256_set1_ps(min);
+    __m256 maxs = _mm256_set1_ps(max);
+    for (; i + 8 <= count; i += 8) {
+      // Deinterleave the coordinates: the order of the vertices in the lanes
+      // does not matter for the minimum and maximum.
+      const float* data = reinterpret_cast<const float*>(vertices + i);
+      __m256 a = _mm256_loadu_ps(data);
+      __m256 b = _mm256_loadu_ps(data + 8);
+      __m256 xs = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+      __m256 ys = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+      __m256 dp =
+          _mm256_add_ps(_mm256_mul_ps(axisX, xs), _mm256_mul_ps(axisY, ys));
+      mins = _mm256_min_ps(mins, dp);
+      maxs = _mm256_max_ps(maxs, dp);
+    }
+    min = horizontalMin(_mm_min_ps(_mm256_castps256_ps128(mins),
+                                   _mm256_extractf128_ps(mins, 1)));
+    max = horizontalMax(_mm_max_ps(_mm256_castps256_ps128(maxs),
+                                   _mm256_extractf128_ps(maxs, 1)));
+  }
+#endif
+#if defined(GD_POLYGON_COLLISION_SSE2)
+  if (useSimd && i + 4 <= count) {
+    __m128 axisX = _mm_set1_ps(axis.x);
+    __m128 axisY = _mm_set1_ps(axis.y);
+    __m128 mins = _mm_set1_ps(min);
+    __m128 maxs = _mm_set1_ps(max);
+    for (; i + 4 <= count; i += 4) {
+      __m128 xs, ys;
+      load4(vertices + i, xs, ys);
+      __m128 dp = _mm_add_ps(_mm_mul_ps(axisX, xs), _mm_mul_ps(axisY, ys));
+      mins = _mm_min_ps(mins, dp);
+      maxs = _mm_max_ps(maxs, dp);
+    }
+    min = horizontalMin(mins);
+    max = horizontalMax(maxs);
+  }
+#endif
+
+  for (; i < count; i++) {
+    float dp = dotProduct(axis, vertices[i]);
+
+    if (dp < min) min = dp;
+    if (dp > max) max = dp;
+  }
+}
+
+void GD_API ComputeRayEdgesIntersections(const sf::Vector2f* vertices,
+                                         const sf::Vector2f* edges,
+                                         std::size_t count,
+                                         const sf::Vector2f& rayStart,
+                                         const sf::Vector2f& ray,
+                                         float* crossesRS,
+                                         float* crossesQPR,
+                                         float* ts,
+                                         float* us,
+                                         bool useSimd) {
+  std::size_t i = 0;
+
+#if defined(GD_POLYGON_COLLISION_SSE2)
+  if (useSimd) {
+    __m128 px = _mm_set1_ps(rayStart.x);
+    __m128 py = _mm_set1_ps(rayStart.y);
+    __m128 rx = _mm_set1_ps(ray.x);
+    __m128 ry = _mm_set1_ps(ray.y);
+    for (; i + 4 <= count; i += 4) {
+      __m128 qx, qy, sx, sy;
+      load4(vertices + i, qx, qy);
+      load4(edges + i, sx, sy);
+      __m128 deltaX = _mm_sub_ps(qx, px);
+      __m128 deltaY = _mm_sub_ps(qy, py);
+      __m128 crossRS = _mm_sub_ps(_mm_mul_ps(rx, sy), _mm_mul_ps(ry, sx));
+      __m128 crossQPS =
+          _mm_sub_ps(_mm_mul_ps(deltaX, sy), _mm_mul_ps(deltaY, sx));
+      __m128 crossQPR =
+          _mm_sub_ps(_mm_mul_ps(deltaX, ry), _mm_mul_ps(deltaY, rx));
+      _mm_storeu_ps(crossesRS + i, crossRS);
+      _mm_storeu_ps(crossesQPR + i, crossQPR);
+      _mm_storeu_ps(ts + i, _mm_div_ps(crossQPS, crossRS));
+      _mm_storeu_ps(us + i, _mm_div_ps(crossQPR, crossRS));
+    }
+  }
+#endif
+
+  for (; i < count; i++) {
+    sf::Vector2f deltaQP = vertices[i] - rayStart;
+    crossesRS[i] = crossProduct(ray, edges[i]);
+    crossesQPR[i] = crossProduct(deltaQP, ray);
+    ts[i] = crossProduct(deltaQP, edges[i]) / crossesRS[i];
+    us[i] = crossesQPR[i] / crossesRS[i];
+  }
+}
+
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
+                                            bool ignoreTouchingEdges) {
+  p1.ComputeEdges();
+  return collisionTest(p1, p2, ignoreTouchingEdges, nullptr, nullptr);
+}
+
+bool GD_API PolygonsCollisionTest(const Polygon2d& p1,
+                                  const std::vector<Polygon2d>& polygons,
+                                  bool ignoreTouchingEdges,
+                                  std::vector<CollisionResult>* results) {
+  if (results) results->resize(polygons.size());
+  if (polygons.empty()) return false;
+
+  // Compute the axes of p1, and the projections of p1 on them, only once.
+  thread_local std::vector<sf::Vector2f> p1Axes;
+  thread_local std::vector<float> p1Projections;
+  p1.ComputeEdges();
+  p1Axes.resize(p1.edges.size());
+  p1Projections.resize(p1.edges.size() * 2);
+  for (std::size_t i = 0; i < p1.edges.size(); ++i) {
+    p1Axes[i] = sf::Vector2f(-p1.edges[i].y, p1.edges[i].x);
+    normalise(p1Axes[i]);
+    ProjectVerticesOnAxis(p1.vertices.data(),
+                          p1.vertices.size(),
+                          p1Axes[i],
+                          p1Projections[i * 2],
+                          p1Projections[i * 2 + 1]);
+  }
+
+  bool collision = false;
+  for (std::size_t i = 0; i < polygons.size(); ++i) {
+    CollisionResult result = collisionTest(p1,
+                                           polygons[i],
+                                           ignoreTouchingEdges,
+                                           p1Axes.data(),
+                                           p1Projections.data());
+    if (result.collision) {
+      collision = true;
+      if (!results) return true;
+    }
+    if (results) (*results)[i] = result;
+  }
+
+  return collision;
+}
+
 RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY) {
+    const Polygon2d& poly, float startX, float startY, float endX, float endY) {
   RaycastResult result;
   result.collision = false;
 
@@ -151,64 +346,87 @@ RaycastResult GD_API PolygonRaycastTest(
   r.x = endX - startX;
   r.y = endY - startY;
 
-  for (int i = 0; i < poly.edges.size(); i++) {
-    // Edge segment: q + u*s
-    q = poly.vertices[i];
-    s = poly.edges[i];
-    sf::Vector2f deltaQP = q - p;
-    float crossRS = crossProduct(r, s);
-    float t = crossProduct(deltaQP, s) / crossRS;
-    float u = crossProduct(deltaQP, r) / crossRS;
-
-    // Collinear
-    if (abs(crossRS) <= 0.0001 && abs(crossProduct(deltaQP, r)) <= 0.0001) {
-      // Project the ray and the edge to work on floats, keeping linearity
-      // through t
-      sf::Vector2f axis(r.x, r.y);
-      normalise(axis);
-      float rayA = 0.0f;
-      float rayB = dotProduct(axis, r);
-      float edgeA = dotProduct(axis, deltaQP);
-      float edgeB = dotProduct(axis, deltaQP + s);
-      // Get overlapping range
-      float minOverlap = std::max(std::min(rayA, rayB), std::min(edgeA, edgeB));
-      float maxOverlap = std::min(std::max(rayA, rayB), std::max(edgeA, edgeB));
-      if (minOverlap > maxOverlap) {
-        return result;
-      }
-      result.collision = true;
-      // Zero distance ray
-      if (rayB == 0.0f) {
-        result.closePoint = p;
-        result.closeSqDist = 0.0f;
-        result.farPoint = p;
-        result.farSqDist = 0.0f;
-      }
-      float t1 = minOverlap / abs(rayB);
-      float t2 = maxOverlap / abs(rayB);
-      result.closePoint = p + t1 * r;
-      result.closeSqDist = t1 * t1 * (r.x * r.x + r.y * r.y);
-      result.farPoint = p + t2 * r;
-      result.farSqDist = t2 * t2 * (r.x * r.x + r.y * r.y);
-
-      return result;
-    } else if (crossRS != 0 && 0 <= t && t <= 1 && 0 <= u && u <= 1) {
-      sf::Vector2f point = p + t * r;
+  // The intersections of the ray with the edges are computed by blocks of
+  // edges, then checked one by one.
+  const std::size_t blockSize = 16;
+  float crossesRS[blockSize], crossesQPR[blockSize], ts[blockSize],
+      us[blockSize];
+
+  for (std::size_t blockStart = 0; blockStart < poly.edges.size();
+       blockStart += blockSize) {
+    std::size_t blockCount =
+        std::min(blockSize, poly.edges.size() - blockStart);
+    ComputeRayEdgesIntersections(poly.vertices.data() + blockStart,
+                                 poly.edges.data() + blockStart,
+                                 blockCount,
+                                 p,
+                                 r,
+                                 crossesRS,
+                                 crossesQPR,
+                                 ts,
+                                 us);
+
+    for (std::size_t j = 0; j < blockCount; j++) {
+      // Edge segment: q + u*s
+      q = poly.vertices[blockStart + j];
+      s = poly.edges[blockStart + j];
+      sf::Vector2f deltaQP = q - p;
+      float crossRS = crossesRS[j];
+      float t = ts[j];
+      float u = us[j];
+
+      // Collinear
+      if (abs(crossRS) <= 0.0001 && abs(crossesQPR[j]) <= 0.0001) {
+        // Project the ray and the edge to work on floats, keeping linearity
+        // through t
+        sf::Vector2f axis(r.x, r.y);
+        normalise(axis);
+        float rayA = 0.0f;
+        float rayB = dotProduct(axis, r);
+        float edgeA = dotProduct(axis, deltaQP);
+        float edgeB = dotProduct(axis, deltaQP + s);
+        // Get overlapping range
+        float minOverlap =
+            std::max(std::min(rayA, rayB), std::min(edgeA, edgeB));
+        float maxOverlap =
+            std::min(std::max(rayA, rayB), std::max(edgeA, edgeB));
+        if (minOverlap > maxOverlap) {
+          return result;
+        }
+        result.collision = true;
+        // Zero distance ray
+        if (rayB == 0.0f) {
+          result.closePoint = p;
+          result.closeSqDist = 0.0f;
+          result.farPoint = p;
+          result.farSqDist = 0.0f;
+        }
+        float t1 = minOverlap / abs(rayB);
+        float t2 = maxOverlap / abs(rayB);
+        result.closePoint = p + t1 * r;
+        result.closeSqDist = t1 * t1 * (r.x * r.x + r.y * r.y);
+        result.farPoint = p + t2 * r;
+        result.farSqDist = t2 * t2 * (r.x * r.x + r.y * r.y);
 
-      float sqDist = (point.x - startX) * (point.x - startX) +
-                     (point.y - startY) * (point.y - startY);
-      if (sqDist < minSqDist) {
-        if (!result.collision) {
+        return result;
+      } else if (crossRS != 0 && 0 <= t && t <= 1 && 0 <= u && u <= 1) {
+        sf::Vector2f point = p + t * r;
+
+        float sqDist = (point.x - startX) * (point.x - startX) +
+                       (point.y - startY) * (point.y - startY);
+        if (sqDist < minSqDist) {
+          if (!result.collision) {
+            result.farPoint = point;
+            result.farSqDist = sqDist;
+          }
+          minSqDist = sqDist;
+          result.closePoint = point;
+          result.closeSqDist = sqDist;
+          result.collision = true;
+        } else {
           result.farPoint = point;
           result.farSqDist = sqDist;
         }
-        minSqDist = sqDist;
-        result.closePoint = point;
-        result.closeSqDist = sqDist;
-        result.collision = true;
-      } else {
-        result.farPoint = point;
-        result.farSqDist = sqDist;
       }
     }
   }
@@ -216,7 +434,7 @@ RaycastResult GD_API PolygonRaycastTest(
   return result;
 }
 
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y) {
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y) {
   bool inside = false;
   sf::Vector2f vi, vj;
 
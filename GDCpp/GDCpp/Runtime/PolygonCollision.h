@@ -6,6 +6,7 @@
 #ifndef POLYGONCOLLISION_H
 #define POLYGONCOLLISION_H
 #include <SFML/System.hpp>
+#include <vector>
 class Polygon2d;
 
 /**
@@ -28,7 +29,7 @@ struct RaycastResult {
 
 /**
  * Do a collision test between the two polygons.
- * \warning Polygons must convexes.
+ * \warning Polygons must be convex.
  *
  * Uses Separating Axis Theorem (
  * http://en.wikipedia.org/wiki/Hyperplane_separation_theorem ) Based on
@@ -44,10 +45,30 @@ struct RaycastResult {
  *
  * \ingroup GameEngine
  */
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
                                             bool ignoreTouchingEdges = false);
 
+/**
+ * Do a collision test between \a p1 and each polygon of \a polygons.
+ *
+ * This is faster than calling PolygonCollisionTest for each polygon, as the
+ * axes of \a p1 and the projections of \a p1 on them are computed once.
+ * \warning Polygons must be convex.
+ *
+ * \param results If not null, resized and filled with the result of the test
+ * for each polygon. If null, the test stops at the first collision.
+ *
+ * \return true if \a p1 is overlapping at least one of the polygons.
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API PolygonsCollisionTest(
+    const Polygon2d& p1,
+    const std::vector<Polygon2d>& polygons,
+    bool ignoreTouchingEdges = false,
+    std::vector<CollisionResult>* results = nullptr);
+
 /**
  * Do a raycast test.
  * \warning Polygon must be convex.
@@ -59,7 +80,7 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
  * \ingroup GameEngine
  */
 RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY);
+    const Polygon2d& poly, float startX, float startY, float endX, float endY);
 
 /**
  * Check if a point is inside a polygon.
@@ -71,6 +92,46 @@ RaycastResult GD_API PolygonRaycastTest(
  *
  * \ingroup GameEngine
  */
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y);
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y);
+
+/** \name Kernels
+ * Loops used by the tests, using SSE2 (and AVX for the projections) when
+ * enabled by the compiler, and scalar instructions otherwise or if \a useSimd
+ * is false.
+ */
+///@{
+/**
+ * \brief Return true if the kernels can use SIMD instructions.
+ */
+bool GD_API PolygonSimdInstructionsAvailable();
+
+/**
+ * \brief Compute the minimum and maximum projections of the vertices on the
+ * axis.
+ */
+void GD_API ProjectVerticesOnAxis(const sf::Vector2f* vertices,
+                                  std::size_t count,
+                                  const sf::Vector2f& axis,
+                                  float& min,
+                                  float& max,
+                                  bool useSimd = true);
+
+/**
+ * \brief Compute, for each edge (starting at vertices[i] and of vector
+ * edges[i]), the values used to find its intersection with the ray: the
+ * cross products ray x edge and (vertex - rayStart) x ray, and the positions
+ * of the intersection along the ray (t) and along the edge (u).
+ */
+void GD_API ComputeRayEdgesIntersections(const sf::Vector2f* vertices,
+                                         const sf::Vector2f* edges,
+                                         std::size_t count,
+                                         const sf::Vector2f& rayStart,
+                                         const sf::Vector2f& ray,
+                                         float* crossesRS,
+                                         float* crossesQPR,
+                                         float* ts,
+                                         float* us,
+                                         bool useSimd = true);
+///@}
 
 #endif  // POLYGONCOLLISION_H
@@ -0,0 +1,425 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ResourcesArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "GDCpp/Runtime/Tools/FileStream.h"
+#include "GDCpp/Runtime/Tools/LZ4Compression.h"
+#if defined(WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#undef LoadImage  // Undef macro from windows.h
+#elif defined(LINUX) || defined(MACOS) || defined(ANDROID)
+#define GD_RESOURCESARCHIVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gd {
+
+namespace {
+const char Magic[8] = {'G', 'D', 'R', 'E', 'S', 'A', 'R', 'C'};
+const std::uint32_t Version = 2;
+const std::size_t HeaderSize = 40;
+const std::size_t EntrySize = 48;
+
+void AppendUInt32(std::string& output, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) output.push_back(char((value >> (i * 8)) & 0xFF));
+}
+
+void AppendUInt64(std::string& output, std::uint64_t value) {
+  for (int i = 0; i < 8; ++i) output.push_back(char((value >> (i * 8)) & 0xFF));
+}
+
+std::uint32_t ReadUInt32(const char* input) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < 4; ++i)
+    value |= std::uint32_t(static_cast<unsigned char>(input[i])) << (i * 8);
+  return value;
+}
+
+std::uint64_t ReadUInt64(const char* input) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < 8; ++i)
+    value |= std::uint64_t(static_cast<unsigned char>(input[i])) << (i * 8);
+  return value;
+}
+
+std::uint64_t Align(std::uint64_t offset, std::uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Read the whole content of a file, returning an invalid gd::ResourceData in
+ * case of error.
+ */
+ResourceData ReadFile(const gd::String& filename) {
+  gd::FileStream file(filename,
+                      std::ios_base::in | std::ios_base::binary |
+                          std::ios_base::ate);
+  if (!file.is_open()) return ResourceData();
+
+  std::streamoff size = file.tellg();
+  if (size < 0) return ResourceData();
+
+  std::unique_ptr<char[]> buffer(new char[size]);
+  file.seekg(0, std::ios::beg);
+  file.read(buffer.get(), size);
+  if (!file) return ResourceData();
+
+  return ResourceData(std::move(buffer), size);
+}
+}  // namespace
+
+/**
+ * \brief The content of a file, mapped in memory when supported by the
+ * platform or read in a buffer otherwise.
+ */
+class ResourcesArchive::MappedFile {
+ public:
+  static std::unique_ptr<MappedFile> Open(const gd::String& filename) {
+    std::unique_ptr<MappedFile> mappedFile(new MappedFile);
+    if (mappedFile->Map(filename)) return mappedFile;
+
+    // Memory mapping not supported or failed, read the file instead.
+    mappedFile->content = ReadFile(filename);
+    if (!mappedFile->content.IsValid()) return nullptr;
+
+    return mappedFile;
+  }
+
+  ~MappedFile() {
+#if defined(WINDOWS)
+    if (view) UnmapViewOfFile(view);
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#elif defined(GD_RESOURCESARCHIVE_MMAP)
+    if (view) munmap(view, content.GetSize());
+#endif
+  }
+
+  const char* GetData() const { return content.GetData(); }
+  std::size_t GetSize() const { return content.GetSize(); }
+
+ private:
+#if defined(WINDOWS)
+  MappedFile()
+      : file(INVALID_HANDLE_VALUE), mapping(nullptr), view(nullptr) {}
+
+  bool Map(const gd::String& filename) {
+    file = CreateFileW(filename.ToWide().c_str(),
+                       GENERIC_READ,
+                       FILE_SHARE_READ,
+                       nullptr,
+                       OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL,
+                       nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return false;
+
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) return false;
+
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) return false;
+
+    content = ResourceData(static_cast<const char*>(view), size.QuadPart);
+    return true;
+  }
+
+  HANDLE file;
+  HANDLE mapping;
+  void* view;
+#elif defined(GD_RESOURCESARCHIVE_MMAP)
+  MappedFile() : view(nullptr) {}
+
+  bool Map(const gd::String& filename) {
+    int fd = open(filename.ToLocale().c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+      close(fd);
+      return false;
+    }
+
+    // The mapping stays valid after the file descriptor is closed.
+    void* address =
+        mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) return false;
+
+    view = address;
+    content = ResourceData(static_cast<const char*>(view), fileStat.st_size);
+    return true;
+  }
+
+  void* view;
+#else
+  MappedFile() {}
+
+  bool Map(const gd::String& filename) { return false; }
+#endif
+
+  ResourceData content;  ///< The mapped view, or the content read.
+};
+
+ResourcesArchive::ResourcesArchive()
+    : archive(nullptr), archiveSize(0), names(nullptr) {}
+
+ResourcesArchive::~ResourcesArchive() {}
+
+bool ResourcesArchive::Create(const std::vector<gd::String>& files,
+                              const gd::String& directory,
+                              const gd::String& destination,
+                              bool compress) {
+  gd::FileStream archiveFile(destination,
+                             std::ios_base::out | std::ios_base::binary |
+                                 std::ios_base::trunc);
+  if (!archiveFile.is_open()) {
+    std::cout << "Unable to create the resources archive " << destination
+              << std::endl;
+    return false;
+  }
+
+  std::vector<Entry> newEntries;
+  std::string newNames;
+  std::uint64_t offset = HeaderSize;
+  const std::string padding(Alignment, '\0');
+  archiveFile.write(padding.data(), HeaderSize);  // Written at the end.
+
+  for (const gd::String& file : files) {
+    ResourceData content = ReadFile(directory + "/" + file);
+    if (!content.IsValid()) {
+      std::cout << "Unable to read " << file
+                << " to add it to the resources archive." << std::endl;
+      return false;
+    }
+
+    Entry entry;
+    const std::string& name = file.Raw();
+    entry.nameHash = HashName(name.data(), name.size());
+    entry.nameOffset = newNames.size();
+    entry.nameSize = name.size();
+    newNames += name;
+
+    entry.size = content.GetSize();
+    entry.storedSize = content.GetSize();
+    entry.compression = None;
+    const char* storedData = content.GetData();
+
+    std::unique_ptr<char[]> compressed;
+    if (compress && entry.size > 0) {
+      // Compression must save at least an eighth of the size to be worth
+      // decompressing the file when it's loaded.
+      std::size_t capacity = entry.size - entry.size / 8;
+      compressed.reset(new char[capacity]);
+      std::size_t compressedSize = LZ4Compression::Compress(
+          content.GetData(), content.GetSize(), compressed.get(), capacity);
+      if (compressedSize != 0) {
+        entry.storedSize = compressedSize;
+        entry.compression = LZ4;
+        storedData = compressed.get();
+      }
+    }
+
+    std::uint64_t alignedOffset = Align(offset, Alignment);
+    archiveFile.write(padding.data(), alignedOffset - offset);
+    archiveFile.write(storedData, entry.storedSize);
+    entry.offset = alignedOffset;
+    offset = alignedOffset + entry.storedSize;
+
+    newEntries.push_back(entry);
+  }
+
+  auto compareNames = [&newNames](const Entry& a, const Entry& b) {
+    return newNames.compare(
+        a.nameOffset, a.nameSize, newNames, b.nameOffset, b.nameSize);
+  };
+  std::sort(newEntries.begin(),
+            newEntries.end(),
+            [&compareNames](const Entry& a, const Entry& b) {
+              if (a.nameHash != b.nameHash) return a.nameHash < b.nameHash;
+              return compareNames(a, b) < 0;
+            });
+  for (std::size_t i = 1; i < newEntries.size(); ++i) {
+    if (compareNames(newEntries[i - 1], newEntries[i]) == 0) {
+      std::cout << "The file "
+                << newNames.substr(newEntries[i].nameOffset,
+                                   newEntries[i].nameSize)
+                << " is added twice to the resources archive." << std::endl;
+      return false;
+    }
+  }
+
+  std::string directoryData;
+  for (const Entry& entry : newEntries) {
+    AppendUInt64(directoryData, entry.nameHash);
+    AppendUInt64(directoryData, entry.offset);
+    AppendUInt64(directoryData, entry.storedSize);
+    AppendUInt64(directoryData, entry.size);
+    AppendUInt32(directoryData, entry.nameOffset);
+    AppendUInt32(directoryData, entry.nameSize);
+    AppendUInt32(directoryData, entry.compression);
+    AppendUInt32(directoryData, 0);
+  }
+  std::uint64_t directoryOffset = Align(offset, 8);
+  archiveFile.write(padding.data(), directoryOffset - offset);
+  archiveFile.write(directoryData.data(), directoryData.size());
+  archiveFile.write(newNames.data(), newNames.size());
+
+  std::string header(Magic, sizeof(Magic));
+  AppendUInt32(header, Version);
+  AppendUInt32(header, newEntries.size());
+  AppendUInt64(header, directoryOffset);
+  AppendUInt64(header, directoryOffset + directoryData.size());
+  AppendUInt64(header, newNames.size());
+  archiveFile.seekp(0, std::ios::beg);
+  archiveFile.write(header.data(), header.size());
+
+  if (!archiveFile) {
+    std::cout << "Unable to write the resources archive " << destination
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool ResourcesArchive::Open(const gd::String& filename) {
+  Close();
+  mappedFile = MappedFile::Open(filename);
+  if (!mappedFile) return false;
+
+  archive = mappedFile->GetData();
+  archiveSize = mappedFile->GetSize();
+  if (!ReadDirectory()) {
+    std::cout << "Invalid resources archive: " << filename << std::endl;
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void ResourcesArchive::Close() {
+  entries.clear();
+  names = nullptr;
+  archive = nullptr;
+  archiveSize = 0;
+  mappedFile.reset();
+}
+
+bool ResourcesArchive::ReadDirectory() {
+  if (archiveSize < HeaderSize ||
+      memcmp(archive, Magic, sizeof(Magic)) != 0 ||
+      ReadUInt32(archive + 8) != Version)
+    return false;
+
+  std::uint64_t entriesCount = ReadUInt32(archive + 12);
+  std::uint64_t directoryOffset = ReadUInt64(archive + 16);
+  std::uint64_t namesOffset = ReadUInt64(archive + 24);
+  std::uint64_t namesSize = ReadUInt64(archive + 32);
+  if (directoryOffset > archiveSize ||
+      entriesCount > (archiveSize - directoryOffset) / EntrySize ||
+      namesOffset > archiveSize || namesSize > archiveSize - namesOffset)
+    return false;
+
+  names = archive + namesOffset;
+  entries.resize(entriesCount);
+  for (std::size_t i = 0; i < entriesCount; ++i) {
+    const char* data = archive + directoryOffset + i * EntrySize;
+    Entry& entry = entries[i];
+    entry.nameHash = ReadUInt64(data);
+    entry.offset = ReadUInt64(data + 8);
+    entry.storedSize = ReadUInt64(data + 16);
+    entry.size = ReadUInt64(data + 24);
+    entry.nameOffset = ReadUInt32(data + 32);
+    entry.nameSize = ReadUInt32(data + 36);
+    entry.compression = ReadUInt32(data + 40);
+
+    if (entry.offset > archiveSize ||
+        entry.storedSize > archiveSize - entry.offset ||
+        entry.nameOffset > namesSize ||
+        entry.nameSize > namesSize - entry.nameOffset)
+      return false;
+    if (entry.compression == None ? entry.storedSize != entry.size
+                                  : entry.compression != LZ4)
+      return false;
+    // LZ4 can't expand more than 255 times the compressed data: this avoids
+    // allocating huge buffers for corrupted sizes.
+    if (entry.compression == LZ4 && entry.size / 255 > entry.storedSize)
+      return false;
+    if (i > 0 && entries[i - 1].nameHash > entry.nameHash) return false;
+  }
+
+  return true;
+}
+
+std::uint64_t ResourcesArchive::HashName(const char* name, std::size_t size) {
+  // 64 bits FNV-1a
+  std::uint64_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+const ResourcesArchive::Entry* ResourcesArchive::FindEntry(
+    const gd::String& filename) const {
+  const std::string& name = filename.Raw();
+  std::uint64_t hash = HashName(name.data(), name.size());
+  auto it = std::lower_bound(
+      entries.begin(),
+      entries.end(),
+      hash,
+      [](const Entry& entry, std::uint64_t hash) {
+        return entry.nameHash < hash;
+      });
+  for (; it != entries.end() && it->nameHash == hash; ++it) {
+    if (it->nameSize == name.size() &&
+        memcmp(names + it->nameOffset, name.data(), name.size()) == 0)
+      return &*it;
+  }
+
+  return nullptr;
+}
+
+bool ResourcesArchive::ContainsFile(const gd::String& filename) const {
+  return FindEntry(filename) != nullptr;
+}
+
+std::size_t ResourcesArchive::GetFileSize(const gd::String& filename) const {
+  const Entry* entry = FindEntry(filename);
+  return entry ? entry->size : 0;
+}
+
+ResourceData ResourcesArchive::GetFile(const gd::String& filename) const {
+  const Entry* entry = FindEntry(filename);
+  if (!entry) return ResourceData();
+
+  const char* storedData = archive + entry->offset;
+  if (entry->compression == None)
+    return ResourceData(storedData, entry->size);
+
+  std::unique_ptr<char[]> buffer(new char[entry->size]);
+  if (!LZ4Compression::Decompress(
+          storedData, entry->storedSize, buffer.get(), entry->size)) {
+    std::cout << "Unable to decompress " << filename
+              << " from the resources archive." << std::endl;
+    return ResourceData();
+  }
+
+  return ResourceData(std::move(buffer), entry->size);
+}
+
+}  // namespace gd
@@ -0,0 +1,172 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_RESOURCESARCHIVE_H
+#define GDCPP_RESOURCESARCHIVE_H
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+
+namespace gd {
+
+/**
+ * \brief The content of a file, as returned by gd::ResourcesArchive::GetFile
+ * or gd::ResourcesLoader::LoadBinaryFile.
+ *
+ * The data either points directly into the memory-mapped archive, without any
+ * copy (it is then valid as long as the archive is open), or is owned by the
+ * gd::ResourceData (for a file that was compressed or read from the disk).
+ *
+ * \ingroup ResourcesManagement
+ */
+class GD_API ResourceData {
+ public:
+  /**
+   * \brief Construct an invalid gd::ResourceData, used for missing files.
+   */
+  ResourceData() : data(nullptr), size(0) {}
+
+  /**
+   * \brief Construct a gd::ResourceData pointing to memory owned by someone
+   * else.
+   */
+  ResourceData(const char* data_, std::size_t size_)
+      : data(data_), size(size_) {}
+
+  /**
+   * \brief Construct a gd::ResourceData owning its buffer.
+   */
+  ResourceData(std::unique_ptr<char[]> buffer_, std::size_t size_)
+      : buffer(std::move(buffer_)), data(buffer.get()), size(size_) {}
+
+  ResourceData(ResourceData&& other) = default;
+  ResourceData& operator=(ResourceData&& other) = default;
+
+  /**
+   * \brief Return false if the file was not found or could not be read.
+   */
+  bool IsValid() const { return data != nullptr; }
+
+  const char* GetData() const { return data; }
+  std::size_t GetSize() const { return size; }
+
+ private:
+  std::unique_ptr<char[]> buffer;  ///< The data, if owned.
+  const char* data;
+  std::size_t size;
+};
+
+/**
+ * \brief Create and read the archives ("egd" files) storing the resources of
+ * a native game.
+ *
+ * The archive is memory-mapped when opened, and the files that are not
+ * compressed are returned without being copied. Files are found using a
+ * directory sorted by the hash of their names.
+ *
+ * Format (all integers are little-endian):
+ * - Header: "GDRESARC", version (uint32), files count (uint32), offset of the
+ * directory (uint64), offset and size of the names (uint64).
+ * - The content of the files, each aligned on gd::ResourcesArchive::Alignment
+ * bytes, compressed with LZ4 if it saved enough space.
+ * - The directory, with an entry for each file: hash of its name (uint64),
+ * offset and size in the archive (uint64), size once decompressed (uint64),
+ * offset and size of its name (uint32), compression (uint32) and a reserved
+ * uint32.
+ * - The names of the files, encoded in UTF8.
+ *
+ * \ingroup ResourcesManagement
+ */
+class GD_API ResourcesArchive {
+ public:
+  /**
+   * \brief The alignment of the content of each file in the archive.
+   */
+  static const std::size_t Alignment = 64;
+
+  ResourcesArchive();
+  ~ResourcesArchive();
+
+  ResourcesArchive(const ResourcesArchive&) = delete;
+  ResourcesArchive& operator=(const ResourcesArchive&) = delete;
+
+  /**
+   * \brief Create an archive containing the given files.
+   *
+   * \param files The files to be stored, relative to \a directory. They are
+   * stored with these names.
+   * \param compress If true, the files are compressed, unless compression does
+   * not save at least an eighth of their size (like for images or sounds which
+   * are usually already compressed).
+   * \return true if the archive was successfully written.
+   */
+  static bool Create(const std::vector<gd::String>& files,
+                     const gd::String& directory,
+                     const gd::String& destination,
+                     bool compress = true);
+
+  /**
+   * \brief Open an archive, closing the one previously opened if any.
+   * \return true if the archive was successfully opened and is valid.
+   */
+  bool Open(const gd::String& filename);
+
+  /**
+   * \brief Close the archive. The files returned without copy are not valid
+   * anymore.
+   */
+  void Close();
+
+  bool IsOpen() const { return archive != nullptr; }
+
+  /**
+   * \brief Return the number of files in the archive.
+   */
+  std::size_t GetFilesCount() const { return entries.size(); }
+
+  bool ContainsFile(const gd::String& filename) const;
+
+  /**
+   * \brief Return the size of the file, once decompressed, or 0 if the file is
+   * not in the archive.
+   */
+  std::size_t GetFileSize(const gd::String& filename) const;
+
+  /**
+   * \brief Return the content of a file, or an invalid gd::ResourceData if
+   * the file is not in the archive or could not be decompressed.
+   */
+  ResourceData GetFile(const gd::String& filename) const;
+
+ private:
+  enum Compression { None = 0, LZ4 = 1 };
+
+  struct Entry {
+    std::uint64_t nameHash;
+    std::uint64_t offset;
+    std::uint64_t storedSize;  ///< The size in the archive.
+    std::uint64_t size;        ///< The size once decompressed.
+    std::uint32_t nameOffset;
+    std::uint32_t nameSize;
+    std::uint32_t compression;
+  };
+
+  class MappedFile;
+
+  const Entry* FindEntry(const gd::String& filename) const;
+  bool ReadDirectory();
+  static std::uint64_t HashName(const char* name, std::size_t size);
+
+  std::unique_ptr<MappedFile> mappedFile;
+  const char* archive;         ///< The content of the archive.
+  std::size_t archiveSize;     ///< The size of the archive.
+  const char* names;           ///< The names of the files, in the archive.
+  std::vector<Entry> entries;  ///< Sorted by the hash of their names.
+};
+
+}  // namespace gd
+
+#endif  // GDCPP_RESOURCESARCHIVE_H
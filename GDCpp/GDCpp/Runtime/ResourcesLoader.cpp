@@ -10,8 +10,10 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
+#include "GDCpp/Runtime/FrameProfiler.h"
 #include "GDCpp/Runtime/Music.h"
 #undef LoadImage  // Undef a macro from windows.h
 #if defined(ANDROID)
@@ -25,7 +27,7 @@ namespace gd {
 ResourcesLoader* ResourcesLoader::_singleton = NULL;
 
 bool ResourcesLoader::SetResourceFile(const gd::String& filename) {
-  if (resFile.Read(filename)) {
+  if (resFile.Open(filename)) {
     std::cout << "Resource file set to " << filename << std::endl;
     return true;
   }
@@ -35,13 +37,13 @@ bool ResourcesLoader::SetResourceFile(const gd::String& filename) {
 
 void ResourcesLoader::LoadSFMLImage(const gd::String& filename,
                                     sf::Image& image) {
+  GD_PROFILE_SCOPE("Load image");
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
+    gd::ResourceData data = resFile.GetFile(filename);
+    if (!data.IsValid())
       cout << "Failed to get the file of a SFML image from resource file: "
            << filename << endl;
-
-    if (!image.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+    else if (!image.loadFromMemory(data.GetData(), data.GetSize()))
       cout << "Failed to load a SFML image from resource file: " << filename
            << endl;
   } else {
@@ -61,13 +63,13 @@ sf::Texture ResourcesLoader::LoadSFMLTexture(const gd::String& filename) {
 
 void ResourcesLoader::LoadSFMLTexture(const gd::String& filename,
                                       sf::Texture& texture) {
+  GD_PROFILE_SCOPE("Load texture");
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
+    gd::ResourceData data = resFile.GetFile(filename);
+    if (!data.IsValid())
       cout << "Failed to get the file of a SFML texture from resource file: "
            << filename << endl;
-
-    if (!texture.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+    else if (!texture.loadFromMemory(data.GetData(), data.GetSize()))
       cout << "Failed to load a SFML texture from resource file: " << filename
            << endl;
   } else {
@@ -79,28 +81,26 @@ void ResourcesLoader::LoadSFMLTexture(const gd::String& filename,
 
 std::pair<sf::Font*, StreamHolder*> ResourcesLoader::LoadFont(
     const gd::String& filename) {
+  GD_PROFILE_SCOPE("Load font");
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    size_t bufferSize = resFile.GetFileSize(filename);
-    if (buffer == nullptr) {
+    gd::ResourceData data = resFile.GetFile(filename);
+    if (!data.IsValid()) {
       cout << "Failed to get the file of a font from resource file:" << filename
            << endl;
       return std::make_pair((sf::Font*)nullptr, (StreamHolder*)nullptr);
     }
 
+    // The font reads its data when needed: the data is kept in the
+    // StreamHolder, unless it's directly pointing into the archive.
     sf::Font* font = new sf::Font();
-    char* fontBuffer = new char[bufferSize];
-    memcpy(fontBuffer, buffer, bufferSize);
-
-    if (!font->loadFromMemory(fontBuffer, bufferSize)) {
+    if (!font->loadFromMemory(data.GetData(), data.GetSize())) {
       cout << "Failed to load a font from resource file: " << filename << endl;
       delete font;
-      delete fontBuffer;
       return std::make_pair((sf::Font*)nullptr, (StreamHolder*)nullptr);
     }
 
     StreamHolder* streamHolder = new StreamHolder();
-    streamHolder->buffer = fontBuffer;
+    streamHolder->data = std::move(data);
     return std::make_pair(font, streamHolder);
   } else {
     sf::Font* font = new sf::Font();
@@ -119,15 +119,15 @@ std::pair<sf::Font*, StreamHolder*> ResourcesLoader::LoadFont(
 }
 
 sf::SoundBuffer ResourcesLoader::LoadSoundBuffer(const gd::String& filename) {
+  GD_PROFILE_SCOPE("Load sound");
   sf::SoundBuffer sbuffer;
 
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
+    gd::ResourceData data = resFile.GetFile(filename);
+    if (!data.IsValid())
       cout << "Failed to get the file of a sound buffer from resource file: "
            << filename << endl;
-
-    if (!sbuffer.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+    else if (!sbuffer.loadFromMemory(data.GetData(), data.GetSize()))
       cout << "Failed to load a sound buffer from resource file: " << filename
            << endl;
   } else {
@@ -140,24 +140,14 @@ sf::SoundBuffer ResourcesLoader::LoadSoundBuffer(const gd::String& filename) {
 }
 
 gd::String ResourcesLoader::LoadPlainText(const gd::String& filename) {
+  GD_PROFILE_SCOPE("Load text file");
   gd::String text;
 
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (!buffer) {
-      cout << "Failed to read a file from resource file: " << filename << endl;
-    } else {
-      text = gd::String::FromUTF8(std::string(buffer));
-    }
-  } else {
-    char* buffer = LoadBinaryFile(filename);
-    if (!buffer)
-      cout << "Failed to read plain text from a file: " << filename << endl;
-    else {
-      text = gd::String::FromUTF8(std::string(buffer));
-      delete[] buffer;
-    }
-  }
+  gd::ResourceData data = LoadBinaryFile(filename);
+  if (!data.IsValid())
+    cout << "Failed to read plain text from a file: " << filename << endl;
+  else
+    text = gd::String::FromUTF8(std::string(data.GetData(), data.GetSize()));
 
   return text;
 }
@@ -165,40 +155,41 @@ gd::String ResourcesLoader::LoadPlainText(const gd::String& filename) {
 /**
  * Load a binary text file
  */
-char* ResourcesLoader::LoadBinaryFile(const gd::String& filename) {
+gd::ResourceData ResourcesLoader::LoadBinaryFile(const gd::String& filename) {
+  GD_PROFILE_SCOPE("Load binary file");
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
+    gd::ResourceData data = resFile.GetFile(filename);
+    if (!data.IsValid())
       cout << "Failed to read a binary file from resource file: " << filename
            << endl;
 
-    return buffer;
+    return data;
   } else {
 #if defined(ANDROID)
     sf::FileInputStream file;
     if (file.open(filename.ToLocale())) {
       sf::Int64 size = file.getSize();
-      char* memblock = new char[size];
+      std::unique_ptr<char[]> memblock(new char[size]);
 
-      file.read(memblock, size);
-      return memblock;
+      file.read(memblock.get(), size);
+      return gd::ResourceData(std::move(memblock), size);
     }
 #else  // TODO: Also use the SFML implementation?
     gd::FileStream file(filename, ios::in | ios::binary | ios::ate);
     if (file.is_open()) {
       ifstream::pos_type size = file.tellg();
-      char* memblock = new char[size];
+      std::unique_ptr<char[]> memblock(new char[size]);
       file.seekg(0, ios::beg);
-      file.read(memblock, size);
+      file.read(memblock.get(), size);
       file.close();
 
-      return memblock;
+      return gd::ResourceData(std::move(memblock), size);
     }
 #endif
   }
 
   cout << "Binary file " << filename << " can't be loaded into memory " << endl;
-  return NULL;
+  return gd::ResourceData();
 }
 
 long int ResourcesLoader::GetBinaryFileSize(const gd::String& filename) {
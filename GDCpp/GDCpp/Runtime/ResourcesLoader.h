@@ -12,7 +12,7 @@
 #ifndef RESSOURCESLOADER_H
 #define RESSOURCESLOADER_H
 
-#include "GDCpp/Runtime/DatFile.h"
+#include "GDCpp/Runtime/ResourcesArchive.h"
 class Music;
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
@@ -28,17 +28,16 @@ namespace gd {
  * that needs their buffer/stream continuously opened)
  */
 struct StreamHolder {
-  StreamHolder() : buffer(nullptr), stream() {}
-  ~StreamHolder() {
-    if (buffer) delete buffer;
-  }
-
-  char *buffer;
+  gd::ResourceData data;
   gd::SFMLFileStream stream;
 };
 
 /**
- * \brief Class used by games to load resources from files or from a DatFile.
+ * \brief Class used by games to load resources from files or from a resources
+ * archive (see gd::ResourcesArchive).
+ *
+ * Files in the archive are given to SFML without any copy, unless they are
+ * compressed.
  * \note See GDCore documentation for the documentation of most functions.
  *
  * \ingroup ResourcesManagement
@@ -62,7 +61,14 @@ class GD_API ResourcesLoader {
 
   gd::String LoadPlainText(const gd::String &filename);
 
-  char *LoadBinaryFile(const gd::String &filename);
+  /**
+   * \brief Return the content of a file, from the resources archive if it's
+   * in it.
+   *
+   * \note The content of a file read from the resources archive is valid as
+   * long as the archive is open.
+   */
+  gd::ResourceData LoadBinaryFile(const gd::String &filename);
 
   long int GetBinaryFileSize(const gd::String &filename);
 
@@ -87,7 +93,8 @@ class GD_API ResourcesLoader {
   ResourcesLoader(){};
   virtual ~ResourcesLoader(){};
 
-  DatFile resFile;  ///< Used to load data from a single resource file.
+  gd::ResourcesArchive resFile;  ///< Used to load data from a single resource
+                                ///< file.
 
   static ResourcesLoader *_singleton;
 };
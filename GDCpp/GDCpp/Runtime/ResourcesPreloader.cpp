@@ -0,0 +1,173 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include <unordered_set>
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Direction.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/Project/Layout.h"
+#include "GDCpp/Runtime/Project/Project.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+#include "GDCpp/Runtime/ResourcesLoader.h"
+
+namespace gd {
+
+ResourcesPreloader::ResourcesPreloader(std::size_t threadsCount)
+    : decodedCount(0),
+      uploadedCount(0),
+      firstNotUploaded(0),
+      cancelled(false) {
+  jobsPool.SetThreadsCount(threadsCount);
+}
+
+ResourcesPreloader::~ResourcesPreloader() { Clear(); }
+
+void ResourcesPreloader::PreloadLayout(const gd::Project& project,
+                                       const gd::Layout& layout) {
+  Preload(project, GetLayoutImages(project, layout));
+  layoutName = layout.GetName();
+}
+
+void ResourcesPreloader::Preload(const gd::Project& project,
+                                 const std::vector<gd::String>& imageNames) {
+  Clear();
+
+  const gd::ResourcesManager& resources = project.GetResourcesManager();
+  const std::shared_ptr<gd::ImageManager>& imageManager =
+      project.GetImageManager();
+  for (const gd::String& name : imageNames) {
+    if (imageManager && imageManager->HasLoadedSFMLTexture(name)) continue;
+    if (!resources.HasResource(name)) continue;
+
+    const gd::ImageResource* resource =
+        dynamic_cast<const gd::ImageResource*>(&resources.GetResource(name));
+    if (!resource) continue;
+
+    images.push_back(Image{
+        name, resource->GetFile(), std::make_shared<SFMLTextureWrapper>(), false});
+  }
+  if (images.empty()) return;
+
+  decoded.reset(new std::atomic<bool>[images.size()]);
+  for (std::size_t i = 0; i < images.size(); ++i) decoded[i] = false;
+
+  ResourcesLoader::Get();  // Create the singleton before the threads use it.
+  loadingThread = std::thread(&ResourcesPreloader::DecodeImages, this);
+}
+
+void ResourcesPreloader::DecodeImages() {
+  jobsPool.ParallelFor(
+      images.size(), 1, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end && !cancelled; ++i) {
+          ResourcesLoader::Get()->LoadSFMLImage(images[i].file,
+                                                images[i].texture->image);
+          decoded[i] = true;
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++decodedCount;
+          }
+          imageDecoded.notify_all();
+        }
+      });
+}
+
+float ResourcesPreloader::GetProgress() const {
+  if (images.empty()) return 1.f;
+
+  return (0.9f * decodedCount + 0.1f * uploadedCount) / images.size();
+}
+
+std::size_t ResourcesPreloader::UploadImages(gd::ImageManager& imageManager,
+                                             std::size_t maxCount) {
+  std::size_t count = 0;
+  for (std::size_t i = firstNotUploaded; i < images.size() && count < maxCount;
+       ++i) {
+    Image& image = images[i];
+    if (image.uploaded || !decoded[i]) continue;
+
+    image.texture = imageManager.AddDecodedTexture(image.name, image.texture);
+    image.uploaded = true;
+    ++uploadedCount;
+    ++count;
+  }
+
+  while (firstNotUploaded < images.size() && images[firstNotUploaded].uploaded)
+    ++firstNotUploaded;
+
+  return count;
+}
+
+void ResourcesPreloader::Finish(gd::ImageManager& imageManager) {
+  while (uploadedCount < images.size()) {
+    UploadImages(imageManager);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    imageDecoded.wait(lock, [this]() {
+      return decodedCount > uploadedCount || uploadedCount == images.size();
+    });
+  }
+
+  if (loadingThread.joinable()) loadingThread.join();
+}
+
+void ResourcesPreloader::Clear() {
+  if (loadingThread.joinable()) {
+    cancelled = true;
+    loadingThread.join();
+    cancelled = false;
+  }
+
+  images.clear();
+  decoded.reset();
+  decodedCount = 0;
+  uploadedCount = 0;
+  firstNotUploaded = 0;
+  layoutName.clear();
+}
+
+std::vector<std::shared_ptr<SFMLTextureWrapper>>
+ResourcesPreloader::TakeTextures() {
+  std::vector<std::shared_ptr<SFMLTextureWrapper>> textures;
+  textures.reserve(uploadedCount);
+  for (Image& image : images)
+    if (image.uploaded) textures.push_back(std::move(image.texture));
+
+  Clear();
+  return textures;
+}
+
+std::vector<gd::String> ResourcesPreloader::GetLayoutImages(
+    const gd::Project& project, const gd::Layout& layout) {
+  std::vector<gd::String> imageNames;
+  std::unordered_set<gd::String> alreadyAdded;
+  auto addImages = [&](const gd::ObjectsContainer& objects) {
+    for (std::size_t i = 0; i < objects.GetObjectsCount(); ++i) {
+      const gd::SpriteObject* object =
+          dynamic_cast<const gd::SpriteObject*>(&objects.GetObject(i));
+      if (!object) continue;
+
+      for (std::size_t a = 0; a < object->GetAnimationsCount(); ++a) {
+        const gd::Animation& animation = object->GetAnimation(a);
+        for (std::size_t d = 0; d < animation.GetDirectionsCount(); ++d) {
+          const gd::Direction& direction = animation.GetDirection(d);
+          for (std::size_t s = 0; s < direction.GetSpritesCount(); ++s) {
+            const gd::String& name = direction.GetSprite(s).GetImageName();
+            if (!name.empty() && alreadyAdded.insert(name).second)
+              imageNames.push_back(name);
+          }
+        }
+      }
+    }
+  };
+
+  addImages(layout);
+  addImages(project);
+  return imageNames;
+}
+
+}  // namespace gd
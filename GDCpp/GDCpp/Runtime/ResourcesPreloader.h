@@ -0,0 +1,173 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_RESOURCESPRELOADER_H
+#define GDCPP_RESOURCESPRELOADER_H
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GDCpp/Runtime/JobsPool.h"
+#include "GDCpp/Runtime/String.h"
+namespace gd {
+class ImageManager;
+class Layout;
+class Project;
+}
+class SFMLTextureWrapper;
+
+namespace gd {
+
+/**
+ * \brief Decode in background, using several threads, the images that a
+ * layout is about to use, so that starting the layout does not wait for all
+ * its images to be loaded one after the other.
+ *
+ * The images are decoded by a JobsPool run by a background thread, while
+ * the game keeps running (showing a loading screen for example, which can
+ * poll GetProgress). The textures are then created by UploadImages which,
+ * as it uploads them to the GPU, must be called by the thread rendering the
+ * game.
+ *
+ * The textures uploaded are kept alive until Clear or TakeTextures is called
+ * (or another preloading starts), so that they are found by gd::ImageManager
+ * when the objects of the layout are created.
+ *
+ * \see SceneStack::PreloadScene
+ * \ingroup ResourcesManagement
+ */
+class GD_API ResourcesPreloader {
+ public:
+  /**
+   * \param threadsCount The number of threads decoding the images. 0 means the
+   * number of hardware threads.
+   */
+  ResourcesPreloader(std::size_t threadsCount = 0);
+  ~ResourcesPreloader();
+
+  ResourcesPreloader(const ResourcesPreloader&) = delete;
+  ResourcesPreloader& operator=(const ResourcesPreloader&) = delete;
+
+  /**
+   * \brief Start decoding the images used by the objects of a layout (and by
+   * the global objects), stopping the preloading in progress if any.
+   *
+   * Images already loaded by the image manager of the project are skipped.
+   */
+  void PreloadLayout(const gd::Project& project, const gd::Layout& layout);
+
+  /**
+   * \brief Start decoding the given images, stopping the preloading in
+   * progress if any.
+   *
+   * Images already loaded by the image manager of the project are skipped.
+   */
+  void Preload(const gd::Project& project,
+               const std::vector<gd::String>& imageNames);
+
+  /**
+   * \brief Return the name of the layout being preloaded, or an empty string
+   * if the images being preloaded were not given by PreloadLayout.
+   */
+  const gd::String& GetPreloadedLayoutName() const { return layoutName; }
+
+  /**
+   * \brief Return the number of images being preloaded.
+   */
+  std::size_t GetImagesCount() const { return images.size(); }
+
+  /**
+   * \brief Return the number of images decoded so far.
+   * \note Can be called by any thread.
+   */
+  std::size_t GetDecodedImagesCount() const { return decodedCount; }
+
+  /**
+   * \brief Return the number of images whose texture was created.
+   */
+  std::size_t GetUploadedImagesCount() const { return uploadedCount; }
+
+  /**
+   * \brief Return the progress of the preloading, between 0 and 1: the
+   * decoding counts for 90% of it, the upload of the textures for the rest.
+   */
+  float GetProgress() const;
+
+  /**
+   * \brief Return true if all the images are decoded and uploaded.
+   */
+  bool IsDone() const { return uploadedCount == images.size(); }
+
+  /**
+   * \brief Create the textures of the images decoded so far, and add them to
+   * the image manager.
+   *
+   * \warning Must be called by the thread rendering the game.
+   * \param maxCount The maximum number of textures to create, to spread the
+   * upload over several frames.
+   * \return The number of textures created.
+   */
+  std::size_t UploadImages(
+      gd::ImageManager& imageManager,
+      std::size_t maxCount = std::numeric_limits<std::size_t>::max());
+
+  /**
+   * \brief Wait for all the images to be decoded, creating their textures as
+   * soon as they are decoded.
+   *
+   * \warning Must be called by the thread rendering the game.
+   */
+  void Finish(gd::ImageManager& imageManager);
+
+  /**
+   * \brief Stop the preloading and release the textures created. Textures used
+   * by objects stay loaded, the others are unloaded.
+   */
+  void Clear();
+
+  /**
+   * \brief Stop the preloading, like Clear, but return the textures created
+   * instead of releasing them, so that they can be kept loaded as long as
+   * needed (for example by the scene using them).
+   */
+  std::vector<std::shared_ptr<SFMLTextureWrapper>> TakeTextures();
+
+  /**
+   * \brief Return the names of the images used by the sprites of the objects
+   * of a layout, and of the global objects, without duplicates.
+   */
+  static std::vector<gd::String> GetLayoutImages(const gd::Project& project,
+                                                 const gd::Layout& layout);
+
+ private:
+  struct Image {
+    gd::String name;
+    gd::String file;
+    std::shared_ptr<SFMLTextureWrapper> texture;
+    bool uploaded;
+  };
+
+  void DecodeImages();
+
+  std::vector<Image> images;
+  std::unique_ptr<std::atomic<bool>[]> decoded;  ///< One flag per image.
+  std::atomic<std::size_t> decodedCount;
+  std::size_t uploadedCount;
+  std::size_t firstNotUploaded;  ///< Images before are all uploaded.
+  std::atomic<bool> cancelled;
+  gd::String layoutName;
+
+  JobsPool jobsPool;           ///< Used by loadingThread to decode images.
+  std::thread loadingThread;
+  std::mutex mutex;
+  std::condition_variable imageDecoded;  ///< Notified after each image.
+};
+
+}  // namespace gd
+
+#endif  // GDCPP_RESOURCESPRELOADER_H
@@ -22,7 +22,7 @@ class RuntimeScene;
 class GD_CORE_API RuntimeBehavior {
  public:
   RuntimeBehavior(const gd::SerializerElement& behaviorContent)
-      : activated(true){
+      : activated(true), objectLocal(false){
         };
   virtual ~RuntimeBehavior();
   virtual RuntimeBehavior* Clone() const { return new RuntimeBehavior(*this); }
@@ -77,6 +77,22 @@ class GD_CORE_API RuntimeBehavior {
    */
   inline bool Activated() const { return activated; };
 
+  /**
+   * \brief Return true if the behavior only modifies its owner when stepped,
+   * so that it can be stepped in parallel with the other objects behaviors.
+   *
+   * \see gd::BehaviorMetadata::SetObjectLocal
+   */
+  bool IsObjectLocal() const { return objectLocal; }
+
+  /**
+   * \brief Set if the behavior only modifies its owner when stepped.
+   *
+   * Called by the platform when the behavior is created, according to the
+   * behavior metadata.
+   */
+  void SetObjectLocal(bool enable = true) { objectLocal = enable; }
+
   /**
    * Reimplement this method to do extra work when the behavior is activated
    */
@@ -105,6 +121,7 @@ class GD_CORE_API RuntimeBehavior {
   gd::String name;        ///< Name of the behavior
   RuntimeObject* object;  ///< Object owning the behavior
   bool activated;         ///< True if behavior is running
+  bool objectLocal;       ///< True if behavior can be stepped in parallel
 };
 
 #endif  // RUNTIMEBEHAVIOR_H
@@ -25,6 +25,11 @@ std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
   return scene->objectsInstances.GetObjectsRawPointers(name);
 }
 
+std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
+    std::size_t nameId) {
+  return scene->objectsInstances.GetObjectsRawPointers(nameId);
+}
+
 RuntimeVariablesContainer &RuntimeContext::GetSceneVariables() {
   return scene->GetVariables();
 }
@@ -30,6 +30,12 @@ class GD_API RuntimeContext {
    */
   std::vector<RuntimeObject *> GetObjectsRawPointers(const gd::String &name);
 
+  /**
+   * \brief Shortcut to get a "raw pointers" list to objects with a specific
+   * name identifier (see NamesTable). Used by the events generated code.
+   */
+  std::vector<RuntimeObject *> GetObjectsRawPointers(std::size_t nameId);
+
   /**
    * \brief Shortcut for scene->GetVariables();
    */
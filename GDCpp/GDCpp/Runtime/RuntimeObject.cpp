@@ -13,6 +13,7 @@
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Extensions/CppPlatform.h"
 #include "GDCpp/Runtime/CommonTools.h"
+#include "GDCpp/Runtime/NamesTable.h"
 #include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/Project/Behavior.h"
@@ -25,11 +26,16 @@ using namespace std;
 RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
     : name(object.GetName()),
       type(object.GetType()),
-      X(0),
-      Y(0),
       zOrder(0),
       hidden(false),
-      objectVariables(object.GetVariables()) {
+      renderingOrderChanged(true),
+      objectVariables(object.GetVariables()),
+      instancesListNameId(0),
+      instancesListIndex(0),
+      removedFromInstancesHolder(false),
+      transforms(scene.GetObjectsTransforms()),
+      transformsSlot(transforms->AllocateSlot()) {
+  transforms->SetLayerNameId(transformsSlot, NamesTable::GetId(layer));
   ClearForce();
 
   // Create the behaviors
@@ -44,28 +50,51 @@ RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
   }
 }
 
-RuntimeObject::~RuntimeObject() {}
+RuntimeObject::~RuntimeObject() { transforms->ReleaseSlot(transformsSlot); }
+
+void RuntimeObject::MoveToObjectsTransforms(
+    const std::shared_ptr<ObjectsTransforms> &newTransforms) {
+  if (newTransforms != transforms) {
+    std::size_t newSlot = newTransforms->AllocateSlot();
+    newTransforms->SetX(newSlot, GetX());
+    newTransforms->SetY(newSlot, GetY());
+    newTransforms->SetForce(newSlot, TotalForceX(), TotalForceY());
+    newTransforms->SetLayerNameId(newSlot, NamesTable::GetId(layer));
+
+    transforms->ReleaseSlot(transformsSlot);
+    transforms = newTransforms;
+    transformsSlot = newSlot;
+  }
+
+  transforms->SetInScene(transformsSlot, true);
+}
 
 void RuntimeObject::Init(const RuntimeObject &object) {
   name = object.name;
   type = object.type;
   objectVariables = object.objectVariables;
 
-  X = object.X;
-  Y = object.Y;
+  transforms->SetX(transformsSlot, object.GetX());
+  transforms->SetY(transformsSlot, object.GetY());
   zOrder = object.zOrder;
   hidden = object.hidden;
   layer = object.layer;
+  transforms->SetLayerNameId(transformsSlot, NamesTable::GetId(layer));
+  renderingOrderChanged = true;
   force5 = object.force5;
   forces = object.forces;
+  UpdateTotalForce();
 
   // Clone behaviors
   behaviors.clear();
+  behaviorsByNameId.clear();
   for (auto it = object.behaviors.cbegin(); it != object.behaviors.cend();
        ++it) {
     behaviors[it->first] =
         gd::make_unique<RuntimeBehavior>(*it->second->Clone());
     behaviors[it->first]->SetOwner(this);
+    behaviorsByNameId.push_back(std::make_pair(
+        NamesTable::GetId(it->first), behaviors[it->first].get()));
   }
 }
 
@@ -76,6 +105,15 @@ void RuntimeObject::AddBehavior(const gd::String &name,
                                 std::unique_ptr<RuntimeBehavior> behavior) {
   behaviors[name] = std::move(behavior);
   behaviors[name]->SetOwner(this);
+
+  std::size_t nameId = NamesTable::GetId(name);
+  for (auto &it : behaviorsByNameId) {
+    if (it.first == nameId) {
+      it.second = behaviors[name].get();
+      return;
+    }
+  }
+  behaviorsByNameId.push_back(std::make_pair(nameId, behaviors[name].get()));
 };
 
 #if defined(GD_IDE_ONLY)
@@ -137,7 +175,7 @@ bool RuntimeObject::ChangeProperty(std::size_t propertyNb,
     } else
       SetHidden(false);
   } else if (propertyNb == 4) {
-    layer = newValue;
+    SetLayer(newValue);
   } else if (propertyNb == 5) {
     SetZOrder(newValue.To<int>());
   } else if (propertyNb == 6) {
@@ -187,8 +225,17 @@ void RuntimeObject::PutAroundAPosition(float positionX,
        (GetDrawableY() + GetCenterY()));
 }
 
+void RuntimeObject::SetLayer(const gd::String &layer_) {
+  if (layer == layer_) return;
+
+  renderingOrderChanged = true;
+  layer = layer_;
+  transforms->SetLayerNameId(transformsSlot, NamesTable::GetId(layer));
+}
+
 void RuntimeObject::AddForce(float x, float y, float clearing) {
   forces.push_back(Force(x, y, clearing));
+  UpdateTotalForce();
 }
 
 void RuntimeObject::AddForceUsingPolarCoordinates(float angle,
@@ -196,6 +243,7 @@ void RuntimeObject::AddForceUsingPolarCoordinates(float angle,
                                                   float clearing) {
   angle *= 3.14159 / 180.0;
   forces.push_back(Force(cos(angle) * length, sin(angle) * length, clearing));
+  UpdateTotalForce();
 }
 /**
  * Add a force toward a position
@@ -210,6 +258,7 @@ void RuntimeObject::AddForceTowardPosition(float positionX,
   float angle = atan2(y, x);
 
   forces.push_back(Force(cos(angle) * length, sin(angle) * length, clearing));
+  UpdateTotalForce();
 }
 
 void RuntimeObject::AddForceToMoveAround(float positionX,
@@ -234,6 +283,7 @@ void RuntimeObject::AddForceToMoveAround(float positionX,
   int newY = sin(newangle / 180.f * 3.14159f) * distance;
 
   forces.push_back(Force(newX - oldX, newY - oldY, clearing));
+  UpdateTotalForce();
 }
 
 void RuntimeObject::Duplicate(
@@ -321,8 +371,10 @@ bool RuntimeObject::SeparateFromObjects(
   sf::Vector2f moveVector;
   for (std::size_t j = 0; j < objects.size(); ++j) {
     if (objects[j] != this) {
-      std::vector<Polygon2d> hitBoxes = GetHitBoxes(objects[j]->GetAABB());
-      vector<Polygon2d> otherHitBoxes = objects[j]->GetHitBoxes(GetAABB());
+      const std::vector<Polygon2d> &hitBoxes =
+          GetHitBoxes(objects[j]->GetAABB());
+      const std::vector<Polygon2d> &otherHitBoxes =
+          objects[j]->GetHitBoxes(GetAABB());
       for (std::size_t k = 0; k < hitBoxes.size(); ++k) {
         for (std::size_t l = 0; l < otherHitBoxes.size(); ++l) {
           CollisionResult result = PolygonCollisionTest(
@@ -410,22 +462,19 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject *obj2,
   sf::FloatRect objRect = obj1->GetAABB();
   sf::FloatRect obj2Rect = obj2->GetAABB();
 
-  vector<Polygon2d> objHitboxes = obj1->GetHitBoxes(obj2Rect);
-  vector<Polygon2d> obj2Hitboxes = obj2->GetHitBoxes(objRect);
+  const vector<Polygon2d> &objHitboxes = obj1->GetHitBoxes(obj2Rect);
+  const vector<Polygon2d> &obj2Hitboxes = obj2->GetHitBoxes(objRect);
   for (std::size_t k = 0; k < objHitboxes.size(); ++k) {
-    for (std::size_t l = 0; l < obj2Hitboxes.size(); ++l) {
-      if (PolygonCollisionTest(
-              objHitboxes[k], obj2Hitboxes[l], ignoreTouchingEdges)
-              .collision)
-        return true;
-    }
+    if (PolygonsCollisionTest(
+            objHitboxes[k], obj2Hitboxes, ignoreTouchingEdges))
+      return true;
   }
 
   return false;
 }
 
 bool RuntimeObject::IsCollidingWithPoint(float pointX, float pointY) {
-  vector<Polygon2d> hitBoxes = GetHitBoxes();
+  const vector<Polygon2d> &hitBoxes = GetHitBoxes();
   for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
     if (IsPointInsidePolygon(hitBoxes[i], pointX, pointY)) return true;
   }
@@ -451,7 +500,7 @@ RaycastResult RuntimeObject::RaycastTest(
 
   float testSqDist = closest ? sqDist : 0.0f;
 
-  vector<Polygon2d> hitboxes = GetHitBoxes();
+  const vector<Polygon2d> &hitboxes = GetHitBoxes();
   for (std::size_t i = 0; i < hitboxes.size(); ++i) {
     RaycastResult res = PolygonRaycastTest(hitboxes[i], x, y, endX, endY);
 
@@ -536,12 +585,14 @@ void RuntimeObject::SeparateObjectsWithForces(
       } else {
         if (force5.GetX() == 0) force5.SetX(-(TotalForceX()) + 10);
       }
+      UpdateTotalForce();
 
       if (Yobj1 < Yobj2) {
         if (force5.GetY() == 0) force5.SetY(-(TotalForceY()) - 10);
       } else {
         if (force5.GetY() == 0) force5.SetY(-(TotalForceY()) + 10);
       }
+      UpdateTotalForce();
     }
   }
 }
@@ -626,17 +677,26 @@ sf::FloatRect RuntimeObject::GetAABB() const {
   return resultTransform.transformRect(notTransformedAABB);
 }
 
-std::vector<Polygon2d> RuntimeObject::GetHitBoxes() const {
-  std::vector<Polygon2d> mask;
-  Polygon2d rectangle = Polygon2d::CreateRectangle(GetWidth(), GetHeight());
+const std::vector<Polygon2d> &RuntimeObject::GetHitBoxes() const {
+  // The rectangle is computed at each call, as the width, height and angle
+  // are given by the derived classes, but its storage is reused.
+  float halfWidth = GetWidth() / 2.0f;
+  float halfHeight = GetHeight() / 2.0f;
+  defaultHitBoxes.resize(1);
+  Polygon2d &rectangle = defaultHitBoxes[0];
+  rectangle.vertices.resize(4);
+  rectangle.vertices[0] = sf::Vector2f(-halfWidth, -halfHeight);
+  rectangle.vertices[1] = sf::Vector2f(+halfWidth, -halfHeight);
+  rectangle.vertices[2] = sf::Vector2f(+halfWidth, +halfHeight);
+  rectangle.vertices[3] = sf::Vector2f(-halfWidth, +halfHeight);
   rectangle.Rotate(GetAngle() / 180 * 3.14159);
   rectangle.Move(GetX() + GetCenterX(), GetY() + GetCenterY());
 
-  mask.push_back(rectangle);
-  return mask;
+  return defaultHitBoxes;
 }
 
-std::vector<Polygon2d> RuntimeObject::GetHitBoxes(sf::FloatRect hint) const {
+const std::vector<Polygon2d> &RuntimeObject::GetHitBoxes(
+    sf::FloatRect hint) const {
   return GetHitBoxes();
 }
 
@@ -676,11 +736,22 @@ RuntimeBehavior *RuntimeObject::GetBehaviorRawPointer(
   return behaviors.find(name)->second.get();
 }
 
+RuntimeBehavior *RuntimeObject::GetBehaviorRawPointer(
+    std::size_t nameId) const {
+  // Objects have only a few behaviors: a linear search is faster than any
+  // associative container.
+  for (auto &it : behaviorsByNameId)
+    if (it.first == nameId) return it.second;
+
+  return nullptr;
+}
+
 bool RuntimeObject::ClearForce() {
   force5.SetLength(0);  // Clear the deprecated force
   force5.SetClearing(0);
 
   forces.clear();
+  UpdateTotalForce();
 
   return true;
 }
@@ -701,24 +772,22 @@ bool RuntimeObject::UpdateForce(float elapsedTime) {
       ++i;
     }
   }
+  UpdateTotalForce();
 
   return true;
 }
 
-float RuntimeObject::TotalForceX() const {
+void RuntimeObject::UpdateTotalForce() {
   float ForceXsimple = 0;
-  for (std::size_t i = 0; i < forces.size(); i++)
-    ForceXsimple += forces[i].GetX();
-
-  return ForceXsimple + force5.GetX();
-}
-
-float RuntimeObject::TotalForceY() const {
   float ForceYsimple = 0;
-  for (std::size_t i = 0; i < forces.size(); i++)
+  for (std::size_t i = 0; i < forces.size(); i++) {
+    ForceXsimple += forces[i].GetX();
     ForceYsimple += forces[i].GetY();
+  }
 
-  return ForceYsimple + force5.GetY();
+  transforms->SetForce(transformsSlot,
+                       ForceXsimple + force5.GetX(),
+                       ForceYsimple + force5.GetY());
 }
 
 float RuntimeObject::TotalForceAngle() const {
@@ -747,6 +816,13 @@ void RuntimeObject::DoBehaviorsPostEvents(RuntimeScene &scene) {
     it->second->StepPostEvents(scene);
 }
 
+bool RuntimeObject::HasOnlyObjectLocalBehaviors() const {
+  for (auto it = behaviors.cbegin(); it != behaviors.cend(); ++it)
+    if (!it->second->IsObjectLocal()) return false;
+
+  return true;
+}
+
 bool RuntimeObject::VariableExists(const gd::String &variable) {
   return objectVariables.Has(variable);
 }
@@ -13,6 +13,8 @@
 #include <vector>
 #include "GDCore/Tools/MakeUnique.h"
 #include "GDCpp/Runtime/Force.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/String.h"
@@ -23,7 +25,6 @@ class Object;
 namespace sf {
 class RenderTarget;
 }
-class Polygon2d;
 class RaycastResult;
 class RuntimeScene;
 
@@ -90,7 +91,14 @@ class GD_API RuntimeObject {
   /**
    * \brief Copy constructor. Calls Init().
    */
-  RuntimeObject(const RuntimeObject& object) { Init(object); };
+  RuntimeObject(const RuntimeObject& object)
+      : instancesListNameId(0),
+        instancesListIndex(0),
+        removedFromInstancesHolder(false),
+        transforms(object.transforms),
+        transformsSlot(transforms->AllocateSlot()) {
+    Init(object);
+  };
 
   /**
    * \brief Assignment operator. Calls Init().
@@ -170,6 +178,15 @@ class GD_API RuntimeObject {
    */
   void DoBehaviorsPostEvents(RuntimeScene& scene);
 
+  /**
+   * \brief Return true if all the behaviors of the object are object-local
+   * (true too if the object has no behaviors), so that the object can be
+   * stepped in parallel with other such objects.
+   *
+   * \see RuntimeBehavior::IsObjectLocal
+   */
+  bool HasOnlyObjectLocalBehaviors() const;
+
   /**
    * Only used by GD events generated code
    */
@@ -180,6 +197,15 @@ class GD_API RuntimeObject {
    */
   RuntimeBehavior* GetBehaviorRawPointer(const gd::String& name) const;
 
+  /**
+   * \brief Return the behavior having the specified name identifier, or NULL
+   * if the object has no such behavior.
+   *
+   * Faster than getting the behavior by its name, this is used by GD events
+   * generated code. \see NamesTable
+   */
+  RuntimeBehavior* GetBehaviorRawPointer(std::size_t nameId) const;
+
   /**
    * \brief Return true if the object has the behavior with the specified name.
    */
@@ -211,7 +237,10 @@ class GD_API RuntimeObject {
   /**
    * \brief Change the Z order of the object
    */
-  inline void SetZOrder(int zOrder_) { zOrder = zOrder_; }
+  inline void SetZOrder(int zOrder_) {
+    if (zOrder != zOrder_) renderingOrderChanged = true;
+    zOrder = zOrder_;
+  }
 
   /**
    * \brief Return if the object is hidden or not
@@ -231,7 +260,7 @@ class GD_API RuntimeObject {
   /**
    * \brief Change the layer of the object
    */
-  inline void SetLayer(const gd::String& layer_) { layer = layer_; }
+  void SetLayer(const gd::String& layer_);
 
   /**
    * \brief Get the layer of the object
@@ -245,24 +274,44 @@ class GD_API RuntimeObject {
     return layer == layer_;
   }
 
+  /**
+   * \brief Return true if the layer or the Z order of the object changed since
+   * the object was sorted for rendering.
+   *
+   * \see ObjInstancesHolder::UpdateLayersObjects
+   */
+  inline bool HasRenderingOrderChanged() const {
+    return renderingOrderChanged;
+  }
+
+  /**
+   * \brief Mark the object as needing (or not) to be sorted again for
+   * rendering.
+   */
+  inline void SetRenderingOrderChanged(bool changed = true) {
+    renderingOrderChanged = changed;
+  }
+
   /**
    * \brief Get the object AABB
    */
-  sf::FloatRect GetAABB() const;
+  virtual sf::FloatRect GetAABB() const;
 
   /**
    * \brief Get the object hitbox(es)
    * \note Default implementation returns a basic bounding box, according to the
    * object width/height and angle.
+   * \warning The returned reference is only valid until the next call to
+   * GetHitBoxes, or until the object is modified.
    */
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes() const;
 
   /**
    * \brief Get the object hitbox(es) preferably intersecting with hint
    * \note The default implementation returns all the hitbox given by
    * GetHitBoxes()
    */
-  virtual std::vector<Polygon2d> GetHitBoxes(sf::FloatRect hint) const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes(sf::FloatRect hint) const;
 
   /**
    * \brief Check collision between two objects using their hitboxes.
@@ -380,12 +429,12 @@ class GD_API RuntimeObject {
   /**
    * \brief Get the X coordinate of the object in the layout.
    */
-  inline float GetX() const { return X; }
+  inline float GetX() const { return transforms->GetX(transformsSlot); }
 
   /**
    * \brief Get the Y coordinate of the object in the layout.
    */
-  inline float GetY() const { return Y; }
+  inline float GetY() const { return transforms->GetY(transformsSlot); }
 
   /**
    * \brief Change X position of the object.
@@ -393,7 +442,7 @@ class GD_API RuntimeObject {
    * extra work if needed.
    */
   void SetX(float x_) {
-    X = x_;
+    transforms->SetX(transformsSlot, x_);
     OnPositionChanged();
   }
 
@@ -403,7 +452,7 @@ class GD_API RuntimeObject {
    * extra work if needed.
    */
   void SetY(float y_) {
-    Y = y_;
+    transforms->SetY(transformsSlot, y_);
     OnPositionChanged();
   }
 
@@ -413,6 +462,18 @@ class GD_API RuntimeObject {
    */
   virtual void OnPositionChanged(){};
 
+  /**
+   * \brief Return the storage of the position and of the total force of the
+   * object.
+   */
+  const ObjectsTransforms& GetObjectsTransforms() const { return *transforms; }
+
+  /**
+   * \brief Return the index of the slot of the object in its objects
+   * transforms.
+   */
+  std::size_t GetObjectsTransformsSlot() const { return transformsSlot; }
+
   /**
    * \brief Get the real X position where is renderer the object.
    *
@@ -458,6 +519,7 @@ class GD_API RuntimeObject {
   ///@{
 
   Force force5;  ///< \deprecated Old custom force used to manage collisions.
+                 ///< Call UpdateTotalForce after changing it.
 
   /**
    * Automatically called at each frame so as to update forces applied on the
@@ -465,10 +527,23 @@ class GD_API RuntimeObject {
    */
   bool UpdateForce(float ElapsedTime);
 
-  float TotalForceX() const;
-  float TotalForceY() const;
+  float TotalForceX() const { return transforms->GetForceX(transformsSlot); }
+  float TotalForceY() const { return transforms->GetForceY(transformsSlot); }
   float TotalForceAngle() const;
   float TotalForceLength() const;
+
+  /**
+   * \brief Return true if at least one force is applied to the object.
+   */
+  bool HasForces() const {
+    return !forces.empty() || force5.GetX() != 0 || force5.GetY() != 0;
+  }
+
+  /**
+   * \brief Compute again the sum of the forces, returned by TotalForceX and
+   * TotalForceY. Called by the methods changing the forces.
+   */
+  void UpdateTotalForce();
   ///@}
 
   /**
@@ -607,15 +682,19 @@ class GD_API RuntimeObject {
   gd::String name;  ///< The full name of the object
   gd::String type;  ///< Which type is the object. ( To test if we can do
                     ///< something reserved to some objects with it )
-  float X;          ///< X position on the scene
-  float Y;          ///< Y position on the scene
   int zOrder;   ///< Z order on the scene, to choose if an object is displayed
                 ///< before another object.
   bool hidden;  ///< True to prevent the object from being rendered.
   gd::String layer;  ///< Name of the layer on which the object is.
+  bool renderingOrderChanged;  ///< True if the layer or the Z order changed
+                               ///< since the object was last sorted for
+                               ///< rendering.
   std::map<gd::String, std::unique_ptr<RuntimeBehavior>>
       behaviors;  ///< Contains all behaviors of the object. Behaviors are the
                   ///< ownership of the object
+  std::vector<std::pair<std::size_t, RuntimeBehavior*>>
+      behaviorsByNameId;  ///< The behaviors, with the identifiers of their
+                          ///< names (see NamesTable).
   RuntimeVariablesContainer
       objectVariables;        ///< List of the variables of the object
   std::vector<Force> forces;  ///< Forces applied to the object
@@ -625,6 +704,36 @@ class GD_API RuntimeObject {
    * assign-op. \warning Don't forget to update me if members were changed!
    */
   void Init(const RuntimeObject& object);
+
+ private:
+  friend class ObjInstancesHolder;
+
+  std::size_t instancesListNameId;  ///< The identifier of the name of the
+                                    ///< ObjInstancesHolder list containing the
+                                    ///< object (see NamesTable).
+  std::size_t instancesListIndex;   ///< The position of the object in this
+                                    ///< list.
+  bool removedFromInstancesHolder;  ///< Set by ObjInstancesHolder when the
+                                    ///< object is being removed.
+
+  /**
+   * \brief Move the position and the total force of the object to a slot of
+   * \a newTransforms (unless already there), releasing its current slot, and
+   * mark the object as being in the scene.
+   *
+   * Called by ObjInstancesHolder::AddObject.
+   */
+  void MoveToObjectsTransforms(
+      const std::shared_ptr<ObjectsTransforms>& newTransforms);
+
+  std::shared_ptr<ObjectsTransforms>
+      transforms;              ///< The storage of the position and the total
+                               ///< force of the object, owned by the scene.
+  std::size_t transformsSlot;  ///< The index of the object in transforms.
+
+  mutable std::vector<Polygon2d>
+      defaultHitBoxes;  ///< The storage of the hitboxes returned by the
+                        ///< default implementation of GetHitBoxes.
 };
 
 #endif  // RUNTIMEOBJECT_H
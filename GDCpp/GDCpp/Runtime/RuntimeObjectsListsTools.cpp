@@ -5,6 +5,7 @@
  */
 #include "RuntimeObjectsListsTools.h"
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "RuntimeObject.h"
@@ -20,3 +21,35 @@ void GD_API PickOnly(RuntimeObjectsLists& pickedObjectsLists,
   if (pickedObjectsLists[thisOne->GetName()] != NULL)
     pickedObjectsLists[thisOne->GetName()]->push_back(thisOne);
 }
+
+std::vector<std::unique_ptr<PickedObjectsFlags::Buffer>>&
+PickedObjectsFlags::GetFreeBuffers() {
+  // Each thread has its own pool, so that objects can be picked from any
+  // thread.
+  thread_local std::vector<std::unique_ptr<Buffer>> freeBuffers;
+  return freeBuffers;
+}
+
+PickedObjectsFlags::PickedObjectsFlags(
+    const RuntimeObjectsLists& objectsLists) {
+  auto& freeBuffers = GetFreeBuffers();
+  if (freeBuffers.empty()) {
+    buffer = new Buffer;
+  } else {
+    buffer = freeBuffers.back().release();
+    freeBuffers.pop_back();
+  }
+
+  buffer->offsets.clear();
+  std::size_t flagsCount = 0;
+  for (auto it = objectsLists.begin(); it != objectsLists.end(); ++it) {
+    buffer->offsets.push_back(flagsCount);
+    if (it->second) flagsCount += it->second->size();
+  }
+  buffer->offsets.push_back(flagsCount);
+  buffer->flags.assign(flagsCount, false);
+}
+
+PickedObjectsFlags::~PickedObjectsFlags() {
+  GetFreeBuffers().push_back(std::unique_ptr<Buffer>(buffer));
+}
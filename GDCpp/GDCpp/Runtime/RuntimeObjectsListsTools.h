@@ -6,9 +6,12 @@
 #ifndef OBJECTSLISTSTOOLS_H
 #define OBJECTSLISTSTOOLS_H
 
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
+#include "ObjectsSpatialHash.h"
 #include "RuntimeObject.h"
 #include "RuntimeScene.h"
 
@@ -24,6 +27,58 @@ typedef std::map<gd::String, std::vector<RuntimeObject *> *>
 void GD_API PickOnly(RuntimeObjectsLists &pickedObjectsLists,
                      RuntimeObject *thisOne);
 
+/**
+ * \brief A flag for each object of some lists of objects, used by the
+ * functions picking objects to remember the objects to keep.
+ *
+ * The memory used by the flags is taken from a pool when the flags are
+ * created, and given back when they are destroyed, so that conditions do not
+ * allocate memory at each frame.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API PickedObjectsFlags {
+ public:
+  /**
+   * \brief Create a flag, set to false, for each object of the lists.
+   */
+  PickedObjectsFlags(const RuntimeObjectsLists &objectsLists);
+  ~PickedObjectsFlags();
+
+  /**
+   * \brief Return the flag of the object at position \a k of the list \a i.
+   */
+  char &operator()(std::size_t i, std::size_t k) {
+    return buffer->flags[buffer->offsets[i] + k];
+  }
+
+  /**
+   * \brief Return the size that the list \a i had when the flags were
+   * created.
+   */
+  std::size_t GetListSize(std::size_t i) const {
+    return buffer->offsets[i + 1] - buffer->offsets[i];
+  }
+
+ private:
+  PickedObjectsFlags(const PickedObjectsFlags &) = delete;
+  PickedObjectsFlags &operator=(const PickedObjectsFlags &) = delete;
+
+  struct Buffer {
+    std::vector<char> flags;
+    std::vector<std::size_t> offsets;  ///< The position of the first flag of
+                                       ///< each list, and the total number of
+                                       ///< flags.
+  };
+
+  /**
+   * \brief Return the buffers not in use, for the current thread.
+   */
+  static std::vector<std::unique_ptr<Buffer>> &GetFreeBuffers();
+
+  Buffer *buffer;
+};
+
 /**
  * \brief Filter objects to keep only the one that fullfil the predicate
  *
@@ -44,14 +99,7 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
   bool isTrue = false;
 
   // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList.push_back(arr);
-  }
+  PickedObjectsFlags pickedList(pickedObjectsLists);
 
   // Pick objects which are fulfulling the predicate.
   std::size_t i = 0;
@@ -63,7 +111,7 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
 
     for (std::size_t k = 0; k < arr1.size(); ++k) {
       if (negatePredicate ^ predicate(arr1[k])) {
-        pickedList[i][k] = true;
+        pickedList(i, k) = true;
         isTrue = true;
       }
     }
@@ -80,7 +128,7 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
 
     for (std::size_t k = 0; k < arr.size(); ++k) {
       RuntimeObject *obj = arr[k];
-      if (pickedList[i][k]) {
+      if (pickedList(i, k)) {
         arr[finalSize] = obj;
         finalSize++;
       }
@@ -120,30 +168,15 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
  * \ingroup GameEngine
  */
 template <typename Pred>
-bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
-                        RuntimeObjectsLists objectsLists2,
+bool TwoObjectListsTest(const RuntimeObjectsLists &objectsLists1,
+                        const RuntimeObjectsLists &objectsLists2,
                         bool negatePredicate,
                         Pred predicate) {
   bool isTrue = false;
 
   // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList1;
-  std::vector<std::vector<bool> > pickedList2;
-
-  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
-       it != objectsLists1.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList1.push_back(arr);
-  }
-  for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-       it != objectsLists2.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList2.push_back(arr);
-  }
+  PickedObjectsFlags pickedList1(objectsLists1);
+  PickedObjectsFlags pickedList2(objectsLists2);
 
   // Launch the function each object of the first list with each object
   // of the second list.
@@ -165,7 +198,7 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
         const std::vector<RuntimeObject *> &arr2 = *it2->second;
 
         for (std::size_t l = 0; l < arr2.size(); ++l) {
-          if (pickedList1[i][k] && pickedList2[j][l])
+          if (pickedList1(i, k) && pickedList2(j, l))
             continue;  // Avoid unnecessary costly call to functor.
 
           if (std::addressof(arr1[k]) != std::addressof(arr2[l]) &&
@@ -174,8 +207,8 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
               isTrue = true;
 
               // Pick the objects
-              pickedList1[i][k] = true;
-              pickedList2[j][l] = true;
+              pickedList1(i, k) = true;
+              pickedList2(j, l) = true;
             }
 
             atLeastOneObject = true;
@@ -186,7 +219,168 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
       if (!atLeastOneObject &&
           negatePredicate) {  // The object is not overlapping any other object.
         isTrue = true;
-        pickedList1[i][k] = true;
+        pickedList1(i, k) = true;
+      }
+    }
+  }
+
+  // Trim not picked objects from lists.
+  i = 0;
+  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
+       it != objectsLists1.end();
+       ++it, ++i) {
+    size_t finalSize = 0;
+    if (!it->second) continue;
+    std::vector<RuntimeObject *> &arr = *it->second;
+
+    for (std::size_t k = 0; k < arr.size(); ++k) {
+      RuntimeObject *obj = arr[k];
+      if (pickedList1(i, k)) {
+        arr[finalSize] = obj;
+        finalSize++;
+      }
+    }
+    arr.resize(finalSize);
+  }
+
+  if (!negatePredicate) {
+    std::size_t i = 0;
+    for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
+         it != objectsLists2.end();
+         ++it, ++i) {
+      size_t finalSize = 0;
+      if (!it->second) continue;
+      std::vector<RuntimeObject *> &arr = *it->second;
+
+      //*This is important*! We can have a list that has already been trimmed
+      // just before
+      if (arr.size() !=
+          pickedList2.GetListSize(i))  // If the size of the objects list !=
+                                       // size of the boolean "picked" list...
+        continue;  //... then the object list was already trimmed, skip it.
+
+      for (std::size_t k = 0; k < arr.size(); ++k) {
+        RuntimeObject *obj = arr[k];
+        if (pickedList2(i, k)) {
+          arr[finalSize] = obj;
+          finalSize++;
+        }
+      }
+      arr.resize(finalSize);
+    }
+  }
+
+  return isTrue;
+}
+
+/**
+ * \brief Same as TwoObjectListsTest, but only calls the predicate for pairs of
+ * objects that are close to each other.
+ *
+ * The objects of objectsLists2 are put in a ObjectsSpatialHash, using
+ * ObjectsSpatialHash::GetBroadphaseBox, and each object of objectsLists1 is
+ * only tested against the objects having a box overlapping its own box,
+ * extended by \a maxDistance on each side.
+ *
+ * \warning The predicate must be false for all pairs of objects that are not
+ * found by the broadphase (i.e: objects with boxes farther than \a maxDistance
+ * from each other), otherwise the result will differ from TwoObjectListsTest.
+ *
+ * Cost (Worst case, predicate being always false):
+ *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *  + Cost(Inserting NbObjList2 objects in the spatial hash)
+ *  + Cost(predicate)*(Number of pairs of close objects)
+ *  + Cost(Testing NbObjList1+NbObjList2 booleans)
+ *  + Cost(Removing NbObjList1+NbObjList2 objects from all the lists)
+ *
+ * \see TwoObjectListsTest
+ * \ingroup GameEngine
+ */
+template <typename Pred>
+bool TwoObjectListsTestWithBroadphase(
+    const RuntimeObjectsLists &objectsLists1,
+    const RuntimeObjectsLists &objectsLists2,
+    bool negatePredicate,
+    float maxDistance,
+    Pred predicate) {
+  bool isTrue = false;
+
+  // Create a boolean for each object
+  PickedObjectsFlags pickedList1(objectsLists1);
+  PickedObjectsFlags pickedList2(objectsLists2);
+
+  // Put the objects of the second list in the spatial hash, remembering
+  // the list and the position in the list of each of them. Cells are sized
+  // according to the average size of the boxes.
+  std::vector<const std::vector<RuntimeObject *> *> lists2;
+  std::vector<sf::FloatRect> boxes2;
+  std::vector<std::pair<std::size_t, std::size_t> > positions2;
+  float boxesTotalSize = 0;
+  std::size_t listIndex = 0;
+  for (RuntimeObjectsLists::const_iterator it2 = objectsLists2.begin();
+       it2 != objectsLists2.end();
+       ++it2, ++listIndex) {
+    lists2.push_back(it2->second);
+    if (!it2->second) continue;
+    const std::vector<RuntimeObject *> &arr2 = *it2->second;
+
+    for (std::size_t l = 0; l < arr2.size(); ++l) {
+      boxes2.push_back(ObjectsSpatialHash::GetBroadphaseBox(*arr2[l]));
+      positions2.push_back(std::make_pair(listIndex, l));
+      boxesTotalSize += std::max(boxes2.back().width, boxes2.back().height);
+    }
+  }
+
+  ObjectsSpatialHash spatialHash(
+      boxes2.empty() ? 1 : boxesTotalSize / boxes2.size() + maxDistance);
+  for (std::size_t b = 0; b < boxes2.size(); ++b) spatialHash.Insert(boxes2[b]);
+
+  // Launch the function on each object of the first list with each object
+  // of the second list close to it. The area is slightly extended to be sure
+  // that rounding errors can't exclude a pair of objects.
+  std::size_t i = 0;
+  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
+       it != objectsLists1.end();
+       ++it, ++i) {
+    if (!it->second) continue;
+    const std::vector<RuntimeObject *> &arr1 = *it->second;
+
+    for (std::size_t k = 0; k < arr1.size(); ++k) {
+      bool atLeastOneObject = false;
+
+      sf::FloatRect area = ObjectsSpatialHash::GetBroadphaseBox(*arr1[k]);
+      float extent = maxDistance + 1;
+      area.left -= extent;
+      area.top -= extent;
+      area.width += extent * 2;
+      area.height += extent * 2;
+
+      spatialHash.QueryBoxes(area, [&](std::size_t index) {
+        std::size_t j = positions2[index].first;
+        std::size_t l = positions2[index].second;
+        const std::vector<RuntimeObject *> &arr2 = *lists2[j];
+
+        if (pickedList1(i, k) && pickedList2(j, l))
+          return;  // Avoid unnecessary costly call to functor.
+
+        if (std::addressof(arr1[k]) != std::addressof(arr2[l]) &&
+            predicate(arr1[k], arr2[l])) {
+          if (!negatePredicate) {
+            isTrue = true;
+
+            // Pick the objects
+            pickedList1(i, k) = true;
+            pickedList2(j, l) = true;
+          }
+
+          atLeastOneObject = true;
+        }
+      });
+
+      if (!atLeastOneObject &&
+          negatePredicate) {  // The object is not overlapping any other object.
+        isTrue = true;
+        pickedList1(i, k) = true;
       }
     }
   }
@@ -202,7 +396,7 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
 
     for (std::size_t k = 0; k < arr.size(); ++k) {
       RuntimeObject *obj = arr[k];
-      if (pickedList1[i][k]) {
+      if (pickedList1(i, k)) {
         arr[finalSize] = obj;
         finalSize++;
       }
@@ -222,13 +416,13 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
       //*This is important*! We can have a list that has already been trimmed
       // just before
       if (arr.size() !=
-          pickedList2[i].size())  // If the size of the objects list != size of
-                                  // the boolean "picked" list...
+          pickedList2.GetListSize(i))  // If the size of the objects list !=
+                                       // size of the boolean "picked" list...
         continue;  //... then the object list was already trimmed, skip it.
 
       for (std::size_t k = 0; k < arr.size(); ++k) {
         RuntimeObject *obj = arr[k];
-        if (pickedList2[i][k]) {
+        if (pickedList2(i, k)) {
           arr[finalSize] = obj;
           finalSize++;
         }
@@ -11,10 +11,13 @@
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
 #include "GDCpp/Extensions/CppPlatform.h"
+#include "GDCpp/Runtime/AllocationsCounter.h"
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedData.h"
 #include "GDCpp/Runtime/FontManager.h"
+#include "GDCpp/Runtime/FrameProfiler.h"
 #include "GDCpp/Runtime/ImageManager.h"
 #include "GDCpp/Runtime/ManualTimer.h"
+#include "GDCpp/Runtime/NamesTable.h"
 #include "GDCpp/Runtime/Project/BehaviorsSharedData.h"
 #include "GDCpp/Runtime/Project/InitialInstance.h"
 #include "GDCpp/Runtime/Project/Layer.h"
@@ -47,6 +50,12 @@
 
 RuntimeLayer RuntimeScene::badRuntimeLayer;
 
+namespace {
+/// The number of objects given to a thread at once when stepping the
+/// object-local behaviors.
+const std::size_t behaviorsStepChunkSize = 64;
+}  // namespace
+
 RuntimeScene::RuntimeScene(sf::RenderWindow* renderWindow_, RuntimeGame* game_)
     : renderWindow(renderWindow_),
       game(game_),
@@ -55,7 +64,9 @@ RuntimeScene::RuntimeScene(sf::RenderWindow* renderWindow_, RuntimeGame* game_)
 #endif
       isFullScreen(false),
       inputManager(renderWindow_),
-      codeExecutionEngine(new CodeExecutionEngine) {
+      codeExecutionEngine(new CodeExecutionEngine),
+      objectsTransforms(std::make_shared<ObjectsTransforms>()) {
+  objectsInstances.SetObjectsTransforms(objectsTransforms);
   ChangeRenderWindow(renderWindow);
 }
 
@@ -65,8 +76,10 @@ RuntimeScene::~RuntimeScene() {
         CppPlatform::Get().GetExtension(game->GetUsedExtensions()[i]);
     std::shared_ptr<ExtensionBase> extension =
         std::dynamic_pointer_cast<ExtensionBase>(gdExtension);
-    if (extension != std::shared_ptr<ExtensionBase>())
+    if (extension != std::shared_ptr<ExtensionBase>()) {
+      GD_PROFILE_SCOPE(extension->GetName());
       extension->SceneUnloaded(*this);
+    }
   }
 
   objectsInstances.Clear();  // Force destroy objects NOW as they can have
@@ -78,6 +91,13 @@ std::shared_ptr<gd::ImageManager> RuntimeScene::GetImageManager() const {
   return game->GetImageManager();
 }
 
+void RuntimeScene::KeepTexturesLoaded(
+    std::vector<std::shared_ptr<SFMLTextureWrapper>>&& textures) {
+  keptTextures.insert(keptTextures.end(),
+                      std::make_move_iterator(textures.begin()),
+                      std::make_move_iterator(textures.end()));
+}
+
 void RuntimeScene::ChangeRenderWindow(sf::RenderWindow* newWindow) {
   renderWindow = newWindow;
   inputManager.SetWindow(newWindow);
@@ -118,6 +138,10 @@ void RuntimeScene::RequestChange(SceneChange::Change change,
 }
 
 bool RuntimeScene::RenderAndStep() {
+#if defined(GD_IDE_ONLY)
+  std::size_t allocationsCountAtFrameStart = AllocationsCounter::GetCount();
+#endif
+
   requestedChange.change = SceneChange::CONTINUE;
   ManageRenderTargetEvents();
   timeManager.Update(clock.restart().asMicroseconds(), game->GetMinimumFPS());
@@ -131,7 +155,10 @@ bool RuntimeScene::RenderAndStep() {
   }
 #endif
 
-  GetCodeExecutionEngine()->Execute();
+  {
+    GD_PROFILE_SCOPE("Events");
+    GetCodeExecutionEngine()->Execute();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler() && GetProfiler()->profilingActivated) {
@@ -157,10 +184,24 @@ bool RuntimeScene::RenderAndStep() {
     GetProfiler()->totalSceneTime +=
         GetProfiler()->lastRenderingTime + GetProfiler()->lastEventsTime;
     GetProfiler()->totalEventsTime += GetProfiler()->lastEventsTime;
+    GetProfiler()->lastFrameAllocationsCount =
+        AllocationsCounter::GetCount() - allocationsCountAtFrameStart;
     GetProfiler()->Update();
   }
 #endif
 
+  if (FrameProfiler::IsEnabled() && game && game->GetImageManager()) {
+    const gd::ImageManager& imageManager = *game->GetImageManager();
+    FrameProfiler::SetCounter("Textures memory",
+                              imageManager.GetTexturesMemoryUsage());
+    FrameProfiler::SetCounter("Textures cache hits",
+                              imageManager.GetCacheHitsCount());
+    FrameProfiler::SetCounter("Textures cache misses",
+                              imageManager.GetCacheMissesCount());
+    FrameProfiler::SetCounter("Textures evictions",
+                              imageManager.GetEvictionsCount());
+  }
+  FrameProfiler::EndFrame();
   return requestedChange.change != SceneChange::CONTINUE;
 }
 
@@ -195,16 +236,17 @@ void RuntimeScene::RenderWithoutStep() {
 }
 
 void RuntimeScene::Render() {
+  GD_PROFILE_SCOPE("Rendering");
+
+  // Sort objects (that were added or changed) by order to render them
+  objectsInstances.UpdateLayersObjects();
+
   if (!renderWindow) return;
 
   renderWindow->clear(sf::Color(GetBackgroundColorRed(),
                                 GetBackgroundColorGreen(),
                                 GetBackgroundColorBlue()));
 
-  // Sort object by order to render them
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  OrderObjectsByZOrder(allObjects);
-
 #if !defined(ANDROID)  // TODO: OpenGL
   // To allow using OpenGL to draw:
   glClear(GL_DEPTH_BUFFER_BIT);  // Clear the depth buffer
@@ -215,6 +257,10 @@ void RuntimeScene::Render() {
   // Draw layer by layer
   for (std::size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
     if (layers[layerIndex].GetVisibility()) {
+      GD_PROFILE_SCOPE(layers[layerIndex].GetName());
+      const RuntimeObjNonOwningPtrList& layerObjects =
+          objectsInstances.GetObjectsOnLayer(layers[layerIndex].GetName());
+
       for (std::size_t cameraIndex = 0;
            cameraIndex < layers[layerIndex].GetCameraCount();
            ++cameraIndex) {
@@ -248,11 +294,9 @@ void RuntimeScene::Render() {
         // Prepare SFML rendering
         renderWindow->setView(camera.GetSFMLView());
 
-        // Rendering all objects
-        for (std::size_t id = 0; id < allObjects.size(); ++id) {
-          if (allObjects[id]->GetLayer() == layers[layerIndex].GetName())
-            allObjects[id]->Draw(*renderWindow);
-        }
+        // Rendering all objects of the layer
+        for (std::size_t id = 0; id < layerObjects.size(); ++id)
+          layerObjects[id]->Draw(*renderWindow);
       }
     }
   }
@@ -299,41 +343,115 @@ const RuntimeLayer& RuntimeScene::GetRuntimeLayer(
   return badRuntimeLayer;
 }
 
+RuntimeLayer& RuntimeScene::GetRuntimeLayer(std::size_t nameId) {
+  if (nameId >= layersIndicesByNameId.size() ||
+      layersIndicesByNameId[nameId] == NamesTable::npos)
+    return badRuntimeLayer;
+
+  return layers[layersIndicesByNameId[nameId]];
+}
+
+const RuntimeLayer& RuntimeScene::GetRuntimeLayer(std::size_t nameId) const {
+  if (nameId >= layersIndicesByNameId.size() ||
+      layersIndicesByNameId[nameId] == NamesTable::npos)
+    return badRuntimeLayer;
+
+  return layers[layersIndicesByNameId[nameId]];
+}
+
 void RuntimeScene::ManageObjectsAfterEvents() {
+  GD_PROFILE_SCOPE("Objects after events");
+
   // Delete objects that were removed.
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
+  objectsInstances.GetAllObjects(allObjects);
+  removedObjects.clear();
   for (std::size_t id = 0; id < allObjects.size(); ++id) {
     if (allObjects[id]->GetName().empty()) {
       for (std::size_t i = 0; i < extensionsToBeNotifiedOnObjectDeletion.size();
-           ++i)
+           ++i) {
+        GD_PROFILE_SCOPE(extensionsToBeNotifiedOnObjectDeletion[i]->GetName());
         extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(
             *this, allObjects[id]);
+      }
 
-      objectsInstances.RemoveObject(
-          allObjects[id]);  // Remove from objects instances, not from the
-                            // temporary list!
+      removedObjects.push_back(allObjects[id]);
     }
   }
+  objectsInstances.RemoveObjects(removedObjects);  // All objects are removed
+                                                   // at once.
+
+  // Move all the objects according to their forces at once (objects created
+  // for another scene were given a slot in objectsTransforms when added)...
+  double defaultElapsedTime =
+      static_cast<double>(badRuntimeLayer.GetElapsedTime(*this)) / 1000000.0;
+  layersElapsedTimes.assign(NamesTable::GetCount(), defaultElapsedTime);
+  for (std::size_t nameId = 0; nameId < layersIndicesByNameId.size();
+       ++nameId) {
+    if (layersIndicesByNameId[nameId] != NamesTable::npos)
+      layersElapsedTimes[nameId] =
+          static_cast<double>(
+              layers[layersIndicesByNameId[nameId]].GetElapsedTime(*this)) /
+          1000000.0;
+  }
+  objectsTransforms->ApplyForces(layersElapsedTimes);
 
-  // Update objects positions, forces and behaviors
-  allObjects = objectsInstances.GetAllObjects();
+  // ...then update objects and forces.
+  objectsInstances.GetAllObjects(allObjects);
   for (RuntimeObject* object : allObjects) {
-    double elapsedTimeInSeconds =
-        static_cast<double>(object->GetElapsedTime(*this)) / 1000000.0;
-    object->SetX(object->GetX() +
-                 (object->TotalForceX() * elapsedTimeInSeconds));
-    object->SetY(object->GetY() +
-                 (object->TotalForceY() * elapsedTimeInSeconds));
+    if (object->TotalForceX() != 0 || object->TotalForceY() != 0)
+      object->OnPositionChanged();
+
     object->Update(*this);
-    object->UpdateForce(elapsedTimeInSeconds);
-    object->DoBehaviorsPostEvents(*this);
+    if (object->HasForces())
+      object->UpdateForce(
+          static_cast<double>(object->GetElapsedTime(*this)) / 1000000.0);
   }
+
+  StepBehaviors(false);
 }
 
 void RuntimeScene::ManageObjectsBeforeEvents() {
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  for (std::size_t id = 0; id < allObjects.size(); ++id)
-    allObjects[id]->DoBehaviorsPreEvents(*this);
+  GD_PROFILE_SCOPE("Objects before events");
+  objectsInstances.GetAllObjects(allObjects);
+  StepBehaviors(true);
+}
+
+void RuntimeScene::StepBehaviors(bool preEvents) {
+  GD_PROFILE_SCOPE(preEvents ? "Behaviors pre-events"
+                             : "Behaviors post-events");
+
+  auto stepObject = [this, preEvents](RuntimeObject* object) {
+    if (preEvents)
+      object->DoBehaviorsPreEvents(*this);
+    else
+      object->DoBehaviorsPostEvents(*this);
+  };
+
+  // Objects having only object-local behaviors only modify themselves, so
+  // the consecutive ones can be stepped in parallel. The other objects are
+  // stepped between them, keeping the order of a single thread.
+  std::size_t runBegin = 0;
+  for (std::size_t id = 0; id <= allObjects.size(); ++id) {
+    if (id < allObjects.size() && allObjects[id]->HasOnlyObjectLocalBehaviors())
+      continue;
+
+    std::size_t runSize = id - runBegin;
+    if (runSize > behaviorsStepChunkSize) {
+      behaviorsJobsPool.ParallelFor(
+          runSize,
+          behaviorsStepChunkSize,
+          [this, runBegin, &stepObject](std::size_t begin, std::size_t end) {
+            GD_PROFILE_SCOPE("Object-local behaviors");
+            for (std::size_t i = begin; i < end; ++i)
+              stepObject(allObjects[runBegin + i]);
+          });
+    } else {
+      for (std::size_t i = runBegin; i < id; ++i) stepObject(allObjects[i]);
+    }
+
+    if (id < allObjects.size()) stepObject(allObjects[id]);
+    runBegin = id + 1;
+  }
 }
 
 /**
@@ -436,12 +554,19 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
   // Initialize layers
   std::cout << ".";
   layers.clear();
+  layersIndicesByNameId.clear();
   sf::View defaultView(sf::FloatRect(0.0f,
                                      0.0f,
                                      game->GetGameResolutionWidth(),
                                      game->GetGameResolutionHeight()));
   for (std::size_t i = 0; i < GetLayersCount(); ++i) {
     layers.push_back(RuntimeLayer(GetLayer(i), defaultView));
+
+    std::size_t nameId = NamesTable::GetId(GetLayer(i).GetName());
+    if (nameId >= layersIndicesByNameId.size())
+      layersIndicesByNameId.resize(nameId + 1, NamesTable::npos);
+    if (layersIndicesByNameId[nameId] == NamesTable::npos)
+      layersIndicesByNameId[nameId] = i;
   }
 
   // Create object instances which are originally positioned on scene
@@ -460,6 +585,7 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
     std::shared_ptr<ExtensionBase> extension =
         std::dynamic_pointer_cast<ExtensionBase>(gdExtension);
     if (extension != std::shared_ptr<ExtensionBase>()) {
+      GD_PROFILE_SCOPE(extension->GetName());
       extension->SceneLoaded(*this);
       if (extension->ToBeNotifiedOnObjectDeletion())
         extensionsToBeNotifiedOnObjectDeletion.push_back(extension.get());
@@ -13,7 +13,9 @@
 #include <vector>
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedDataHolder.h"
 #include "GDCpp/Runtime/InputManager.h"
+#include "GDCpp/Runtime/JobsPool.h"
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
 #include "GDCpp/Runtime/Project/Layout.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
@@ -32,6 +34,7 @@ class RuntimeGame;
 class BehaviorsRuntimeSharedData;
 class ExtensionBase;
 class CodeExecutionEngine;
+class SFMLTextureWrapper;
 #undef GetObject  // Disable an annoying macro
 
 #if defined(GD_IDE_ONLY)
@@ -102,6 +105,24 @@ class GD_API RuntimeScene : public Scene {
    */
   TimeManager& GetTimeManager() { return timeManager; }
 
+  /**
+   * \brief Return the storage of the positions and of the total forces of the
+   * objects created for the scene, and of the objects added to it.
+   */
+  const std::shared_ptr<ObjectsTransforms>& GetObjectsTransforms() const {
+    return objectsTransforms;
+  }
+
+  /**
+   * \brief Keep the textures loaded as long as the scene exists, even when no
+   * object uses them.
+   *
+   * Used by SceneStack for the textures preloaded for the scene, so that
+   * objects created during the scene find them already loaded.
+   */
+  void KeepTexturesLoaded(
+      std::vector<std::shared_ptr<SFMLTextureWrapper>>&& textures);
+
   /**
    * Get the layer with specified name.
    */
@@ -112,6 +133,18 @@ class GD_API RuntimeScene : public Scene {
    */
   const RuntimeLayer& GetRuntimeLayer(const gd::String& name) const;
 
+  /**
+   * Get the layer with the specified name identifier.
+   * \see NamesTable
+   */
+  RuntimeLayer& GetRuntimeLayer(std::size_t nameId);
+
+  /**
+   * Get the layer with the specified name identifier.
+   * \see NamesTable
+   */
+  const RuntimeLayer& GetRuntimeLayer(std::size_t nameId) const;
+
   /**
    * \brief Return the shared data for a behavior.
    * \warning Be careful, no check is made to ensure that the shared data exist.
@@ -179,6 +212,28 @@ class GD_API RuntimeScene : public Scene {
    */
   void RenderWithoutStep();
 
+  /**
+   * \brief Change the number of threads used to step the object-local
+   * behaviors (see gd::BehaviorMetadata::SetObjectLocal) before and after the
+   * events.
+   *
+   * 0 means the number of hardware threads. The default is 1. Only the
+   * objects having only object-local behaviors are stepped in parallel, so
+   * the behaviors are stepped in the same order, and the objects are the
+   * same, whatever the number of threads.
+   */
+  void SetBehaviorsThreadsCount(std::size_t threadsCount) {
+    behaviorsJobsPool.SetThreadsCount(threadsCount);
+  }
+
+  /**
+   * \brief Return the number of threads used to step the object-local
+   * behaviors.
+   */
+  std::size_t GetBehaviorsThreadsCount() const {
+    return behaviorsJobsPool.GetThreadsCount();
+  }
+
   /** \name Code execution engine
    * Functions members giving access to the code execution engine.
    */
@@ -244,6 +299,19 @@ class GD_API RuntimeScene : public Scene {
    */
   void ManageObjectsAfterEvents();
 
+  /**
+   * \brief Step the behaviors of the objects of allObjects, in the order of
+   * the objects and of their behaviors.
+   *
+   * Consecutive objects having only object-local behaviors are stepped in
+   * parallel: they only modify themselves, so the result is the same as
+   * stepping them one after the other.
+   *
+   * \param preEvents true to do the pre-events step, false to do the
+   * post-events step.
+   */
+  void StepBehaviors(bool preEvents);
+
   /**
    * \brief Set the OpenGL projection according to the window size and OpenGL
    * scene options.
@@ -265,10 +333,31 @@ class GD_API RuntimeScene : public Scene {
       behaviorsSharedDatas;  ///< Contains all behaviors shared datas.
   std::vector<RuntimeLayer>
       layers;  ///< The layers used at runtime to display the scene.
+  std::vector<std::size_t>
+      layersIndicesByNameId;  ///< The index in layers of each layer, indexed
+                              ///< by the identifier of its name (see
+                              ///< NamesTable).
   std::shared_ptr<CodeExecutionEngine> codeExecutionEngine;
   SceneChange
       requestedChange;  ///< What should be done at the end of the frame.
   sf::Clock clock;      ///< The clock used to track time.
+  RuntimeObjNonOwningPtrList
+      allObjects;  ///< Used by ManageObjectsBeforeEvents and
+                   ///< ManageObjectsAfterEvents, kept to avoid reallocations
+                   ///< at each frame.
+  RuntimeObjNonOwningPtrList
+      removedObjects;  ///< Used by ManageObjectsAfterEvents, kept to avoid
+                       ///< reallocations at each frame.
+  JobsPool behaviorsJobsPool;  ///< Used to step the object-local behaviors.
+  std::shared_ptr<ObjectsTransforms>
+      objectsTransforms;  ///< The positions and total forces of the objects.
+  std::vector<std::shared_ptr<SFMLTextureWrapper>>
+      keptTextures;  ///< Textures kept loaded for the lifetime of the scene
+                     ///< (see KeepTexturesLoaded).
+  std::vector<double>
+      layersElapsedTimes;  ///< Used by ManageObjectsAfterEvents: the time
+                           ///< elapsed on each layer, in seconds, indexed by
+                           ///< the identifiers of the layers names.
 
   static RuntimeLayer
       badRuntimeLayer;  ///< Null object return by GetLayer when no appropriate
@@ -43,6 +43,8 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
       animationSpeedScale(1.f),
       ptrToCurrentSprite(NULL),
       needUpdateCurrentSprite(true),
+      needUpdateHitBoxes(true),
+      needUpdateAABB(true),
       opacity(255),
       blendMode(0),
       isFlippedX(false),
@@ -99,11 +101,11 @@ bool RuntimeSpriteObject::Draw(sf::RenderTarget& renderTarget) {
 }
 
 float RuntimeSpriteObject::GetDrawableX() const {
-  return X - GetCurrentSprite().GetOrigin().GetX() * fabs(scaleX);
+  return GetX() - GetCurrentSprite().GetOrigin().GetX() * fabs(scaleX);
 }
 
 float RuntimeSpriteObject::GetDrawableY() const {
-  return Y - GetCurrentSprite().GetOrigin().GetY() * fabs(scaleY);
+  return GetY() - GetCurrentSprite().GetOrigin().GetY() * fabs(scaleY);
 }
 
 float RuntimeSpriteObject::GetWidth() const {
@@ -120,7 +122,7 @@ void RuntimeSpriteObject::SetWidth(float newWidth) {
   if (newWidth > 0) {
     scaleX = newWidth / GetCurrentSFMLSprite().getLocalBounds().width;
     if (isFlippedX) scaleX *= -1;
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
   }
 }
 
@@ -128,7 +130,7 @@ void RuntimeSpriteObject::SetHeight(float newHeight) {
   if (newHeight > 0) {
     scaleY = newHeight / GetCurrentSFMLSprite().getLocalBounds().height;
     if (isFlippedY) scaleY *= -1;
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
   }
 }
 
@@ -178,7 +180,7 @@ void RuntimeSpriteObject::SetScaleX(float val) {
   if (val < 0) val = 0;
 
   scaleX = val * (isFlippedX ? -1.0 : 1.0);
-  needUpdateCurrentSprite = true;
+  OnTransformChanged();
 }
 
 void RuntimeSpriteObject::SetScaleY(float val) {
@@ -186,7 +188,7 @@ void RuntimeSpriteObject::SetScaleY(float val) {
   if (val < 0) val = 0;
 
   scaleY = val * (isFlippedY ? -1.0 : 1.0);
-  needUpdateCurrentSprite = true;
+  OnTransformChanged();
 }
 
 float RuntimeSpriteObject::GetScaleX() const { return fabs(scaleX); }
@@ -282,10 +284,10 @@ void RuntimeSpriteObject::UpdateCurrentSprite() const {
   ptrToCurrentSprite->GetSFMLSprite().setRotation(
       multipleDirections ? 0 : currentAngle);
   ptrToCurrentSprite->GetSFMLSprite().setPosition(
-      X + (ptrToCurrentSprite->GetCenter().GetX() -
+      GetX() + (ptrToCurrentSprite->GetCenter().GetX() -
            ptrToCurrentSprite->GetOrigin().GetX()) *
               fabs(scaleX),
-      Y + (ptrToCurrentSprite->GetCenter().GetY() -
+      GetY() + (ptrToCurrentSprite->GetCenter().GetY() -
            ptrToCurrentSprite->GetOrigin().GetY()) *
               fabs(scaleY));
   if (isFlippedX)
@@ -319,6 +321,7 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
 
   float delay = direction.GetTimeBetweenFrames();
 
+  std::size_t oldSprite = currentSprite;
   if (timeElapsedOnCurrentSprite > delay) {
     if (delay != 0) {
       std::size_t frameCount =
@@ -336,7 +339,7 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
       currentSprite = direction.GetSpritesCount() - 1;
   }
 
-  needUpdateCurrentSprite = true;
+  if (currentSprite != oldSprite) OnTransformChanged();
 }
 
 const sf::Sprite& RuntimeSpriteObject::GetCurrentSFMLSprite() const {
@@ -351,30 +354,39 @@ const gd::Sprite& RuntimeSpriteObject::GetCurrentSprite() const {
   return *ptrToCurrentSprite;
 }
 
-std::vector<Polygon2d> RuntimeSpriteObject::GetHitBoxes() const {
+const std::vector<Polygon2d>& RuntimeSpriteObject::GetHitBoxes() const {
   if (currentAnimation >= animations.size()) {
-    std::vector<Polygon2d> hitboxes;  // Invalid animation, bail out.
-    return hitboxes;
+    hitBoxes.clear();  // Invalid animation, bail out.
+    return hitBoxes;
   }
-  const sf::Sprite& currentSFMLSprite = GetCurrentSFMLSprite();
+  if (!needUpdateHitBoxes) return hitBoxes;
 
-  std::vector<Polygon2d> polygons = GetCurrentSprite().GetCollisionMask();
-  for (std::size_t i = 0; i < polygons.size(); ++i) {
-    for (std::size_t j = 0; j < polygons[i].vertices.size(); ++j) {
-      sf::Vector2f newVertice = currentSFMLSprite.getTransform().transformPoint(
-          !isFlippedX
-              ? polygons[i].vertices[j].x
-              : GetCurrentSprite().GetSFMLSprite().getLocalBounds().width -
-                    polygons[i].vertices[j].x,
-          !isFlippedY
-              ? polygons[i].vertices[j].y
-              : GetCurrentSprite().GetSFMLSprite().getLocalBounds().height -
-                    polygons[i].vertices[j].y);
-      polygons[i].vertices[j] = newVertice;
+  const sf::Sprite& currentSFMLSprite = GetCurrentSFMLSprite();
+  const sf::Transform& transform = currentSFMLSprite.getTransform();
+  const sf::FloatRect localBounds = currentSFMLSprite.getLocalBounds();
+
+  hitBoxes = GetCurrentSprite().GetCollisionMask();
+  for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
+    std::vector<sf::Vector2f>& vertices = hitBoxes[i].vertices;
+    for (std::size_t j = 0; j < vertices.size(); ++j) {
+      vertices[j] = transform.transformPoint(
+          !isFlippedX ? vertices[j].x : localBounds.width - vertices[j].x,
+          !isFlippedY ? vertices[j].y : localBounds.height - vertices[j].y);
     }
+    hitBoxes[i].ComputeEdges();
   }
 
-  return polygons;
+  needUpdateHitBoxes = false;
+  return hitBoxes;
+}
+
+sf::FloatRect RuntimeSpriteObject::GetAABB() const {
+  if (needUpdateAABB) {
+    aabb = RuntimeObject::GetAABB();
+    needUpdateAABB = false;
+  }
+
+  return aabb;
 }
 
 bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
@@ -390,7 +402,7 @@ bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
   currentSprite = nb;
   timeElapsedOnCurrentSprite = 0;
 
-  needUpdateCurrentSprite = true;
+  OnTransformChanged();
   return true;
 }
 
@@ -402,7 +414,7 @@ bool RuntimeSpriteObject::SetCurrentAnimation(std::size_t nb) {
   currentSprite = 0;
   timeElapsedOnCurrentSprite = 0;
 
-  needUpdateCurrentSprite = true;
+  OnTransformChanged();
   return true;
 }
 
@@ -432,7 +444,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
   if (!animations[currentAnimation].Get().useMultipleDirections) {
     currentAngle = nb;
 
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
     return true;
   } else {
     if (nb >= animations[currentAnimation].Get().GetDirectionsCount() ||
@@ -445,7 +457,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
     currentSprite = 0;
     timeElapsedOnCurrentSprite = 0;
 
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
     return true;
   }
 }
@@ -456,7 +468,7 @@ bool RuntimeSpriteObject::SetAngle(float newAngle) {
   if (!animations[currentAnimation].Get().useMultipleDirections) {
     currentAngle = newAngle;
 
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
   } else {
     newAngle = static_cast<int>(newAngle) % 360;
     if (newAngle < 0) newAngle += 360;
@@ -516,7 +528,7 @@ void RuntimeSpriteObject::SetColor(unsigned int r,
 void RuntimeSpriteObject::FlipX(bool flip) {
   if (flip != isFlippedX) {
     scaleX *= -1.0;
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
   }
   isFlippedX = flip;
 }
@@ -524,7 +536,7 @@ void RuntimeSpriteObject::FlipX(bool flip) {
 void RuntimeSpriteObject::FlipY(bool flip) {
   if (flip != isFlippedY) {
     scaleY *= -1.0;
-    needUpdateCurrentSprite = true;
+    OnTransformChanged();
   }
   isFlippedY = flip;
 }
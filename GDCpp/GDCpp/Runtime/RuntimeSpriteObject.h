@@ -52,7 +52,9 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
                       const gd::SpriteObject& spriteObject);
   virtual ~RuntimeSpriteObject();
   virtual std::unique_ptr<RuntimeObject> Clone() const {
-    return gd::make_unique<RuntimeSpriteObject>(*this);
+    auto clone = gd::make_unique<RuntimeSpriteObject>(*this);
+    clone->OnTransformChanged();  // Don't keep a pointer to our sprite.
+    return clone;
   }
 
   virtual bool ExtraInitializationFromInitialInstance(
@@ -70,7 +72,7 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
 
   virtual void Update(const RuntimeScene& scene);
 
-  virtual void OnPositionChanged() { needUpdateCurrentSprite = true; };
+  virtual void OnPositionChanged() { OnTransformChanged(); };
 
   virtual float GetWidth() const;
   virtual float GetHeight() const;
@@ -86,7 +88,19 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   virtual bool SetAngle(float newAngle);
   virtual float GetAngle() const;
 
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
+  /**
+   * \brief Get the hitboxes of the current sprite, in "world" coordinates.
+   *
+   * The hitboxes are cached, and only computed again when the position, the
+   * angle, the scale or the current sprite of the object changed.
+   */
+  virtual const std::vector<Polygon2d>& GetHitBoxes() const;
+
+  /**
+   * \brief Get the object AABB, cached like the hitboxes.
+   */
+  virtual sf::FloatRect GetAABB() const;
+
   virtual bool CursorOnObject(RuntimeScene& scene, bool accurate);
 
   /**
@@ -336,6 +350,23 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   mutable gd::Sprite* ptrToCurrentSprite;  // Pointer to the current sprite
   mutable bool needUpdateCurrentSprite;
 
+  mutable std::vector<Polygon2d>
+      hitBoxes;  ///< The hitboxes of the current sprite, in world coordinates.
+  mutable sf::FloatRect aabb;       ///< The AABB of the object.
+  mutable bool needUpdateHitBoxes;  ///< True if hitBoxes must be computed.
+  mutable bool needUpdateAABB;      ///< True if aabb must be computed.
+
+  /**
+   * \brief Mark the SFML sprite, the hitboxes and the AABB as needing to be
+   * updated, after a change of the position, the angle, the scale or the
+   * current sprite.
+   */
+  void OnTransformChanged() {
+    needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
+    needUpdateAABB = true;
+  }
+
   std::vector<AnimationProxy> animations;
 
   float opacity;
@@ -5,6 +5,7 @@
  */
 #include "SceneStack.h"
 #include "CodeExecutionEngine.h"
+#include "GDCpp/Runtime/ImageManager.h"
 #include "RuntimeGame.h"
 #include "RuntimeScene.h"
 #include "SceneNameMangler.h"
@@ -12,6 +13,9 @@
 bool SceneStack::Step() {
   if (stack.empty()) return false;
 
+  if (!preloader.IsDone() && game.GetImageManager())
+    preloader.UploadImages(*game.GetImageManager(), uploadsPerStep);
+
   auto& scene = stack.back();
   if (scene->RenderAndStep()) {
     auto request = scene->GetRequestedChange();
@@ -49,8 +53,20 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
     return nullptr;
   }
 
+  // Decode the images of the scene in parallel, so that they are already
+  // loaded when the objects are created.
+  if (game.GetImageManager()) {
+    if (preloader.GetPreloadedLayoutName() != newSceneName)
+      preloader.PreloadLayout(game, game.GetLayout(newSceneName));
+    preloader.Finish(*game.GetImageManager());
+  }
+
   std::unique_ptr<RuntimeScene> newScene(new RuntimeScene(window, &game));
-  if (!newScene->LoadFromScene(game.GetLayout(newSceneName))) {
+  bool loaded = newScene->LoadFromScene(game.GetLayout(newSceneName));
+  // Keep the preloaded textures for the lifetime of the scene, so that the
+  // objects created later do not decode them again.
+  newScene->KeepTexturesLoaded(preloader.TakeTextures());
+  if (!loaded) {
     if (errorCallback)
       errorCallback("Unable to load scene \"" + newSceneName + "\".");
     return nullptr;
@@ -68,6 +84,12 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
   return stack.back().get();
 }
 
+void SceneStack::PreloadScene(const gd::String& sceneName) {
+  if (!game.HasLayoutNamed(sceneName)) return;
+
+  preloader.PreloadLayout(game, game.GetLayout(sceneName));
+}
+
 RuntimeScene* SceneStack::Replace(gd::String newSceneName, bool clear) {
   if (clear) {
     while (!stack.empty()) stack.pop_back();
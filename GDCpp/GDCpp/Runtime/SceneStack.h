@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <vector>
+#include "GDCpp/Runtime/ResourcesPreloader.h"
 class RuntimeGame;
 class RuntimeScene;
 namespace sf {
@@ -64,6 +65,23 @@ class GD_API SceneStack {
    */
   RuntimeScene *Replace(gd::String newSceneName, bool clear = false);
 
+  /**
+   * \brief Start decoding in background the images of a scene, so that it is
+   * started faster when pushed (or when replacing the current scene).
+   *
+   * The textures are created a few at a time by each call to Step, and the
+   * remaining ones when the scene is pushed.
+   * \see gd::ResourcesPreloader
+   */
+  void PreloadScene(const gd::String &sceneName);
+
+  /**
+   * \brief Return the progress, between 0 and 1, of the preloading of the
+   * images of the scene given to PreloadScene. Can be polled by a loading
+   * screen.
+   */
+  float GetPreloadingProgress() const { return preloader.GetProgress(); }
+
   /**
    * \brief Set the callback called when an error occurs (loading failed...)
    */
@@ -82,4 +100,8 @@ class GD_API SceneStack {
   std::vector<std::unique_ptr<RuntimeScene>> stack;
   std::function<void(gd::String)> errorCallback;
   std::function<bool(RuntimeScene &)> loadCallback;
+  gd::ResourcesPreloader preloader;
+
+  static const std::size_t uploadsPerStep =
+      8;  ///< Textures of preloaded images created at each step.
 };
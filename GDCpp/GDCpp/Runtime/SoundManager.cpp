@@ -61,9 +61,9 @@ void SoundManager::PlayMusic(const gd::String& name,
 #if !defined(GD_IDE_ONLY)
   gd::ResourcesLoader* ressourcesLoader = gd::ResourcesLoader::Get();
   if (ressourcesLoader->HasFile(file)) {
-    std::size_t size = ressourcesLoader->GetBinaryFileSize(file);
-    music->SetBuffer(ressourcesLoader->LoadBinaryFile(file), size);
-    music->OpenFromMemory(size);
+    gd::ResourceData data = ressourcesLoader->LoadBinaryFile(file);
+    music->SetBuffer(data.GetData(), data.GetSize());
+    music->OpenFromMemory(data.GetSize());
   } else
 #endif
   {
@@ -89,9 +89,9 @@ void SoundManager::PlayMusicOnChannel(const gd::String& name,
 #if !defined(GD_IDE_ONLY)
   gd::ResourcesLoader* ressourcesLoader = gd::ResourcesLoader::Get();
   if (ressourcesLoader->HasFile(file)) {
-    std::size_t size = ressourcesLoader->GetBinaryFileSize(file);
-    music->SetBuffer(ressourcesLoader->LoadBinaryFile(file), size);
-    music->OpenFromMemory(size);
+    gd::ResourceData data = ressourcesLoader->LoadBinaryFile(file);
+    music->SetBuffer(data.GetData(), data.GetSize());
+    music->OpenFromMemory(data.GetSize());
   } else
 #endif
   {
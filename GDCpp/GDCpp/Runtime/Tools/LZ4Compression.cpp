@@ -0,0 +1,204 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/Tools/LZ4Compression.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace {
+const std::size_t MinMatch = 4;
+const std::size_t MaxOffset = 65535;
+// Rules of the block format: the last 5 bytes are always literals, and the
+// last match must start at least 12 bytes before the end.
+const std::size_t LastLiterals = 5;
+const std::size_t MatchFindLimit = 12;
+const unsigned int HashLog = 12;
+
+std::uint32_t Read32(const unsigned char* ptr) {
+  std::uint32_t value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+std::size_t Hash(std::uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+/**
+ * Write the extra bytes of a literals or match length whose 4 bits in the
+ * token are all set.
+ */
+bool WriteLength(std::size_t length,
+                 unsigned char*& output,
+                 unsigned char* outputEnd) {
+  for (; length >= 255; length -= 255) {
+    if (output == outputEnd) return false;
+    *output++ = 255;
+  }
+  if (output == outputEnd) return false;
+  *output++ = static_cast<unsigned char>(length);
+  return true;
+}
+
+bool ReadLength(const unsigned char*& input,
+                const unsigned char* inputEnd,
+                std::size_t& length) {
+  unsigned char byte;
+  do {
+    if (input == inputEnd) return false;
+    byte = *input++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+/**
+ * Write a sequence made of literals followed by a match. The last sequence of
+ * a block has no match (\a matchLength is 0).
+ */
+bool WriteSequence(const unsigned char* literals,
+                   std::size_t literalsLength,
+                   std::size_t offset,
+                   std::size_t matchLength,
+                   unsigned char*& output,
+                   unsigned char* outputEnd) {
+  if (output == outputEnd) return false;
+  unsigned char* token = output++;
+  *token = static_cast<unsigned char>(
+      (literalsLength >= 15 ? 15 : literalsLength) << 4);
+  if (literalsLength >= 15 &&
+      !WriteLength(literalsLength - 15, output, outputEnd))
+    return false;
+
+  if (static_cast<std::size_t>(outputEnd - output) < literalsLength)
+    return false;
+  memcpy(output, literals, literalsLength);
+  output += literalsLength;
+  if (matchLength == 0) return true;
+
+  if (outputEnd - output < 2) return false;
+  *output++ = static_cast<unsigned char>(offset & 0xFF);
+  *output++ = static_cast<unsigned char>(offset >> 8);
+
+  std::size_t length = matchLength - MinMatch;
+  *token |= static_cast<unsigned char>(length >= 15 ? 15 : length);
+  if (length >= 15 && !WriteLength(length - 15, output, outputEnd))
+    return false;
+
+  return true;
+}
+}  // namespace
+
+std::size_t LZ4Compression::GetMaxCompressedSize(std::size_t size) {
+  return size + size / 255 + 16;
+}
+
+std::size_t LZ4Compression::Compress(const char* source,
+                                     std::size_t sourceSize,
+                                     char* destination,
+                                     std::size_t capacity) {
+  const unsigned char* input = reinterpret_cast<const unsigned char*>(source);
+  unsigned char* output = reinterpret_cast<unsigned char*>(destination);
+  unsigned char* outputEnd = output + capacity;
+
+  std::size_t anchor = 0;  // Start of the literals not written yet.
+  if (sourceSize > MatchFindLimit && sourceSize <= UINT32_MAX) {
+    // The position of the last occurrence of each hashed 4 bytes sequence.
+    std::unique_ptr<std::uint32_t[]> positions(
+        new std::uint32_t[std::size_t(1) << HashLog]());
+
+    const std::size_t matchStartLimit = sourceSize - MatchFindLimit;
+    const std::size_t matchEndLimit = sourceSize - LastLiterals;
+    std::size_t position = 0;
+    while (position < matchStartLimit) {
+      std::uint32_t sequence = Read32(input + position);
+      std::uint32_t& lastPosition = positions[Hash(sequence)];
+      std::size_t candidate = lastPosition;
+      lastPosition = static_cast<std::uint32_t>(position);
+
+      if (candidate >= position || position - candidate > MaxOffset ||
+          Read32(input + candidate) != sequence) {
+        ++position;
+        continue;
+      }
+
+      std::size_t matchLength = MinMatch;
+      while (position + matchLength < matchEndLimit &&
+             input[candidate + matchLength] == input[position + matchLength])
+        ++matchLength;
+
+      if (!WriteSequence(input + anchor,
+                         position - anchor,
+                         position - candidate,
+                         matchLength,
+                         output,
+                         outputEnd))
+        return 0;
+
+      position += matchLength;
+      anchor = position;
+    }
+  }
+
+  if (!WriteSequence(
+          input + anchor, sourceSize - anchor, 0, 0, output, outputEnd))
+    return 0;
+
+  return output - reinterpret_cast<unsigned char*>(destination);
+}
+
+bool LZ4Compression::Decompress(const char* source,
+                                std::size_t sourceSize,
+                                char* destination,
+                                std::size_t destinationSize) {
+  const unsigned char* input = reinterpret_cast<const unsigned char*>(source);
+  const unsigned char* inputEnd = input + sourceSize;
+  unsigned char* outputStart = reinterpret_cast<unsigned char*>(destination);
+  unsigned char* output = outputStart;
+  unsigned char* outputEnd = output + destinationSize;
+
+  while (input != inputEnd) {
+    const unsigned char token = *input++;
+
+    std::size_t literalsLength = token >> 4;
+    if (literalsLength == 15 && !ReadLength(input, inputEnd, literalsLength))
+      return false;
+    if (static_cast<std::size_t>(inputEnd - input) < literalsLength ||
+        static_cast<std::size_t>(outputEnd - output) < literalsLength)
+      return false;
+    memcpy(output, input, literalsLength);
+    input += literalsLength;
+    output += literalsLength;
+
+    // The last sequence is made only of literals.
+    if (input == inputEnd) return output == outputEnd;
+
+    if (inputEnd - input < 2) return false;
+    std::size_t offset = input[0] | (input[1] << 8);
+    input += 2;
+    if (offset == 0 || offset > static_cast<std::size_t>(output - outputStart))
+      return false;
+
+    std::size_t matchLength = token & 15;
+    if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+      return false;
+    matchLength += MinMatch;
+    if (static_cast<std::size_t>(outputEnd - output) < matchLength)
+      return false;
+
+    // The match can overlap the bytes being written (for repeated patterns),
+    // so it's copied byte per byte in this case.
+    const unsigned char* match = output - offset;
+    if (offset >= matchLength) {
+      memcpy(output, match, matchLength);
+      output += matchLength;
+    } else {
+      for (std::size_t i = 0; i < matchLength; ++i) *output++ = *match++;
+    }
+  }
+
+  return false;  // A block always ends with literals.
+}
@@ -0,0 +1,52 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_LZ4COMPRESSION_H
+#define GDCPP_LZ4COMPRESSION_H
+#include <cstddef>
+
+/**
+ * \brief Compress and decompress buffers using the LZ4 block format.
+ *
+ * The compressor is a simple greedy one, fast enough to pack the resources of
+ * a game. The decompressor is what matters at runtime: it checks all the
+ * offsets and lengths so that a corrupted input can't write outside of the
+ * destination buffer.
+ *
+ * \see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ * \ingroup ResourcesManagement
+ */
+class GD_API LZ4Compression {
+ public:
+  /**
+   * \brief Return the maximum size of the compressed version of a buffer
+   * of the given size.
+   */
+  static std::size_t GetMaxCompressedSize(std::size_t size);
+
+  /**
+   * \brief Compress \a source into \a destination.
+   *
+   * \return The size of the compressed data, or 0 if it does not fit in
+   * \a capacity bytes.
+   */
+  static std::size_t Compress(const char* source,
+                              std::size_t sourceSize,
+                              char* destination,
+                              std::size_t capacity);
+
+  /**
+   * \brief Decompress \a source into \a destination.
+   *
+   * \return true if \a source was valid and decompressed to exactly
+   * \a destinationSize bytes.
+   */
+  static bool Decompress(const char* source,
+                         std::size_t sourceSize,
+                         char* destination,
+                         std::size_t destinationSize);
+};
+
+#endif  // GDCPP_LZ4COMPRESSION_H
@@ -0,0 +1,58 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Command line tool packing the resources of a native game into a
+ * resources archive (see gd::ResourcesArchive).
+ *
+ * Usage: ResourcesPacker [--no-compression] archive.egd directory [files...]
+ *
+ * The files are relative to the directory. If no files are given, they are
+ * read from the standard input, one per line, so that a whole directory can be
+ * packed with `cd directory && find . -type f | sed 's|^\./||' |
+ * ResourcesPacker archive.egd .`.
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+#include "GDCpp/Runtime/ResourcesArchive.h"
+#include "GDCpp/Runtime/String.h"
+
+int main(int argc, char* argv[]) {
+  std::vector<gd::String> arguments;
+  for (int i = 1; i < argc; ++i)
+    arguments.push_back(gd::String::FromLocale(argv[i]));
+
+  bool compress = true;
+  if (!arguments.empty() && arguments[0] == "--no-compression") {
+    compress = false;
+    arguments.erase(arguments.begin());
+  }
+
+  if (arguments.size() < 2) {
+    std::cout << "Usage: ResourcesPacker [--no-compression] archive.egd "
+                 "directory [files...]"
+              << std::endl;
+    return 1;
+  }
+
+  gd::String destination = arguments[0];
+  gd::String directory = arguments[1];
+  std::vector<gd::String> files(arguments.begin() + 2, arguments.end());
+  if (files.empty()) {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      if (!line.empty()) files.push_back(gd::String::FromLocale(line));
+    }
+  }
+
+  if (!gd::ResourcesArchive::Create(files, directory, destination, compress))
+    return 1;
+
+  std::cout << files.size() << " files packed into " << destination
+            << std::endl;
+  return 0;
+}
@@ -110,7 +110,7 @@ int main( int argc, char *p_argv[] )
         int size = (fsize+15)&(~15);
 
         cout << "Getting src raw data..." << endl;
-        char * ibuffer = resLoader->LoadBinaryFile( "src" );
+        gd::ResourceData ibuffer = resLoader->LoadBinaryFile( "src" );
         char * obuffer = new char[size];
 
         unsigned char key[] = "-P:j$4t&OHIUVM/Z+u4DeDP.";
@@ -118,22 +118,33 @@ int main( int argc, char *p_argv[] )
 
         aes_ks_t keySetting;
         aes_setks_decrypt(key, 192, &keySetting);
-        aes_cbc_decrypt(reinterpret_cast<const unsigned char*>(ibuffer), reinterpret_cast<unsigned char*>(obuffer),
+        aes_cbc_decrypt(reinterpret_cast<const unsigned char*>(ibuffer.GetData()), reinterpret_cast<unsigned char*>(obuffer),
             (uint8_t*)iv, size/AES_BLOCK_SIZE, &keySetting);
 
         std::string uncryptedSrc = std::string(obuffer, size);
         delete [] obuffer;
 
         cout << "Loading game data..." << endl;
-        TiXmlDocument doc;
-        if ( !doc.Parse(uncryptedSrc.c_str()) )
+        gd::SerializerElement rootElement;
+        if ( gd::Serializer::IsBinary(uncryptedSrc.data(), fsize) )
         {
-            return DisplayMessage("Unable to parse game data. Aborting.");
+            //Game data saved in the binary format (without the AES padding).
+            std::size_t errorPosition;
+            rootElement = gd::Serializer::FromBinary(uncryptedSrc.data(), fsize, &errorPosition);
+            if ( errorPosition != std::string::npos )
+                return DisplayMessage("Unable to read game data. Aborting.");
+        }
+        else
+        {
+            TiXmlDocument doc;
+            if ( !doc.Parse(uncryptedSrc.c_str()) )
+            {
+                return DisplayMessage("Unable to parse game data. Aborting.");
+            }
+
+            TiXmlHandle hdl(&doc);
+            gd::Serializer::FromXML(rootElement, hdl.FirstChildElement().Element());
         }
-
-        TiXmlHandle hdl(&doc);
-        gd::SerializerElement rootElement;
-        gd::Serializer::FromXML(rootElement, hdl.FirstChildElement().Element());
         game.UnserializeFrom(rootElement);
 	}
 
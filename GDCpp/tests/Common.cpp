@@ -9,7 +9,10 @@
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/AllocationsCounter.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "catch.hpp"
 
@@ -41,6 +44,22 @@ TEST_CASE("RuntimeScene", "[common]") {
     REQUIRE(scene.GetVariables().Get("MaVar").GetString() == "Hello");
     REQUIRE(scene.GetVariables().Get("MaVar2").GetValue() == 42);
   }
+  SECTION("No memory allocated by steady-state frames") {
+    gd::Object object("MyObject");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    for (std::size_t i = 0; i < 100; ++i) {
+      scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, object)));
+    }
+
+    scene.RenderAndStep();  // First frame, filling the objects lists.
+
+    std::size_t allocationsCount = AllocationsCounter::GetCount();
+    for (std::size_t i = 0; i < 10; ++i) scene.RenderAndStep();
+    REQUIRE(AllocationsCounter::GetCount() == allocationsCount);
+  }
 }
 
 TEST_CASE("gd::Project", "[common]") {
@@ -0,0 +1,139 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the recording and the export of the frames profiles.
+ */
+#include <set>
+#include <sstream>
+#include <string>
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include "GDCpp/Runtime/JobsPool.h"
+#include "GDCpp/Runtime/String.h"
+#include "catch.hpp"
+
+namespace {
+std::set<gd::String> GetEventsNames(const FrameProfiler::Frame& frame) {
+  std::set<gd::String> names;
+  for (const FrameProfiler::Event& event : frame.events)
+    names.insert(event.GetName());
+
+  return names;
+}
+}  // namespace
+
+TEST_CASE("FrameProfiler", "[game-engine]") {
+  FrameProfiler::SetMaximumFramesCount(120);
+
+  SECTION("Nothing is recorded when disabled") {
+    FrameProfiler::SetEnabled(false);
+    { GD_PROFILE_SCOPE("Scope"); }
+    FrameProfiler::EndFrame();
+    REQUIRE(FrameProfiler::GetFramesCount() == 0);
+  }
+  SECTION("Scopes") {
+    FrameProfiler::SetEnabled();
+    {
+      GD_PROFILE_SCOPE("Parent");
+      { GD_PROFILE_SCOPE("Child"); }
+      { GD_PROFILE_SCOPE(gd::String("Layer")); }
+    }
+    REQUIRE(FrameProfiler::GetFramesCount() == 0);
+    FrameProfiler::EndFrame();
+    FrameProfiler::SetEnabled(false);
+
+    REQUIRE(FrameProfiler::GetFramesCount() == 1);
+    const FrameProfiler::Frame& frame = FrameProfiler::GetFrame(0);
+    REQUIRE(frame.number == 0);
+    REQUIRE(frame.events.size() == 4);
+    REQUIRE(frame.events[0].GetName() == gd::String("Child"));
+    REQUIRE(frame.events[1].GetName() == gd::String("Layer"));
+    REQUIRE(frame.events[2].GetName() == gd::String("Parent"));
+    REQUIRE(frame.events[3].GetName() == gd::String("Frame"));
+
+    // Children are inside their parent, which is inside the frame.
+    const FrameProfiler::Event& child = frame.events[0];
+    const FrameProfiler::Event& parent = frame.events[2];
+    REQUIRE(child.start >= parent.start);
+    std::int64_t childEnd = child.start + child.duration;
+    std::int64_t parentEnd = parent.start + parent.duration;
+    REQUIRE(childEnd <= parentEnd);
+    REQUIRE(parent.start >= frame.start);
+    REQUIRE(parentEnd <= frame.end);
+  }
+  SECTION("Ring buffer of frames") {
+    FrameProfiler::SetMaximumFramesCount(3);
+    FrameProfiler::SetEnabled();
+    for (std::size_t i = 0; i < 5; ++i) {
+      { GD_PROFILE_SCOPE("Scope"); }
+      FrameProfiler::EndFrame();
+    }
+    FrameProfiler::SetEnabled(false);
+
+    REQUIRE(FrameProfiler::GetFramesCount() == 3);
+    REQUIRE(FrameProfiler::GetFrame(0).number == 2);
+    REQUIRE(FrameProfiler::GetFrame(2).number == 4);
+    REQUIRE(FrameProfiler::GetFrame(2).events.size() == 2);
+
+    // Enabling the profiler again removes the frames.
+    FrameProfiler::SetEnabled();
+    REQUIRE(FrameProfiler::GetFramesCount() == 0);
+    FrameProfiler::SetEnabled(false);
+  }
+  SECTION("Scopes from other threads") {
+    JobsPool pool(4);
+    FrameProfiler::SetEnabled();
+    pool.ParallelFor(100, 10, [](std::size_t, std::size_t) {
+      GD_PROFILE_SCOPE("Job");
+    });
+    FrameProfiler::EndFrame();
+    FrameProfiler::SetEnabled(false);
+
+    REQUIRE(FrameProfiler::GetFrame(0).events.size() == 10 + 1);
+    REQUIRE(GetEventsNames(FrameProfiler::GetFrame(0)) ==
+            std::set<gd::String>({"Job", "Frame"}));
+  }
+  SECTION("Counters") {
+    FrameProfiler::SetEnabled();
+    FrameProfiler::SetCounter("Memory", 1);
+    FrameProfiler::SetCounter("Memory", 2);
+    FrameProfiler::SetCounter("Hits", 3);
+    FrameProfiler::EndFrame();
+    FrameProfiler::EndFrame();
+    FrameProfiler::SetEnabled(false);
+    FrameProfiler::SetCounter("Memory", 4);
+
+    REQUIRE(FrameProfiler::GetFramesCount() == 2);
+    const FrameProfiler::Frame& frame = FrameProfiler::GetFrame(0);
+    REQUIRE(frame.counters.size() == 2);
+    REQUIRE(frame.counters[0].name == std::string("Memory"));
+    REQUIRE(frame.counters[0].value == 2);
+    REQUIRE(frame.counters[1].name == std::string("Hits"));
+    REQUIRE(frame.counters[1].value == 3);
+    REQUIRE(FrameProfiler::GetFrame(1).counters.empty());
+
+    std::ostringstream output;
+    FrameProfiler::ExportChromeTrace(output);
+    REQUIRE(output.str().find("{\"name\":\"Memory\",\"ph\":\"C\"") !=
+            std::string::npos);
+    REQUIRE(output.str().find("\"args\":{\"value\":3}}") !=
+            std::string::npos);
+  }
+  SECTION("Chrome trace export") {
+    FrameProfiler::SetEnabled();
+    { GD_PROFILE_SCOPE("A \"quoted\" name"); }
+    FrameProfiler::EndFrame();
+    FrameProfiler::SetEnabled(false);
+
+    std::ostringstream output;
+    FrameProfiler::ExportChromeTrace(output);
+    std::string trace = output.str();
+    REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+    REQUIRE(trace.find("{\"name\":\"A \\\"quoted\\\" name\",\"ph\":\"X\"") !=
+            std::string::npos);
+    REQUIRE(trace.find("{\"name\":\"Frame\",\"ph\":\"X\"") !=
+            std::string::npos);
+  }
+}
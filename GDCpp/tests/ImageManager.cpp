@@ -0,0 +1,129 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the textures cache of the image manager.
+ */
+#include <memory>
+#include <SFML/Graphics.hpp>
+#include "GDCore/Project/ResourcesManager.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/String.h"
+#include "catch.hpp"
+
+namespace {
+std::shared_ptr<SFMLTextureWrapper> CreateTexture() {
+  auto texture = std::make_shared<SFMLTextureWrapper>();
+  texture->image.create(16, 16, sf::Color::Red);
+  return texture;
+}
+}  // namespace
+
+TEST_CASE("ImageManager", "[game-engine]") {
+  gd::ResourcesManager resourcesManager;
+  gd::ImageManager imageManager;
+  imageManager.SetResourcesManager(&resourcesManager);
+
+  // The pixels are stored in the image and in the texture.
+  const std::size_t textureSize = 16 * 16 * 4 * 2;
+  auto isLoaded = [&](int index) {
+    return imageManager.HasLoadedSFMLTexture("Image" + gd::String::From(index));
+  };
+  auto addTexture = [&](int index) {
+    imageManager.AddDecodedTexture("Image" + gd::String::From(index),
+                                   CreateTexture());
+  };
+
+  SECTION("Textures not used anymore are kept within the budget") {
+    addTexture(1);
+    addTexture(2);
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 2 * textureSize);
+    REQUIRE(isLoaded(1));
+    REQUIRE(isLoaded(2));
+    REQUIRE(imageManager.GetEvictionsCount() == 0);
+
+    // Lowering the budget evicts the textures.
+    imageManager.SetTexturesMemoryBudget(textureSize);
+    REQUIRE(!isLoaded(1));
+    REQUIRE(isLoaded(2));
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == textureSize);
+    REQUIRE(imageManager.GetEvictionsCount() == 1);
+  }
+  SECTION("Least recently used textures are evicted first") {
+    imageManager.SetTexturesMemoryBudget(3 * textureSize);
+    addTexture(1);
+    addTexture(2);
+    addTexture(3);
+
+    imageManager.GetSFMLTexture("Image1");
+    REQUIRE(imageManager.GetCacheHitsCount() == 1);
+    REQUIRE(imageManager.GetCacheMissesCount() == 0);
+
+    addTexture(4);
+    REQUIRE(imageManager.GetEvictionsCount() == 1);
+    REQUIRE(isLoaded(1));
+    REQUIRE(!isLoaded(2));
+    REQUIRE(isLoaded(3));
+    REQUIRE(isLoaded(4));
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 3 * textureSize);
+
+    // A working set larger than the budget.
+    for (int i = 5; i <= 20; ++i) addTexture(i);
+    REQUIRE(imageManager.GetEvictionsCount() == 17);
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 3 * textureSize);
+    REQUIRE(!isLoaded(17));
+    REQUIRE(isLoaded(18));
+    REQUIRE(isLoaded(19));
+    REQUIRE(isLoaded(20));
+  }
+  SECTION("Textures used and permanently loaded textures are not evicted") {
+    imageManager.SetTexturesMemoryBudget(2 * textureSize);
+    std::shared_ptr<SFMLTextureWrapper> used =
+        imageManager.AddDecodedTexture("Used", CreateTexture());
+    {
+      std::shared_ptr<SFMLTextureWrapper> permanent = CreateTexture();
+      permanent->texture.loadFromImage(permanent->image);
+      imageManager.SetSFMLTextureAsPermanentlyLoaded("Permanent", permanent);
+    }
+
+    for (int i = 1; i <= 4; ++i) addTexture(i);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Used"));
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Permanent"));
+    REQUIRE(!isLoaded(3));
+    REQUIRE(isLoaded(4));  // Still used when it was added.
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 3 * textureSize);
+
+    used.reset();
+    imageManager.EvictTextures();
+    REQUIRE(!imageManager.HasLoadedSFMLTexture("Used"));
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Permanent"));
+    REQUIRE(isLoaded(4));
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 2 * textureSize);
+  }
+  SECTION("Cache hits do not evict textures") {
+    imageManager.SetTexturesMemoryBudget(textureSize);
+    std::shared_ptr<SFMLTextureWrapper> used1 =
+        imageManager.AddDecodedTexture("Image1", CreateTexture());
+    std::shared_ptr<SFMLTextureWrapper> used2 =
+        imageManager.AddDecodedTexture("Image2", CreateTexture());
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 2 * textureSize);
+
+    used1.reset();
+    imageManager.GetSFMLTexture("Image2");
+    REQUIRE(imageManager.GetCacheHitsCount() == 1);
+    REQUIRE(isLoaded(1));
+    REQUIRE(imageManager.GetEvictionsCount() == 0);
+
+    imageManager.EvictTextures();
+    REQUIRE(!isLoaded(1));
+    REQUIRE(isLoaded(2));
+    REQUIRE(imageManager.GetEvictionsCount() == 1);
+  }
+  SECTION("Missing images") {
+    imageManager.GetSFMLTexture("NotExisting");
+    REQUIRE(imageManager.GetCacheMissesCount() == 1);
+    REQUIRE(imageManager.GetTexturesMemoryUsage() == 0);
+  }
+}
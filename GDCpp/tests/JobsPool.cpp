@@ -0,0 +1,146 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering JobsPool and the parallel stepping of object-local
+ * behaviors.
+ */
+#include <atomic>
+#include <vector>
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCpp/Runtime/JobsPool.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief Move its owner, and record the position seen by the non
+ * object-local behaviors.
+ */
+class MovingRuntimeBehavior : public RuntimeBehavior {
+ public:
+  MovingRuntimeBehavior(const gd::SerializerElement& content,
+                        std::vector<float>* seenPositions_ = nullptr)
+      : RuntimeBehavior(content), seenPositions(seenPositions_){};
+  virtual ~MovingRuntimeBehavior(){};
+  virtual RuntimeBehavior* Clone() const {
+    return new MovingRuntimeBehavior(*this);
+  }
+
+ protected:
+  virtual void DoStepPreEvents(RuntimeScene& scene) {
+    if (seenPositions)
+      seenPositions->push_back(object->GetX());
+    else
+      object->SetX(object->GetX() + 1);
+  }
+  virtual void DoStepPostEvents(RuntimeScene& scene) {
+    if (!seenPositions) object->SetY(object->GetY() + object->GetX());
+  }
+
+ private:
+  std::vector<float>* seenPositions;
+};
+}  // namespace
+
+TEST_CASE("JobsPool", "[game-engine]") {
+  SECTION("Each index is handled exactly once") {
+    for (std::size_t threadsCount : {1, 2, 3, 8}) {
+      JobsPool pool(threadsCount);
+      REQUIRE(pool.GetThreadsCount() == threadsCount);
+
+      for (std::size_t count : {0, 1, 7, 64, 1000}) {
+        std::vector<std::atomic<int>> calls(count);
+        for (auto& call : calls) call = 0;
+        std::atomic<int> badChunksCount(0);
+
+        pool.ParallelFor(count, 5, [&](std::size_t begin, std::size_t end) {
+          if (begin >= end || end - begin > 5) badChunksCount++;
+          for (std::size_t i = begin; i < end; ++i) calls[i]++;
+        });
+
+        REQUIRE(badChunksCount == 0);
+        for (auto& call : calls) REQUIRE(call == 1);
+      }
+    }
+  }
+  SECTION("Changing the number of threads") {
+    JobsPool pool;
+    REQUIRE(pool.GetThreadsCount() == 1);
+    pool.SetThreadsCount(4);
+    REQUIRE(pool.GetThreadsCount() == 4);
+    pool.SetThreadsCount(0);
+    REQUIRE(pool.GetThreadsCount() == JobsPool::GetHardwareThreadsCount());
+
+    std::atomic<std::size_t> total(0);
+    pool.ParallelFor(100, 1, [&](std::size_t begin, std::size_t end) {
+      total += end - begin;
+    });
+    REQUIRE(total == 100);
+  }
+}
+
+TEST_CASE("RuntimeScene - Object-local behaviors", "[game-engine]") {
+  gd::Object object("MyObject");
+  gd::SerializerElement content;
+
+  RuntimeGame game;
+  auto stepScene = [&](std::size_t threadsCount,
+                       std::vector<float>& positions,
+                       std::vector<float>& seenPositions) {
+    RuntimeScene scene(NULL, &game);
+    scene.SetBehaviorsThreadsCount(threadsCount);
+    for (std::size_t i = 0; i < 500; ++i) {
+      std::unique_ptr<RuntimeObject> newObject(new RuntimeObject(scene, object));
+      newObject->SetX(i);
+
+      std::unique_ptr<RuntimeBehavior> localBehavior(
+          new MovingRuntimeBehavior(content));
+      localBehavior->SetObjectLocal();
+      newObject->AddBehavior("Local", std::move(localBehavior));
+
+      // Objects having only object-local behaviors, stepped in parallel, are
+      // mixed with objects having another behavior.
+      if (i % 100 < 10)
+        newObject->AddBehavior("A",  // Before "Local" in the behaviors map.
+                               std::unique_ptr<RuntimeBehavior>(
+                                   new MovingRuntimeBehavior(content,
+                                                             &seenPositions)));
+      scene.objectsInstances.AddObject(std::move(newObject));
+    }
+
+    for (std::size_t i = 0; i < 3; ++i) scene.RenderAndStep();
+    for (RuntimeObject* obj : scene.objectsInstances.GetAllObjects()) {
+      positions.push_back(obj->GetX());
+      positions.push_back(obj->GetY());
+    }
+  };
+
+  std::vector<float> expectedPositions, expectedSeenPositions;
+  stepScene(1, expectedPositions, expectedSeenPositions);
+  REQUIRE(expectedPositions.size() == 1000);
+  REQUIRE(expectedPositions[0] == 3);
+  REQUIRE(expectedPositions[1] == 1 + 2 + 3);
+
+  // The behaviors of an object are stepped in their order, whatever they are
+  // object-local or not.
+  REQUIRE(expectedSeenPositions.size() == 150);
+  REQUIRE(expectedSeenPositions[0] == 0);
+  REQUIRE(expectedSeenPositions[1] == 1);
+  REQUIRE(expectedSeenPositions[50] == 1);
+  REQUIRE(expectedSeenPositions[100] == 2);
+
+  for (std::size_t threadsCount : {2, 4, 16}) {
+    std::vector<float> positions, seenPositions;
+    stepScene(threadsCount, positions, seenPositions);
+    REQUIRE(positions == expectedPositions);
+    REQUIRE(seenPositions == expectedSeenPositions);
+  }
+}
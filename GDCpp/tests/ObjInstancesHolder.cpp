@@ -11,6 +11,7 @@
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/NamesTable.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
@@ -62,4 +63,150 @@ TEST_CASE("ObjInstancesHolder", "[common]") {
     REQUIRE(container.GetObjects("2").size() == 3);
     REQUIRE(container.GetObjectsRawPointers("2").size() == 3);
   }
+  SECTION("Objects found by name identifier") {
+    gd::Object obj1("1");
+    gd::Object obj2("2");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    std::size_t id1 = NamesTable::GetId("1");
+    std::size_t id2 = NamesTable::GetId("2");
+    std::size_t id3 = NamesTable::GetId("NonExistingObject");
+    REQUIRE(id1 != id2);
+    REQUIRE(NamesTable::GetId("1") == id1);
+    REQUIRE(NamesTable::GetIdIfExists("2") == id2);
+    REQUIRE(NamesTable::GetName(id2) == "2");
+
+    ObjInstancesHolder container;
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    REQUIRE(container.GetObjects(id1).size() == 1);
+    REQUIRE(container.GetObjects(id2).size() == 0);
+    REQUIRE(container.GetObjects(id3).size() == 0);
+
+    // Lists requested before objects are added are still used.
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+    RuntimeObject* obj2BPtr = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+    REQUIRE(container.GetObjects(id2).size() == 2);
+    REQUIRE(container.GetObjectsRawPointers(id2).size() == 2);
+
+    container.RemoveObject(obj2BPtr);
+    REQUIRE(container.GetObjects(id2).size() == 1);
+    REQUIRE(container.GetObjectsRawPointers(id2).size() == 1);
+
+    ObjInstancesHolder copy = container;
+    REQUIRE(copy.GetObjects(id1).size() == 1);
+    REQUIRE(copy.GetObjects(id2).size() == 1);
+
+    container.Clear();
+    REQUIRE(container.GetObjects(id1).size() == 0);
+    REQUIRE(container.GetObjectsRawPointers(id2).size() == 0);
+
+    container = copy;
+    REQUIRE(container.GetObjects(id1).size() == 1);
+    REQUIRE(container.GetObjects(id2).size() == 1);
+  }
+  SECTION("Objects sorted by layer and Z order") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    ObjInstancesHolder container;
+    auto addObject = [&](const gd::String& layer, int zOrder) {
+      std::unique_ptr<RuntimeObject> object(new RuntimeObject(scene, obj1));
+      object->SetLayer(layer);
+      object->SetZOrder(zOrder);
+      return container.AddObject(std::move(object));
+    };
+
+    RuntimeObject* objA = addObject("", 3);
+    RuntimeObject* objB = addObject("", 1);
+    RuntimeObject* objC = addObject("Layer2", 2);
+    RuntimeObject* objD = addObject("", 2);
+    container.UpdateLayersObjects();
+
+    REQUIRE(container.GetObjectsOnLayer("") ==
+            RuntimeObjNonOwningPtrList({objB, objD, objA}));
+    REQUIRE(container.GetObjectsOnLayer("Layer2") ==
+            RuntimeObjNonOwningPtrList({objC}));
+
+    // Changing Z order and layer
+    objA->SetZOrder(0);
+    objB->SetLayer("Layer2");
+    RuntimeObject* objE = addObject("Layer2", 2);
+    container.UpdateLayersObjects();
+
+    REQUIRE(container.GetObjectsOnLayer("") ==
+            RuntimeObjNonOwningPtrList({objA, objD}));
+    REQUIRE(container.GetObjectsOnLayer("Layer2") ==
+            RuntimeObjNonOwningPtrList({objB, objC, objE}));
+
+    // Removing objects
+    objD->SetLayer("Layer2");
+    container.RemoveObject(objD);
+    container.RemoveObject(objC);
+    container.UpdateLayersObjects();
+
+    REQUIRE(container.GetObjectsOnLayer("") ==
+            RuntimeObjNonOwningPtrList({objA}));
+    REQUIRE(container.GetObjectsOnLayer("Layer2") ==
+            RuntimeObjNonOwningPtrList({objB, objE}));
+  }
+  SECTION("Removing several objects") {
+    gd::Object obj1("1");
+    gd::Object obj2("2");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    ObjInstancesHolder& container = scene.objectsInstances;
+    std::vector<RuntimeObject*> objects1;
+    std::vector<RuntimeObject*> objects2;
+    for (std::size_t i = 0; i < 5; ++i) {
+      objects1.push_back(container.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1))));
+      objects2.push_back(container.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2))));
+    }
+    container.UpdateLayersObjects();
+
+    // Objects deleted from the scene are not in the lists of their name
+    // anymore, but are still in the container until they are removed.
+    objects1[1]->DeleteFromScene(scene);
+    objects1[3]->DeleteFromScene(scene);
+    REQUIRE(container.GetObjectsRawPointers("1") ==
+            RuntimeObjNonOwningPtrList(
+                {objects1[0], objects1[2], objects1[4]}));
+    REQUIRE(container.GetObjectsRawPointers("").size() == 2);
+    REQUIRE(container.GetAllObjects().size() == 10);
+
+    // Remove objects, in any order, and with duplicates.
+    container.RemoveObjects(RuntimeObjNonOwningPtrList(
+        {objects1[3], objects2[4], objects1[1], objects2[0], objects2[4]}));
+    REQUIRE(container.GetAllObjects().size() == 7);
+    REQUIRE(container.GetObjectsRawPointers("").size() == 0);
+    REQUIRE(container.GetObjectsRawPointers("2") ==
+            RuntimeObjNonOwningPtrList(
+                {objects2[1], objects2[2], objects2[3]}));
+    REQUIRE(container.GetObjectsOnLayer("") ==
+            RuntimeObjNonOwningPtrList({objects1[0],
+                                        objects2[1],
+                                        objects1[2],
+                                        objects2[2],
+                                        objects2[3],
+                                        objects1[4]}));
+
+    // Objects can still be removed one by one.
+    container.RemoveObject(objects2[2]);
+    REQUIRE(container.GetObjects("2").size() == 2);
+    REQUIRE(container.GetObjects("2")[1].get() == objects2[3]);
+    container.RemoveObject(objects2[3]);
+    REQUIRE(container.GetObjectsRawPointers("2") ==
+            RuntimeObjNonOwningPtrList({objects2[1]}));
+    REQUIRE(container.GetAllObjects().size() == 5);
+  }
 }
@@ -0,0 +1,76 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of ObjInstancesHolder, when a lot of objects are destroyed
+ * during the same frame.
+ */
+#include <chrono>
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("ObjInstancesHolder - Benchmarks", "[game-engine]") {
+  gd::Object bulletObject("Bullet");
+  gd::Object enemyObject("Enemy");
+
+  RuntimeGame game;
+
+  auto doBenchmark = [&](std::size_t instancesCount,
+                         std::size_t destroyedCount,
+                         bool removeAtOnce) {
+    RuntimeScene scene(NULL, &game);
+    ObjInstancesHolder& container = scene.objectsInstances;
+    for (std::size_t i = 0; i < instancesCount; ++i) {
+      container.AddObject(std::unique_ptr<RuntimeObject>(
+          new RuntimeObject(scene, i % 7 ? bulletObject : enemyObject)));
+    }
+    container.UpdateLayersObjects();
+
+    // Destroy one bullet out of every few ones, as done by the events, then
+    // remove them from the container, as done at the end of the frame.
+    auto start = std::chrono::steady_clock::now();
+    RuntimeObjNonOwningPtrList bullets =
+        container.GetObjectsRawPointers("Bullet");
+    std::size_t step = bullets.size() / destroyedCount;
+    for (std::size_t i = 0; i < destroyedCount; ++i)
+      bullets[i * step]->DeleteFromScene(scene);
+
+    RuntimeObjNonOwningPtrList removedObjects =
+        container.GetObjectsRawPointers("");
+    if (removeAtOnce) {
+      container.RemoveObjects(removedObjects);
+    } else {
+      for (RuntimeObject* object : removedObjects)
+        container.RemoveObject(object);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    REQUIRE(container.GetAllObjects().size() ==
+            instancesCount - destroyedCount);
+    REQUIRE(container.GetObjectsOnLayer("").size() ==
+            instancesCount - destroyedCount);
+    std::cout << "Destroying " << destroyedCount << " of " << instancesCount
+              << " objects " << (removeAtOnce ? "at once" : "one by one")
+              << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  SECTION("10,000 instances") {
+    doBenchmark(10000, 2000, false);
+    doBenchmark(10000, 2000, true);
+  }
+  SECTION("50,000 instances") {
+    doBenchmark(50000, 10000, false);
+    doBenchmark(50000, 10000, true);
+  }
+}
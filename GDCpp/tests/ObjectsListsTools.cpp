@@ -11,6 +11,7 @@
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
 #include "GDCpp/Extensions/Builtin/RuntimeSceneTools.h"
+#include "GDCpp/Runtime/AllocationsCounter.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
@@ -101,6 +102,83 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1[0] == &obj1A);
     REQUIRE(list2[0] == &obj2C);
   }
+  SECTION("TwoObjectListsTestWithBroadphase") {
+    std::map<gd::String, std::vector<RuntimeObject*>*> map1;
+    std::map<gd::String, std::vector<RuntimeObject*>*> map2;
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B, &obj2C};
+    map1["1"] = &list1;
+    map2["2"] = &list2;
+    obj1A.SetX(0);
+    obj1A.SetY(0);
+    obj1B.SetX(500);
+    obj1B.SetY(0);
+    obj1C.SetX(2000);
+    obj1C.SetY(2000);
+    obj2A.SetX(10);
+    obj2A.SetY(0);
+    obj2B.SetX(5000);
+    obj2B.SetY(0);
+    obj2C.SetX(-2000);
+    obj2C.SetY(-2000);
+
+    std::size_t predicateCallsCount = 0;
+    auto isNear = [&predicateCallsCount](RuntimeObject* obj1,
+                                         RuntimeObject* obj2) {
+      predicateCallsCount++;
+      return obj1->GetSqDistanceWithObject(obj2) <= 20 * 20;
+    };
+
+    // Only the pairs of objects close to each other are tested.
+    REQUIRE(TwoObjectListsTestWithBroadphase(map1, map2, true, 20, isNear) ==
+            true);
+    REQUIRE(predicateCallsCount == 1);
+    REQUIRE(list1.size() == 2);  // obj1A should have been filtered out.
+    REQUIRE(list2.size() == 3);
+    REQUIRE(list1[0] == &obj1B);
+    REQUIRE(list1[1] == &obj1C);
+
+    list1 = {&obj1A, &obj1B, &obj1C};
+    REQUIRE(TwoObjectListsTestWithBroadphase(map1, map2, false, 20, isNear) ==
+            true);
+    REQUIRE(list1.size() == 1);  // All objects but obj1A and obj2A
+    REQUIRE(list2.size() == 1);  // should have been filtered out
+    REQUIRE(list1[0] == &obj1A);
+    REQUIRE(list2[0] == &obj2A);
+
+    obj2A.SetX(100);
+    list1 = {&obj1A, &obj1B, &obj1C};
+    list2 = {&obj2A, &obj2B, &obj2C};
+    REQUIRE(TwoObjectListsTestWithBroadphase(map1, map2, false, 20, isNear) ==
+            false);
+    REQUIRE(list1.size() == 0);
+    REQUIRE(list2.size() == 0);
+  }
+  SECTION("No memory allocated once warm") {
+    std::map<gd::String, std::vector<RuntimeObject*>*> map1;
+    std::map<gd::String, std::vector<RuntimeObject*>*> map2;
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B, &obj2C};
+    map1["1"] = &list1;
+    map2["2"] = &list2;
+
+    auto always = [](RuntimeObject*) { return true; };
+    auto alwaysForPairs = [](RuntimeObject*, RuntimeObject*) { return true; };
+    auto pickObjects = [&]() {
+      bool picked = PickObjectsIf(map1, false, always);
+      picked = TwoObjectListsTest(map1, map2, false, alwaysForPairs) && picked;
+      return picked;
+    };
+
+    REQUIRE(pickObjects() == true);
+
+    std::size_t allocationsCount = AllocationsCounter::GetCount();
+    bool picked = pickObjects();
+    REQUIRE(AllocationsCounter::GetCount() == allocationsCount);
+    REQUIRE(picked == true);
+    REQUIRE(list1.size() == 3);
+    REQUIRE(list2.size() == 3);
+  }
   SECTION("PickNearestObject") {
     std::map<gd::String, std::vector<RuntimeObject*>*> map;
     std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
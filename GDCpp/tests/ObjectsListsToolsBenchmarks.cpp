@@ -0,0 +1,117 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the objects lists tools used by conditions comparing two
+ * lists of objects (collisions, distances...).
+ */
+#include <chrono>
+#include <cmath>
+#include <random>
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+class SizedRuntimeObject : public RuntimeObject {
+ public:
+  SizedRuntimeObject(RuntimeScene& scene, const gd::Object& object)
+      : RuntimeObject(scene, object){};
+
+  virtual float GetWidth() const { return 32; };
+  virtual float GetHeight() const { return 32; };
+};
+}  // namespace
+
+TEST_CASE("ObjectsListsTools - Benchmarks", "[game-engine]") {
+  gd::Object bulletObject("Bullet");
+  gd::Object enemyObject("Enemy");
+
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+
+  auto doBenchmark = [&](std::size_t instancesCount, bool runNaiveTest) {
+    // Same proportion of bullets and enemies as in a shoot'em up, spread on
+    // an area growing with the number of instances.
+    std::size_t enemiesCount = instancesCount / 7;
+    std::size_t bulletsCount = instancesCount - enemiesCount;
+    float areaSize = std::sqrt(static_cast<float>(instancesCount)) * 64;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(0, areaSize);
+    std::vector<std::unique_ptr<RuntimeObject>> objects;
+    std::vector<RuntimeObject*> bullets;
+    std::vector<RuntimeObject*> enemies;
+    for (std::size_t i = 0; i < instancesCount; ++i) {
+      bool isEnemy = i < enemiesCount;
+      objects.emplace_back(new SizedRuntimeObject(
+          scene, isEnemy ? enemyObject : bulletObject));
+      objects.back()->SetX(position(generator));
+      objects.back()->SetY(position(generator));
+      (isEnemy ? enemies : bullets).push_back(objects.back().get());
+    }
+
+    auto runTest = [&](bool useBroadphase,
+                       std::size_t& pickedBullets,
+                       std::size_t& pickedEnemies) {
+      std::vector<RuntimeObject*> pickedBulletsList = bullets;
+      std::vector<RuntimeObject*> pickedEnemiesList = enemies;
+      std::map<gd::String, std::vector<RuntimeObject*>*> map1;
+      std::map<gd::String, std::vector<RuntimeObject*>*> map2;
+      map1["Bullet"] = &pickedBulletsList;
+      map2["Enemy"] = &pickedEnemiesList;
+
+      std::size_t predicateCallsCount = 0;
+      auto isColliding = [&predicateCallsCount](RuntimeObject* obj1,
+                                                RuntimeObject* obj2) {
+        predicateCallsCount++;
+        return obj1->IsCollidingWith(obj2);
+      };
+
+      auto start = std::chrono::steady_clock::now();
+      if (useBroadphase)
+        TwoObjectListsTestWithBroadphase(map1, map2, false, 0, isColliding);
+      else
+        TwoObjectListsTest(map1, map2, false, isColliding);
+      auto end = std::chrono::steady_clock::now();
+
+      pickedBullets = pickedBulletsList.size();
+      pickedEnemies = pickedEnemiesList.size();
+      std::cout << "TwoObjectListsTest"
+                << (useBroadphase ? "WithBroadphase" : "") << " with "
+                << instancesCount << " instances: " << predicateCallsCount
+                << " pairs tested, "
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       end - start)
+                       .count()
+                << " microseconds" << std::endl;
+    };
+
+    std::size_t pickedBullets = 0, pickedEnemies = 0;
+    runTest(true, pickedBullets, pickedEnemies);
+    REQUIRE(pickedBullets > 0);
+    REQUIRE(pickedEnemies > 0);
+
+    if (runNaiveTest) {
+      std::size_t naivePickedBullets = 0, naivePickedEnemies = 0;
+      runTest(false, naivePickedBullets, naivePickedEnemies);
+      REQUIRE(naivePickedBullets == pickedBullets);
+      REQUIRE(naivePickedEnemies == pickedEnemies);
+    } else {
+      std::cout << "TwoObjectListsTest with " << instancesCount
+                << " instances: up to " << bulletsCount * enemiesCount
+                << " pairs tested (skipped)" << std::endl;
+    }
+  };
+
+  SECTION("1,000 instances") { doBenchmark(1000, true); }
+  SECTION("10,000 instances") { doBenchmark(10000, true); }
+  SECTION("50,000 instances") { doBenchmark(50000, false); }
+}
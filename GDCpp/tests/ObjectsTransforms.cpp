@@ -0,0 +1,145 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the storage of the objects positions and forces.
+ */
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/NamesTable.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("ObjectsTransforms", "[game-engine]") {
+  SECTION("Slots") {
+    ObjectsTransforms transforms;
+    std::size_t slot1 = transforms.AllocateSlot();
+    std::size_t slot2 = transforms.AllocateSlot();
+    REQUIRE(slot1 != slot2);
+    REQUIRE(transforms.GetSlotsCount() == 2);
+
+    transforms.SetX(slot1, 10);
+    transforms.SetY(slot1, 20);
+    transforms.SetForce(slot1, 1, 2);
+    REQUIRE(transforms.GetX(slot1) == 10);
+    REQUIRE(transforms.GetY(slot1) == 20);
+    REQUIRE(transforms.IsMoving(slot1));
+    REQUIRE(!transforms.IsMoving(slot2));
+
+    // Released slots are reused, and reset.
+    transforms.ReleaseSlot(slot1);
+    REQUIRE(transforms.AllocateSlot() == slot1);
+    REQUIRE(transforms.GetSlotsCount() == 2);
+    REQUIRE(transforms.GetX(slot1) == 0);
+    REQUIRE(!transforms.IsMoving(slot1));
+  }
+  SECTION("Applying forces") {
+    ObjectsTransforms transforms;
+    std::size_t slot1 = transforms.AllocateSlot();
+    std::size_t slot2 = transforms.AllocateSlot();
+    transforms.SetForce(slot1, 10, -20);
+    transforms.SetForce(slot2, 10, 0);
+    transforms.SetLayerNameId(slot1, 0);
+    transforms.SetLayerNameId(slot2, 1);
+    transforms.SetInScene(slot1, true);
+    transforms.SetInScene(slot2, true);
+
+    std::vector<double> elapsedTimes = {0.5, 2};
+    transforms.ApplyForces(elapsedTimes);
+    REQUIRE(transforms.GetX(slot1) == 5);
+    REQUIRE(transforms.GetY(slot1) == -10);
+    REQUIRE(transforms.GetX(slot2) == 20);
+    REQUIRE(transforms.GetY(slot2) == 0);
+
+    // Slots of objects not in the scene are not moved.
+    transforms.SetInScene(slot2, false);
+    transforms.ApplyForces(elapsedTimes);
+    REQUIRE(transforms.GetX(slot1) == 10);
+    REQUIRE(transforms.GetX(slot2) == 20);
+  }
+  SECTION("RuntimeObject") {
+    gd::Object object("MyObject");
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    const ObjectsTransforms& transforms = *scene.GetObjectsTransforms();
+
+    RuntimeObject runtimeObject(scene, object);
+    runtimeObject.SetX(42);
+    runtimeObject.SetY(24);
+    REQUIRE(&runtimeObject.GetObjectsTransforms() == &transforms);
+    REQUIRE(runtimeObject.GetX() == 42);
+    REQUIRE(runtimeObject.GetY() == 24);
+
+    runtimeObject.AddForce(10, 5, 0);
+    runtimeObject.AddForce(-3, 0, 0);
+    REQUIRE(runtimeObject.HasForces());
+    REQUIRE(runtimeObject.TotalForceX() == 7);
+    REQUIRE(runtimeObject.TotalForceY() == 5);
+
+    // Copies have their own slot.
+    std::unique_ptr<RuntimeObject> copy = runtimeObject.Clone();
+    copy->SetX(1);
+    REQUIRE(runtimeObject.GetX() == 42);
+    REQUIRE(copy->GetX() == 1);
+    REQUIRE(copy->GetY() == 24);
+    REQUIRE(copy->TotalForceX() == 7);
+
+    // Instant forces are removed after being applied.
+    runtimeObject.UpdateForce(1);
+    REQUIRE(!runtimeObject.HasForces());
+    REQUIRE(runtimeObject.TotalForceX() == 0);
+    REQUIRE(copy->TotalForceX() == 7);
+
+    copy->ClearForce();
+    REQUIRE(copy->TotalForceX() == 0);
+    REQUIRE(copy->TotalForceY() == 0);
+  }
+  SECTION("Objects added to the scene") {
+    gd::Object object("MyObject");
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    RuntimeScene otherScene(NULL, &game);
+    const ObjectsTransforms& transforms = *scene.GetObjectsTransforms();
+    const ObjectsTransforms& otherTransforms =
+        *otherScene.GetObjectsTransforms();
+
+    // Objects not added to the scene are not moved.
+    std::unique_ptr<RuntimeObject> notAdded(new RuntimeObject(scene, object));
+    notAdded->AddForce(10, 0, 1);
+    REQUIRE(!transforms.IsInScene(notAdded->GetObjectsTransformsSlot()));
+
+    RuntimeObject* added = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, object)));
+    REQUIRE(&added->GetObjectsTransforms() == &transforms);
+    REQUIRE(transforms.IsInScene(added->GetObjectsTransformsSlot()));
+
+    // An object created for another scene is moved to the transforms of the
+    // scene it is added to, and its previous slot is released.
+    std::unique_ptr<RuntimeObject> fromOtherScene(
+        new RuntimeObject(otherScene, object));
+    fromOtherScene->SetX(42);
+    fromOtherScene->AddForce(10, -10, 1);
+    std::size_t otherSlot = fromOtherScene->GetObjectsTransformsSlot();
+    RuntimeObject* moved =
+        scene.objectsInstances.AddObject(std::move(fromOtherScene));
+    REQUIRE(&moved->GetObjectsTransforms() == &transforms);
+    REQUIRE(transforms.IsInScene(moved->GetObjectsTransformsSlot()));
+    REQUIRE(moved->GetX() == 42);
+    REQUIRE(moved->TotalForceX() == 10);
+    REQUIRE(moved->TotalForceY() == -10);
+    REQUIRE(!otherTransforms.IsInScene(otherSlot));
+    REQUIRE(otherTransforms.GetX(otherSlot) == 0);
+
+    std::vector<double> elapsedTimes(NamesTable::GetCount(), 0.5);
+    scene.GetObjectsTransforms()->ApplyForces(elapsedTimes);
+    otherScene.GetObjectsTransforms()->ApplyForces(elapsedTimes);
+    REQUIRE(notAdded->GetX() == 0);
+    REQUIRE(moved->GetX() == 47);
+    REQUIRE(moved->GetY() == -5);
+  }
+}
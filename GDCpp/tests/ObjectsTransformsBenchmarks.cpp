@@ -0,0 +1,161 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the integration of the forces of the objects, reading
+ * the positions and forces through the objects or from ObjectsTransforms.
+ *
+ * On Linux, the cache misses of both methods are also measured, when the
+ * hardware counters are available.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/NamesTable.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+#if defined(LINUX)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/**
+ * \brief Count the cache misses of the current thread between Start and Stop,
+ * using the hardware counters of Linux.
+ */
+class CacheMissesCounter {
+ public:
+  CacheMissesCounter() : fd(-1) {
+#if defined(LINUX)
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    fd = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+  }
+  ~CacheMissesCounter() {
+#if defined(LINUX)
+    if (fd != -1) close(fd);
+#endif
+  }
+
+  /**
+   * \brief Return false if the hardware counters are not available (not
+   * Linux, virtual machines, or forbidden by perf_event_paranoid).
+   */
+  bool IsAvailable() const { return fd != -1; }
+
+  void Start() {
+#if defined(LINUX)
+    if (fd == -1) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  /**
+   * \brief Stop counting, and return the number of cache misses since Start.
+   */
+  std::uint64_t Stop() {
+    std::uint64_t count = 0;
+#if defined(LINUX)
+    if (fd == -1) return 0;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+    return count;
+  }
+
+ private:
+  int fd;
+};
+}  // namespace
+
+TEST_CASE("ObjectsTransforms - Benchmarks", "[game-engine]") {
+  gd::Object object("MyObject");
+  RuntimeGame game;
+  CacheMissesCounter cacheMissesCounter;
+  if (!cacheMissesCounter.IsAvailable())
+    std::cout << "Hardware counters not available: the cache misses are not "
+                 "measured."
+              << std::endl;
+
+  auto doBenchmark = [&](std::size_t instancesCount) {
+    RuntimeScene scene(NULL, &game);
+    std::vector<RuntimeObject*> objects;
+    for (std::size_t i = 0; i < instancesCount; ++i) {
+      objects.push_back(scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, object))));
+      objects.back()->AddForce(i % 10, i % 7, 1);
+    }
+    const double elapsedTime = 0.016;
+    const std::size_t framesCount = 100;
+    auto printResult = [&](const gd::String& method,
+                           std::chrono::steady_clock::duration duration,
+                           std::uint64_t cacheMisses) {
+      std::cout << framesCount << " integrations of " << instancesCount
+                << " objects, " << method << ": "
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       duration)
+                       .count()
+                << " microseconds";
+      if (cacheMissesCounter.IsAvailable())
+        std::cout << ", " << cacheMisses << " cache misses";
+      std::cout << std::endl;
+    };
+
+    // Objects moved one by one, as done before ObjectsTransforms: each
+    // object is visited, reading its forces and its layer.
+    cacheMissesCounter.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < framesCount; ++frame) {
+      for (RuntimeObject* runtimeObject : objects) {
+        runtimeObject->SetX(runtimeObject->GetX() +
+                            runtimeObject->TotalForceX() * elapsedTime);
+        runtimeObject->SetY(runtimeObject->GetY() +
+                            runtimeObject->TotalForceY() * elapsedTime);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    printResult("one by one", end - start, cacheMissesCounter.Stop());
+    float expectedX = objects.back()->GetX();
+    float expectedY = objects.back()->GetY();
+    for (RuntimeObject* runtimeObject : objects) {
+      runtimeObject->SetX(0);
+      runtimeObject->SetY(0);
+    }
+
+    // All objects moved at once by ObjectsTransforms.
+    std::vector<double> elapsedTimes(NamesTable::GetCount(), elapsedTime);
+    cacheMissesCounter.Start();
+    start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < framesCount; ++frame)
+      scene.GetObjectsTransforms()->ApplyForces(elapsedTimes);
+    end = std::chrono::steady_clock::now();
+    printResult(
+        "with ObjectsTransforms", end - start, cacheMissesCounter.Stop());
+
+    REQUIRE(objects.back()->GetX() == Approx(expectedX));
+    REQUIRE(objects.back()->GetY() == Approx(expectedY));
+  };
+
+  SECTION("10,000 instances") { doBenchmark(10000); }
+  SECTION("100,000 instances") { doBenchmark(100000); }
+}
@@ -0,0 +1,137 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the collision and raycast tests between polygons.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include "catch.hpp"
+
+namespace {
+Polygon2d CreateRegularPolygon(std::size_t verticesCount,
+                               float radius,
+                               float x,
+                               float y) {
+  Polygon2d polygon;
+  for (std::size_t i = 0; i < verticesCount; ++i) {
+    float angle = 2 * 3.14159f * i / verticesCount;
+    polygon.vertices.push_back(
+        sf::Vector2f(x + std::cos(angle) * radius, y + std::sin(angle) * radius));
+  }
+
+  return polygon;
+}
+}  // namespace
+
+TEST_CASE("PolygonCollision", "[game-engine]") {
+  SECTION("Collision test") {
+    Polygon2d rect1 = Polygon2d::CreateRectangle(10, 10);
+    Polygon2d rect2 = Polygon2d::CreateRectangle(10, 10);
+    rect2.Move(5, 0);
+    CollisionResult result = PolygonCollisionTest(rect1, rect2);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.move_axis.x == Approx(-5));
+    REQUIRE(result.move_axis.y == Approx(0));
+
+    rect2.Move(5, 0);  // Touching edges.
+    REQUIRE(PolygonCollisionTest(rect1, rect2).collision == true);
+    REQUIRE(PolygonCollisionTest(rect1, rect2, true).collision == false);
+
+    rect2.Move(1, 0);
+    REQUIRE(PolygonCollisionTest(rect1, rect2).collision == false);
+  }
+  SECTION("Collision test against several polygons") {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-50, 50);
+    for (std::size_t verticesCount : {3, 4, 8, 16, 17}) {
+      Polygon2d polygon = CreateRegularPolygon(verticesCount, 20, 0, 0);
+      std::vector<Polygon2d> others;
+      for (std::size_t i = 0; i < 50; ++i)
+        others.push_back(CreateRegularPolygon(
+            verticesCount, 10, position(generator), position(generator)));
+
+      std::vector<CollisionResult> results;
+      bool anyCollision = PolygonsCollisionTest(polygon, others, false, &results);
+      REQUIRE(results.size() == others.size());
+
+      bool expectedAnyCollision = false;
+      for (std::size_t i = 0; i < others.size(); ++i) {
+        CollisionResult expected = PolygonCollisionTest(polygon, others[i]);
+        REQUIRE(results[i].collision == expected.collision);
+        REQUIRE(results[i].move_axis.x == Approx(expected.move_axis.x));
+        REQUIRE(results[i].move_axis.y == Approx(expected.move_axis.y));
+        expectedAnyCollision |= expected.collision;
+      }
+      REQUIRE(anyCollision == expectedAnyCollision);
+      REQUIRE(PolygonsCollisionTest(polygon, others) == expectedAnyCollision);
+    }
+  }
+  SECTION("Raycast test") {
+    Polygon2d rect = Polygon2d::CreateRectangle(10, 10);
+    RaycastResult result = PolygonRaycastTest(rect, -10, 0, 10, 0);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.closePoint.x == Approx(-5));
+    REQUIRE(result.closeSqDist == Approx(25));
+    REQUIRE(result.farPoint.x == Approx(5));
+    REQUIRE(result.farSqDist == Approx(225));
+
+    REQUIRE(PolygonRaycastTest(rect, -10, 10, 10, 10).collision == false);
+  }
+  SECTION("Kernels give the same results with and without SIMD") {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate(-100, 100);
+    for (std::size_t count : {1, 3, 4, 7, 8, 9, 16, 33}) {
+      std::vector<sf::Vector2f> vertices, edges;
+      for (std::size_t i = 0; i < count; ++i) {
+        vertices.push_back(
+            sf::Vector2f(coordinate(generator), coordinate(generator)));
+        edges.push_back(
+            sf::Vector2f(coordinate(generator), coordinate(generator)));
+      }
+
+      sf::Vector2f axis(0.6, -0.8);
+      float min, max, simdMin, simdMax;
+      ProjectVerticesOnAxis(vertices.data(), count, axis, min, max, false);
+      ProjectVerticesOnAxis(vertices.data(), count, axis, simdMin, simdMax);
+      REQUIRE(min == Approx(simdMin));
+      REQUIRE(max == Approx(simdMax));
+
+      std::vector<float> crossesRS(count), crossesQPR(count), ts(count),
+          us(count);
+      std::vector<float> simdCrossesRS(count), simdCrossesQPR(count),
+          simdTs(count), simdUs(count);
+      sf::Vector2f rayStart(-20, 10), ray(150, -30);
+      ComputeRayEdgesIntersections(vertices.data(),
+                                   edges.data(),
+                                   count,
+                                   rayStart,
+                                   ray,
+                                   crossesRS.data(),
+                                   crossesQPR.data(),
+                                   ts.data(),
+                                   us.data(),
+                                   false);
+      ComputeRayEdgesIntersections(vertices.data(),
+                                   edges.data(),
+                                   count,
+                                   rayStart,
+                                   ray,
+                                   simdCrossesRS.data(),
+                                   simdCrossesQPR.data(),
+                                   simdTs.data(),
+                                   simdUs.data());
+      for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(crossesRS[i] == Approx(simdCrossesRS[i]));
+        REQUIRE(crossesQPR[i] == Approx(simdCrossesQPR[i]));
+        REQUIRE(ts[i] == Approx(simdTs[i]));
+        REQUIRE(us[i] == Approx(simdUs[i]));
+      }
+    }
+  }
+}
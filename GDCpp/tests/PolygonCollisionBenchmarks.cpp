@@ -0,0 +1,88 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the kernels used by the collision and raycast tests
+ * between polygons, with and without SIMD instructions.
+ */
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include "catch.hpp"
+
+TEST_CASE("PolygonCollision - Benchmarks", "[game-engine]") {
+  auto doBenchmark = [](std::size_t verticesCount) {
+    Polygon2d polygon;
+    for (std::size_t i = 0; i < verticesCount; ++i) {
+      float angle = 2 * 3.14159f * i / verticesCount;
+      polygon.vertices.push_back(
+          sf::Vector2f(std::cos(angle) * 32, std::sin(angle) * 32));
+    }
+    polygon.ComputeEdges();
+
+    const std::size_t iterationsCount = 1000000;
+    std::vector<float> crossesRS(verticesCount), crossesQPR(verticesCount),
+        ts(verticesCount), us(verticesCount);
+    for (bool useSimd : {false, true}) {
+      // Project the polygon on each of its axes, as done by the collision
+      // test (the sum is used to prevent the loop from being optimized out).
+      float sum = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < iterationsCount; ++i) {
+        float min, max;
+        const sf::Vector2f& edge = polygon.edges[i % verticesCount];
+        ProjectVerticesOnAxis(polygon.vertices.data(),
+                              verticesCount,
+                              sf::Vector2f(-edge.y, edge.x),
+                              min,
+                              max,
+                              useSimd);
+        sum += max - min;
+      }
+      auto end = std::chrono::steady_clock::now();
+      std::cout << iterationsCount << " projections of " << verticesCount
+                << " vertices" << (useSimd ? " (SIMD): " : " (scalar): ")
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       end - start)
+                       .count()
+                << " microseconds (" << sum << ")" << std::endl;
+
+      // Intersect rays with all the edges, as done by the raycast test.
+      sum = 0;
+      start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < iterationsCount; ++i) {
+        ComputeRayEdgesIntersections(polygon.vertices.data(),
+                                     polygon.edges.data(),
+                                     verticesCount,
+                                     sf::Vector2f(-100, i % 64 - 32),
+                                     sf::Vector2f(200, 0),
+                                     crossesRS.data(),
+                                     crossesQPR.data(),
+                                     ts.data(),
+                                     us.data(),
+                                     useSimd);
+        sum += ts[0];
+      }
+      end = std::chrono::steady_clock::now();
+      std::cout << iterationsCount << " intersections of a ray with "
+                << verticesCount << " edges"
+                << (useSimd ? " (SIMD): " : " (scalar): ")
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       end - start)
+                       .count()
+                << " microseconds (" << sum << ")" << std::endl;
+    }
+    if (!PolygonSimdInstructionsAvailable())
+      std::cout << "SIMD instructions are not enabled in this build."
+                << std::endl;
+  };
+
+  SECTION("4 vertices") { doBenchmark(4); }
+  SECTION("8 vertices") { doBenchmark(8); }
+  SECTION("16 vertices") { doBenchmark(16); }
+}
@@ -0,0 +1,203 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the resources archives and the LZ4 compression of their
+ * files.
+ */
+#include "GDCpp/Runtime/ResourcesArchive.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "GDCpp/Runtime/Tools/LZ4Compression.h"
+#include "catch.hpp"
+
+namespace {
+void WriteFile(const std::string& filename, const std::string& content) {
+  std::ofstream file(filename, std::ios_base::out | std::ios_base::binary);
+  file << content;
+}
+
+std::string LZ4RoundTrip(const std::string& input) {
+  std::string compressed(LZ4Compression::GetMaxCompressedSize(input.size()),
+                         '\0');
+  std::size_t compressedSize = LZ4Compression::Compress(
+      input.data(), input.size(), &compressed[0], compressed.size());
+  REQUIRE(compressedSize != 0);
+
+  std::string output(input.size(), '\0');
+  REQUIRE(LZ4Compression::Decompress(
+      compressed.data(), compressedSize, &output[0], output.size()));
+  return output;
+}
+}  // namespace
+
+TEST_CASE("LZ4Compression", "[game-engine]") {
+  SECTION("Round trips") {
+    REQUIRE(LZ4RoundTrip("") == "");
+    REQUIRE(LZ4RoundTrip("a") == "a");
+    REQUIRE(LZ4RoundTrip("Hello world!") == "Hello world!");
+
+    std::string repeated(10000, 'a');
+    REQUIRE(LZ4RoundTrip(repeated) == repeated);
+
+    std::string text;
+    for (int i = 0; i < 1000; ++i)
+      text += "{\"name\": \"MyObject" + std::to_string(i % 17) + "\"},";
+    REQUIRE(LZ4RoundTrip(text) == text);
+
+    std::string noise;
+    unsigned int seed = 42;
+    for (int i = 0; i < 100000; ++i) {
+      seed = seed * 1103515245 + 12345;
+      noise.push_back(char(seed >> 16));
+    }
+    REQUIRE(LZ4RoundTrip(noise) == noise);
+  }
+  SECTION("Compression ratio") {
+    std::string repeated(10000, 'a');
+    std::string compressed(
+        LZ4Compression::GetMaxCompressedSize(repeated.size()), '\0');
+    REQUIRE(LZ4Compression::Compress(repeated.data(),
+                                     repeated.size(),
+                                     &compressed[0],
+                                     compressed.size()) < 100);
+
+    // Not enough space to store the compressed data.
+    REQUIRE(LZ4Compression::Compress(
+                repeated.data(), repeated.size(), &compressed[0], 10) == 0);
+  }
+  SECTION("Invalid data") {
+    std::string text(1000, 'a');
+    std::string compressed(LZ4Compression::GetMaxCompressedSize(text.size()),
+                           '\0');
+    compressed.resize(LZ4Compression::Compress(
+        text.data(), text.size(), &compressed[0], compressed.size()));
+
+    std::string output(text.size(), '\0');
+    // Truncated input
+    REQUIRE(!LZ4Compression::Decompress(
+        compressed.data(), compressed.size() - 1, &output[0], output.size()));
+    // Output not having the expected size
+    REQUIRE(!LZ4Compression::Decompress(
+        compressed.data(), compressed.size(), &output[0], output.size() - 1));
+    // Offset going before the start of the output
+    const char invalidOffset[] = {0x10, 'a', 0x10, 0x00, 0x00};
+    REQUIRE(!LZ4Compression::Decompress(
+        invalidOffset, sizeof(invalidOffset), &output[0], output.size()));
+  }
+}
+
+TEST_CASE("ResourcesArchive", "[game-engine]") {
+  std::string text;
+  for (int i = 0; i < 1000; ++i) text += "Some text to be compressed. ";
+  std::string binary;
+  for (int i = 0; i < 1000; ++i) binary.push_back(char((i * 7919) % 251));
+
+  WriteFile("ResourcesArchiveTest-text.txt", text);
+  WriteFile("ResourcesArchiveTest-binary.bin", binary);
+  WriteFile("ResourcesArchiveTest-empty.bin", "");
+  std::vector<gd::String> files = {"ResourcesArchiveTest-text.txt",
+                                   "ResourcesArchiveTest-binary.bin",
+                                   "ResourcesArchiveTest-empty.bin"};
+
+  auto checkArchive = [&](const gd::ResourcesArchive& archive) {
+    REQUIRE(archive.IsOpen());
+    REQUIRE(archive.GetFilesCount() == 3);
+    REQUIRE(archive.ContainsFile("ResourcesArchiveTest-text.txt"));
+    REQUIRE(!archive.ContainsFile("ResourcesArchiveTest-text"));
+    REQUIRE(!archive.ContainsFile("NotExisting.txt"));
+    REQUIRE(archive.GetFileSize("ResourcesArchiveTest-text.txt") ==
+            text.size());
+    REQUIRE(archive.GetFileSize("NotExisting.txt") == 0);
+
+    gd::ResourceData textData =
+        archive.GetFile("ResourcesArchiveTest-text.txt");
+    REQUIRE(textData.IsValid());
+    REQUIRE(std::string(textData.GetData(), textData.GetSize()) == text);
+
+    gd::ResourceData binaryData =
+        archive.GetFile("ResourcesArchiveTest-binary.bin");
+    REQUIRE(binaryData.IsValid());
+    REQUIRE(std::string(binaryData.GetData(), binaryData.GetSize()) ==
+            binary);
+
+    gd::ResourceData emptyData =
+        archive.GetFile("ResourcesArchiveTest-empty.bin");
+    REQUIRE(emptyData.IsValid());
+    REQUIRE(emptyData.GetSize() == 0);
+
+    REQUIRE(!archive.GetFile("NotExisting.txt").IsValid());
+  };
+
+  SECTION("Archive without compression") {
+    REQUIRE(gd::ResourcesArchive::Create(
+        files, ".", "ResourcesArchiveTest.egd", false));
+
+    gd::ResourcesArchive archive;
+    REQUIRE(archive.Open("ResourcesArchiveTest.egd"));
+    checkArchive(archive);
+
+    // Files are returned without copies, at aligned positions.
+    gd::ResourceData textData =
+        archive.GetFile("ResourcesArchiveTest-text.txt");
+    REQUIRE(textData.GetData() ==
+            archive.GetFile("ResourcesArchiveTest-text.txt").GetData());
+    std::uintptr_t address =
+        reinterpret_cast<std::uintptr_t>(textData.GetData());
+    std::size_t misalignment = address % gd::ResourcesArchive::Alignment;
+    REQUIRE(misalignment == 0);
+  }
+  SECTION("Archive with compression") {
+    REQUIRE(gd::ResourcesArchive::Create(
+        files, ".", "ResourcesArchiveTest.egd", true));
+
+    std::ifstream archiveFile("ResourcesArchiveTest.egd",
+                              std::ios_base::binary | std::ios_base::ate);
+    REQUIRE(static_cast<std::size_t>(archiveFile.tellg()) <
+            text.size() / 2 + binary.size());
+
+    gd::ResourcesArchive archive;
+    REQUIRE(archive.Open("ResourcesArchiveTest.egd"));
+    checkArchive(archive);
+
+    archive.Close();
+    REQUIRE(!archive.IsOpen());
+    REQUIRE(!archive.ContainsFile("ResourcesArchiveTest-text.txt"));
+  }
+  SECTION("Invalid archives") {
+    gd::ResourcesArchive archive;
+    REQUIRE(!archive.Open("NotExisting.egd"));
+    REQUIRE(!archive.Open("ResourcesArchiveTest-text.txt"));
+    REQUIRE(!archive.IsOpen());
+
+    // Truncated archive
+    REQUIRE(gd::ResourcesArchive::Create(
+        files, ".", "ResourcesArchiveTest.egd", true));
+    std::ifstream archiveFile("ResourcesArchiveTest.egd",
+                              std::ios_base::binary);
+    std::string content((std::istreambuf_iterator<char>(archiveFile)),
+                        std::istreambuf_iterator<char>());
+    archiveFile.close();
+    WriteFile("ResourcesArchiveTest.egd",
+              content.substr(0, content.size() - 10));
+    REQUIRE(!archive.Open("ResourcesArchiveTest.egd"));
+
+    // Missing or duplicated files
+    REQUIRE(!gd::ResourcesArchive::Create(
+        {"NotExisting.txt"}, ".", "ResourcesArchiveTest.egd", true));
+    REQUIRE(!gd::ResourcesArchive::Create({"ResourcesArchiveTest-text.txt",
+                                           "ResourcesArchiveTest-text.txt"},
+                                          ".",
+                                          "ResourcesArchiveTest.egd",
+                                          true));
+  }
+
+  std::remove("ResourcesArchiveTest.egd");
+  for (const gd::String& file : files) std::remove(file.c_str());
+}
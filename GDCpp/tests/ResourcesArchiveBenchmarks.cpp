@@ -0,0 +1,106 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the loading of the files of a game, from the disk or
+ * from a resources archive (with and without compression).
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GDCpp/Runtime/ResourcesArchive.h"
+#include "GDCpp/Runtime/Tools/FileStream.h"
+#include "catch.hpp"
+
+TEST_CASE("ResourcesArchive - Benchmarks", "[game-engine]") {
+  // Half of the files are like images or sounds (not compressible), the other
+  // half are like texts or shaders. Each file is read entirely (as done when
+  // decoding an image or a sound), so that the pages of the memory-mapped
+  // archive are actually loaded.
+  const std::size_t filesCount = 5000;
+  std::vector<gd::String> files;
+  std::size_t expectedChecksum = 0;
+  unsigned int seed = 42;
+  for (std::size_t i = 0; i < filesCount; ++i) {
+    gd::String filename =
+        "ResourcesArchiveBenchmark-" + gd::String::From(i) + ".bin";
+    std::string content;
+    std::size_t size = 1024 + (i % 16) * 512;
+    if (i % 2 == 0) {
+      for (std::size_t j = 0; j < size; ++j) {
+        seed = seed * 1103515245 + 12345;
+        content.push_back(char(seed >> 16));
+      }
+    } else {
+      while (content.size() < size)
+        content += "uniform sampler2D texture; // " + std::to_string(i) + "\n";
+    }
+
+    std::ofstream file(filename.ToLocale(),
+                       std::ios_base::out | std::ios_base::binary);
+    file << content;
+    files.push_back(filename);
+    for (char byte : content) expectedChecksum += (unsigned char)byte;
+  }
+
+  auto getChecksum = [](const char* data, std::size_t size) {
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < size; ++i) checksum += (unsigned char)data[i];
+    return checksum;
+  };
+  auto doBenchmark = [&](const gd::String& name,
+                         std::function<std::size_t()> loadAllFiles) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t checksum = loadAllFiles();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Loading " << filesCount << " files " << name << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds" << std::endl;
+    REQUIRE(checksum == expectedChecksum);
+  };
+
+  doBenchmark("from the disk", [&]() {
+    std::size_t checksum = 0;
+    for (const gd::String& filename : files) {
+      gd::FileStream file(filename,
+                          std::ios_base::in | std::ios_base::binary |
+                              std::ios_base::ate);
+      REQUIRE(file.is_open());
+      std::size_t size = file.tellg();
+      std::unique_ptr<char[]> buffer(new char[size]);
+      file.seekg(0, std::ios::beg);
+      file.read(buffer.get(), size);
+      checksum += getChecksum(buffer.get(), size);
+    }
+    return checksum;
+  });
+
+  for (bool compress : {false, true}) {
+    REQUIRE(gd::ResourcesArchive::Create(
+        files, ".", "ResourcesArchiveBenchmark.egd", compress));
+    doBenchmark(compress ? "from a compressed archive" : "from an archive",
+                [&]() {
+                  gd::ResourcesArchive archive;
+                  archive.Open("ResourcesArchiveBenchmark.egd");
+                  std::size_t checksum = 0;
+                  for (const gd::String& filename : files) {
+                    gd::ResourceData data = archive.GetFile(filename);
+                    checksum += getChecksum(data.GetData(), data.GetSize());
+                  }
+                  return checksum;
+                });
+  }
+
+  std::remove("ResourcesArchiveBenchmark.egd");
+  for (const gd::String& filename : files)
+    std::remove(filename.ToLocale().c_str());
+}
@@ -0,0 +1,132 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the preloading of the images of a scene.
+ */
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <SFML/Graphics.hpp>
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Direction.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneStack.h"
+#include "catch.hpp"
+
+namespace {
+gd::SpriteObject CreateSpriteObject(const gd::String& name,
+                                    const std::vector<gd::String>& images) {
+  gd::SpriteObject object(name);
+  gd::Animation animation;
+  animation.SetDirectionsCount(1);
+  for (const gd::String& image : images) {
+    gd::Sprite sprite;
+    sprite.SetImageName(image);
+    animation.GetDirection(0).AddSprite(sprite);
+  }
+  object.AddAnimation(animation);
+  return object;
+}
+}  // namespace
+
+TEST_CASE("ResourcesPreloader", "[game-engine]") {
+  RuntimeGame game;
+  gd::Layout& layout = game.InsertNewLayout("Scene", 0);
+  layout.InsertObject(CreateSpriteObject("A", {"Image1", "Image2", "Image1"}),
+                      0);
+  layout.InsertObject(CreateSpriteObject("B", {"Image2", "Image3"}), 0);
+  game.InsertObject(CreateSpriteObject("Global", {"Image4"}), 0);
+
+  sf::Image image;
+  image.create(16, 16, sf::Color::Red);
+  for (int i = 1; i <= 4; ++i) {
+    gd::String file = "ResourcesPreloaderTest" + gd::String::From(i) + ".png";
+    REQUIRE(image.saveToFile(file.ToLocale()));
+    game.GetResourcesManager().AddResource(
+        "Image" + gd::String::From(i), file, "image");
+  }
+  gd::ImageManager& imageManager = *game.GetImageManager();
+
+  SECTION("Images of a layout") {
+    std::vector<gd::String> images =
+        gd::ResourcesPreloader::GetLayoutImages(game, layout);
+    REQUIRE(images.size() == 4);
+    REQUIRE(images[0] == "Image2");
+    REQUIRE(images[1] == "Image3");
+    REQUIRE(images[2] == "Image1");
+    REQUIRE(images[3] == "Image4");
+  }
+  SECTION("Preload a layout") {
+    gd::ResourcesPreloader preloader(4);
+    preloader.PreloadLayout(game, layout);
+    REQUIRE(preloader.GetPreloadedLayoutName() == "Scene");
+    REQUIRE(preloader.GetImagesCount() == 4);
+
+    preloader.Finish(imageManager);
+    REQUIRE(preloader.IsDone());
+    REQUIRE(preloader.GetDecodedImagesCount() == 4);
+    REQUIRE(preloader.GetProgress() == 1.f);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image3"));
+
+    std::shared_ptr<SFMLTextureWrapper> texture =
+        imageManager.GetSFMLTexture("Image3");
+    REQUIRE(texture->image.getSize().x == 16);
+    REQUIRE(texture->texture.getSize().x == 16);
+
+    // Textures not used anymore can be unloaded once the preloading is
+    // cleared.
+    preloader.Clear();
+    imageManager.SetTexturesMemoryBudget(0);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image3"));
+    REQUIRE(!imageManager.HasLoadedSFMLTexture("Image1"));
+    REQUIRE(preloader.GetImagesCount() == 0);
+
+    // Images already loaded are not preloaded again.
+    preloader.PreloadLayout(game, layout);
+    REQUIRE(preloader.GetImagesCount() == 3);
+  }
+  SECTION("Upload a limited number of textures") {
+    gd::ResourcesPreloader preloader(2);
+    preloader.Preload(game, {"Image1", "Image2", "NotExisting"});
+    REQUIRE(preloader.GetImagesCount() == 2);
+
+    while (preloader.GetDecodedImagesCount() < 2) std::this_thread::yield();
+    REQUIRE(preloader.UploadImages(imageManager, 1) == 1);
+    REQUIRE(!preloader.IsDone());
+    REQUIRE(preloader.UploadImages(imageManager, 1) == 1);
+    REQUIRE(preloader.IsDone());
+  }
+  SECTION("Preload a scene of a SceneStack") {
+    SceneStack stack(game, NULL);
+    stack.PreloadScene("Scene");
+    stack.Push("Scene");
+    REQUIRE(stack.GetPreloadingProgress() == 1.f);
+
+    // The preloaded textures are kept loaded while the scene exists, even if
+    // no object uses them yet...
+    imageManager.SetTexturesMemoryBudget(0);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1"));
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image4"));
+
+    // ...and can be unloaded after.
+    game.InsertNewLayout("OtherScene", 1);
+    stack.Replace("OtherScene");
+    imageManager.EvictTextures();
+    REQUIRE(!imageManager.HasLoadedSFMLTexture("Image1"));
+    REQUIRE(!imageManager.HasLoadedSFMLTexture("Image4"));
+  }
+
+  for (int i = 1; i <= 4; ++i)
+    std::remove(("ResourcesPreloaderTest" + gd::String::From(i) + ".png")
+                    .ToLocale()
+                    .c_str());
+}
@@ -0,0 +1,109 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the time taken to start a scene using 2000 images, with
+ * the images loaded one after the other or preloaded in parallel.
+ */
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Direction.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "catch.hpp"
+
+TEST_CASE("ResourcesPreloader - Benchmarks", "[game-engine]") {
+  const std::size_t imagesCount = 2000;
+  RuntimeGame game;
+  gd::Layout& layout = game.InsertNewLayout("Scene", 0);
+  gd::ImageManager& imageManager = *game.GetImageManager();
+
+  // Each object uses 10 images, like an animated sprite.
+  std::vector<gd::String> imageNames;
+  sf::Image image;
+  image.create(128, 128);
+  for (std::size_t i = 0; i < imagesCount; ++i) {
+    for (unsigned int x = 0; x < 128; ++x)
+      image.setPixel(x, i % 128, sf::Color(i % 256, x * 2, 0));
+
+    gd::String name = "Image" + gd::String::From(i);
+    gd::String file = "ResourcesPreloaderBenchmark-" + name + ".png";
+    REQUIRE(image.saveToFile(file.ToLocale()));
+    game.GetResourcesManager().AddResource(name, file, "image");
+    imageNames.push_back(name);
+  }
+  for (std::size_t i = 0; i < imagesCount / 10; ++i) {
+    gd::SpriteObject object("Object" + gd::String::From(i));
+    gd::Animation animation;
+    animation.SetDirectionsCount(1);
+    for (std::size_t j = 0; j < 10; ++j) {
+      gd::Sprite sprite;
+      sprite.SetImageName(imageNames[i * 10 + j]);
+      animation.GetDirection(0).AddSprite(sprite);
+    }
+    object.AddAnimation(animation);
+    layout.InsertObject(object, i);
+  }
+
+  // The textures are kept alive until the end of each benchmark, as they would
+  // be by the objects of the scene.
+  std::vector<std::shared_ptr<SFMLTextureWrapper>> textures;
+  auto doBenchmark = [&](const gd::String& name,
+                         std::function<void()> startScene) {
+    auto start = std::chrono::steady_clock::now();
+    startScene();
+    for (const gd::String& imageName : imageNames)
+      textures.push_back(imageManager.GetSFMLTexture(imageName));
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Starting a scene with " << imagesCount << " images " << name
+              << ": "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                       start)
+                     .count()
+              << " milliseconds" << std::endl;
+
+    for (const gd::String& imageName : imageNames)
+      REQUIRE(imageManager.HasLoadedSFMLTexture(imageName));
+    textures.clear();
+  };
+
+  doBenchmark("loaded one after the other", []() {});
+
+  gd::ResourcesPreloader preloader;
+  doBenchmark("preloaded in parallel (" +
+                  gd::String::From(JobsPool::GetHardwareThreadsCount()) +
+                  " threads)",
+              [&]() {
+                preloader.PreloadLayout(game, layout);
+                preloader.Finish(imageManager);
+              });
+  preloader.Clear();
+
+  // The scene is preloaded while another scene is running (as done by
+  // SceneStack::PreloadScene), so only the textures remain to be created when
+  // it is started.
+  preloader.PreloadLayout(game, layout);
+  while (preloader.GetDecodedImagesCount() < preloader.GetImagesCount())
+    std::this_thread::yield();
+  doBenchmark("preloaded in background",
+              [&]() { preloader.Finish(imageManager); });
+  preloader.Clear();
+
+  for (const gd::String& imageName : imageNames)
+    std::remove(("ResourcesPreloaderBenchmark-" + imageName + ".png")
+                    .ToLocale()
+                    .c_str());
+}
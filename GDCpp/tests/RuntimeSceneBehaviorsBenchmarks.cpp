@@ -0,0 +1,100 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the stepping of object-local behaviors, with a growing
+ * number of threads.
+ */
+#include <chrono>
+#include <cmath>
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief A behavior doing some computations to move its owner, as a movement
+ * behavior would do.
+ */
+class SteeringRuntimeBehavior : public RuntimeBehavior {
+ public:
+  SteeringRuntimeBehavior(const gd::SerializerElement& content)
+      : RuntimeBehavior(content){};
+  virtual ~SteeringRuntimeBehavior(){};
+  virtual RuntimeBehavior* Clone() const {
+    return new SteeringRuntimeBehavior(*this);
+  }
+
+ protected:
+  virtual void DoStepPreEvents(RuntimeScene& scene) {
+    float angle = object->GetAngle();
+    for (std::size_t i = 0; i < 200; ++i)
+      angle = std::fmod(angle + std::sin(angle) * 3.f + 1.f, 360.f);
+
+    object->SetAngle(angle);
+  }
+  virtual void DoStepPostEvents(RuntimeScene& scene) {
+    float angleInRadians = object->GetAngle() / 180.f * 3.14159f;
+    object->SetX(object->GetX() + std::cos(angleInRadians));
+    object->SetY(object->GetY() + std::sin(angleInRadians));
+  }
+};
+}  // namespace
+
+TEST_CASE("RuntimeScene - Behaviors benchmarks", "[game-engine]") {
+  gd::Object object("MyObject");
+  gd::SerializerElement content;
+  RuntimeGame game;
+
+  auto doBenchmark = [&](std::size_t instancesCount) {
+    std::vector<float> expectedPositions;
+    for (std::size_t threadsCount : {1, 2, 4, 8, 16}) {
+      RuntimeScene scene(NULL, &game);
+      scene.SetBehaviorsThreadsCount(threadsCount);
+      for (std::size_t i = 0; i < instancesCount; ++i) {
+        std::unique_ptr<RuntimeObject> newObject(
+            new RuntimeObject(scene, object));
+        newObject->SetAngle(i % 360);
+
+        std::unique_ptr<RuntimeBehavior> behavior(
+            new SteeringRuntimeBehavior(content));
+        behavior->SetObjectLocal();
+        newObject->AddBehavior("Steering", std::move(behavior));
+        scene.objectsInstances.AddObject(std::move(newObject));
+      }
+
+      scene.RenderAndStep();  // First frame, filling the objects lists.
+      auto start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < 10; ++i) scene.RenderAndStep();
+      auto end = std::chrono::steady_clock::now();
+
+      std::cout << "10 frames with " << instancesCount << " instances and "
+                << threadsCount << " thread(s): "
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       end - start)
+                       .count()
+                << " microseconds" << std::endl;
+
+      // The objects must be the same whatever the number of threads.
+      std::vector<float> positions;
+      for (RuntimeObject* obj : scene.objectsInstances.GetAllObjects()) {
+        positions.push_back(obj->GetX());
+        positions.push_back(obj->GetY());
+      }
+      if (threadsCount == 1)
+        expectedPositions = positions;
+      else
+        REQUIRE(positions == expectedPositions);
+    }
+  };
+
+  SECTION("1,000 instances") { doBenchmark(1000); }
+  SECTION("10,000 instances") { doBenchmark(10000); }
+}
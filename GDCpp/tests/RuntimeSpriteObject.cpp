@@ -13,6 +13,8 @@
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/AllocationsCounter.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
@@ -87,3 +89,81 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     }
   }
 }
+
+TEST_CASE("RuntimeSpriteObject - Hitboxes", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+
+  gd::SpriteObject obj1("SpriteObject");
+  {
+    gd::Animation anim;
+    anim.SetDirectionsCount(1);
+    for (float width : {10, 30}) {
+      gd::Sprite sprite;
+      Polygon2d rectangle;
+      rectangle.vertices.push_back(sf::Vector2f(0, 0));
+      rectangle.vertices.push_back(sf::Vector2f(width, 0));
+      rectangle.vertices.push_back(sf::Vector2f(width, 20));
+      rectangle.vertices.push_back(sf::Vector2f(0, 20));
+      sprite.SetCollisionMaskAutomatic(false);
+      sprite.SetDefaultCenterPoint(false);  // Rotate around the origin.
+      sprite.SetCustomCollisionMask(std::vector<Polygon2d>(1, rectangle));
+      anim.GetDirection(0).AddSprite(sprite);
+    }
+    obj1.AddAnimation(anim);
+  }
+
+  RuntimeSpriteObject object(scene, obj1);
+  object.SetX(100);
+  object.SetY(50);
+
+  SECTION("Hitboxes are in world coordinates") {
+    const std::vector<Polygon2d>& hitBoxes = object.GetHitBoxes();
+    REQUIRE(hitBoxes.size() == 1);
+    REQUIRE(hitBoxes[0].vertices[0] == sf::Vector2f(100, 50));
+    REQUIRE(hitBoxes[0].vertices[2] == sf::Vector2f(110, 70));
+    REQUIRE(hitBoxes[0].edges.size() == 4);
+  }
+  SECTION("Hitboxes are updated when the object is transformed") {
+    object.GetHitBoxes();
+    object.SetX(200);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0] == sf::Vector2f(200, 50));
+
+    object.SetScaleY(2);
+    REQUIRE(object.GetHitBoxes()[0].vertices[2] == sf::Vector2f(210, 90));
+
+    object.SetSprite(1);
+    REQUIRE(object.GetHitBoxes()[0].vertices[2] == sf::Vector2f(230, 90));
+
+    object.SetAngle(90);
+    const Polygon2d& rotated = object.GetHitBoxes()[0];
+    REQUIRE(rotated.vertices[2].x == Approx(160));
+    REQUIRE(rotated.vertices[2].y == Approx(80));
+  }
+  SECTION("Hitboxes are not computed again if the object is not transformed") {
+    object.GetHitBoxes();
+    object.GetAABB();
+
+    std::size_t allocationsCount = AllocationsCounter::GetCount();
+    object.SetOpacity(128);
+    object.SetColor(255, 0, 0);
+    for (std::size_t i = 0; i < 10; ++i) {
+      object.GetHitBoxes();
+      object.GetAABB();
+    }
+    REQUIRE(AllocationsCounter::GetCount() == allocationsCount);
+  }
+  SECTION("Collisions") {
+    RuntimeSpriteObject other(scene, obj1);
+    other.SetX(105);
+    other.SetY(60);
+    REQUIRE(
+        PolygonsCollisionTest(object.GetHitBoxes()[0], other.GetHitBoxes()));
+    REQUIRE(object.IsCollidingWithPoint(105, 55));
+
+    other.SetX(120);
+    REQUIRE(
+        !PolygonsCollisionTest(object.GetHitBoxes()[0], other.GetHitBoxes()));
+    REQUIRE(!object.IsCollidingWithPoint(115, 55));
+  }
+}
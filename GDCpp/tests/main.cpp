@@ -9,4 +9,18 @@
  * Please write any new test in a separate file.
  */
 #define CATCH_CONFIG_MAIN
+#include <cstdlib>
+#include <new>
+#include "GDCpp/Runtime/AllocationsCounter.h"
 #include "catch.hpp"
+
+// Count the allocations, so that tests can check that some functions are not
+// allocating memory. The array forms of new and delete call these ones.
+void* operator new(std::size_t size) {
+  AllocationsCounter::Increment();
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
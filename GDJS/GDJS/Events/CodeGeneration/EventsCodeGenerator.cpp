@@ -799,9 +799,12 @@ gd::String EventsCodeGenerator::GenerateEventsListCode(
                                   ? "runtimeScene"
                                   : "runtimeScene, eventsFunctionContext";
 
-  // Generate a unique name for the function.
-  gd::String functionName =
-      GetCodeNamespaceAccessor() + "eventsList" + gd::String::From(&events);
+  // Generate a unique name for the function. It does not depend on the
+  // address of the events in memory, so that the same events always give the
+  // same code.
+  gd::String functionName = GetCodeNamespaceAccessor() + "eventsList" +
+                            gd::String::From(eventsListNextUniqueId);
+  eventsListNextUniqueId++;
   // The only local parameters are runtimeScene and context.
   // List of objects, conditions booleans and any variables used by events
   // are stored in static variables that are globally available by the whole
@@ -1069,13 +1072,15 @@ gd::String EventsCodeGenerator::GenerateProfilerSectionEnd(
 
 EventsCodeGenerator::EventsCodeGenerator(gd::Project& project,
                                          const gd::Layout& layout)
-    : gd::EventsCodeGenerator(project, layout, JsPlatform::Get()) {}
+    : gd::EventsCodeGenerator(project, layout, JsPlatform::Get()),
+      eventsListNextUniqueId(0) {}
 
 EventsCodeGenerator::EventsCodeGenerator(
     gd::ObjectsContainer& globalObjectsAndGroups,
     const gd::ObjectsContainer& objectsAndGroups)
     : gd::EventsCodeGenerator(
-          JsPlatform::Get(), globalObjectsAndGroups, objectsAndGroups) {}
+          JsPlatform::Get(), globalObjectsAndGroups, objectsAndGroups),
+      eventsListNextUniqueId(0) {}
 
 EventsCodeGenerator::~EventsCodeGenerator() {}
 
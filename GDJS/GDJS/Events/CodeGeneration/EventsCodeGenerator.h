@@ -347,6 +347,9 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
 
   gd::String codeNamespace;  ///< Optional namespace for the generated code,
                              ///< used when generating events function.
+  std::size_t eventsListNextUniqueId;  ///< The number used to name the next
+                                       ///< function generated for a list of
+                                       ///< events.
 };
 
 }  // namespace gdjs
@@ -29,7 +29,7 @@
 namespace gdjs {
 
 Exporter::Exporter(gd::AbstractFileSystem& fileSystem, gd::String gdjsRoot_)
-    : fs(fileSystem), gdjsRoot(gdjsRoot_) {
+    : fs(fileSystem), gdjsRoot(gdjsRoot_), useEventsCodeCache(true) {
   SetCodeOutputDirectory(fs.GetTempDir() + "/GDTemporaries/JSCodeTemp");
 }
 
@@ -39,6 +39,7 @@ bool Exporter::ExportLayoutForPixiPreview(gd::Project& project,
                                           gd::Layout& layout,
                                           gd::String exportDir) {
   ExporterHelper helper(fs, gdjsRoot, codeOutputDir);
+  helper.SetEventsCodeCacheEnabled(useEventsCodeCache);
   return helper.ExportLayoutForPixiPreview(project, layout, exportDir, "");
 }
 
@@ -51,6 +52,7 @@ bool Exporter::ExportExternalLayoutForPixiPreview(
   options.AddChild("injectExternalLayout").SetValue(externalLayout.GetName());
 
   ExporterHelper helper(fs, gdjsRoot, codeOutputDir);
+  helper.SetEventsCodeCacheEnabled(useEventsCodeCache);
   return helper.ExportLayoutForPixiPreview(
       project, layout, exportDir, gd::Serializer::ToJSON(options));
 }
@@ -60,6 +62,7 @@ bool Exporter::ExportWholePixiProject(
     gd::String exportDir,
     std::map<gd::String, bool>& exportOptions) {
   ExporterHelper helper(fs, gdjsRoot, codeOutputDir);
+  helper.SetEventsCodeCacheEnabled(useEventsCodeCache);
   gd::Project exportedProject = project;
 
   auto exportProject = [this, &exportedProject, &exportOptions, &helper](
@@ -161,6 +164,7 @@ bool Exporter::ExportWholeCocos2dProject(gd::Project& project,
                                          bool debugMode,
                                          gd::String exportDir) {
   ExporterHelper helper(fs, gdjsRoot, codeOutputDir);
+  helper.SetEventsCodeCacheEnabled(useEventsCodeCache);
 
   wxProgressDialog* progressDialogPtr = NULL;
 
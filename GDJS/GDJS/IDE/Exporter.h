@@ -89,6 +89,16 @@ class Exporter {
     codeOutputDir = codeOutputDir_;
   }
 
+  /**
+   * \brief Enable or disable the reuse of the events code generated by the
+   * previous exports for the layouts which did not change (enabled by default).
+   *
+   * \see ExporterHelper::SetEventsCodeCacheEnabled
+   */
+  void SetEventsCodeCacheEnabled(bool enable = true) {
+    useEventsCodeCache = enable;
+  }
+
  private:
   gd::AbstractFileSystem&
       fs;  ///< The abstract file system to be used for exportation.
@@ -97,6 +107,7 @@ class Exporter {
       gdjsRoot;  ///< The root directory of GDJS, used to copy runtime files.
   gd::String codeOutputDir;  ///< The directory where JS code is outputted. Will
                              ///< be then copied to the final output directory.
+  bool useEventsCodeCache;   ///< true to reuse the code of unchanged layouts.
 };
 
 }  // namespace gdjs
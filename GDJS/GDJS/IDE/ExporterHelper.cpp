@@ -5,16 +5,22 @@
  */
 #include "GDJS/IDE/ExporterHelper.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
+#include <functional>
+#include <iomanip>
 #include <sstream>
 #include <streambuf>
 #include <string>
+#include <thread>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/CodeGeneration/EffectsCodeGenerator.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
 #include "GDCore/IDE/Project/ProjectResourcesCopier.h"
 #include "GDCore/IDE/ProjectStripper.h"
 #include "GDCore/IDE/SceneNameMangler.h"
+#include "GDCore/Project/EventsFunctionsExtension.h"
 #include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/ExternalLayout.h"
 #include "GDCore/Project/Layout.h"
@@ -24,6 +30,7 @@
 #include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/VersionWrapper.h"
 #include "GDJS/Events/CodeGeneration/LayoutCodeGenerator.h"
 #undef CopyFile  // Disable an annoying macro
 
@@ -35,6 +42,35 @@ static void InsertUnique(std::vector<gd::String> &container, gd::String str) {
     container.push_back(str);
 }
 
+static gd::String HashString(const gd::String &str) {
+  // 64 bits FNV-1a hash of the UTF-8 bytes of the string.
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (char c : str.Raw()) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream hashString;
+  hashString << std::hex << std::setfill('0') << std::setw(16) << hash;
+  return gd::String::FromUTF8(hashString.str());
+}
+
+static void ParallelFor(std::size_t count,
+                        std::size_t threadsCount,
+                        std::function<void(std::size_t)> func) {
+  std::atomic<std::size_t> nextIndex(0);
+  auto work = [&nextIndex, count, &func]() {
+    for (std::size_t i = nextIndex++; i < count; i = nextIndex++) func(i);
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < std::min(threadsCount, count); ++i)
+    threads.emplace_back(work);
+
+  work();
+  for (auto &thread : threads) thread.join();
+}
+
 static void GenerateFontsDeclaration(
     const gd::ResourcesManager &resourcesManager,
     gd::AbstractFileSystem &fs,
@@ -90,7 +126,11 @@ static void GenerateFontsDeclaration(
 ExporterHelper::ExporterHelper(gd::AbstractFileSystem &fileSystem,
                                gd::String gdjsRoot_,
                                gd::String codeOutputDir_)
-    : fs(fileSystem), gdjsRoot(gdjsRoot_), codeOutputDir(codeOutputDir_){};
+    : fs(fileSystem),
+      gdjsRoot(gdjsRoot_),
+      codeOutputDir(codeOutputDir_),
+      useEventsCodeCache(true),
+      codeGenerationThreadsCount(0){};
 
 bool ExporterHelper::ExportLayoutForPixiPreview(gd::Project &project,
                                                 gd::Layout &layout,
@@ -163,11 +203,14 @@ gd::String ExporterHelper::ExportToJSON(gd::AbstractFileSystem &fs,
   gd::SerializerElement rootElement;
   project.SerializeTo(rootElement);
 
-  gd::String output = gd::Serializer::ToJSON(rootElement);
-  if (!wrapIntoVariable.empty())
-    output = wrapIntoVariable + " = " + output + ";";
-
-  if (!fs.WriteToFile(filename, output)) return "Unable to write " + filename;
+  // Stream the JSON to the file, so that the whole project is not
+  // stored in memory as a string (and then copied when wrapped).
+  bool written = fs.StreamToFile(filename, [&](std::ostream &output) {
+    if (!wrapIntoVariable.empty()) output << wrapIntoVariable << " = ";
+    gd::Serializer::ToJSON(rootElement, output);
+    if (!wrapIntoVariable.empty()) output << ";";
+  });
+  if (!written) return "Unable to write " + filename;
 
   return "";
 }
@@ -651,29 +694,150 @@ bool ExporterHelper::ExportEventsCode(gd::Project &project,
                                       bool exportForPreview) {
   fs.MkDir(outputDir);
 
-  for (std::size_t i = 0; i < project.GetLayoutsCount(); ++i) {
-    std::set<gd::String> eventsIncludes;
-    gd::Layout &layout = project.GetLayout(i);
-    LayoutCodeGenerator layoutCodeGenerator(project);
-    gd::String eventsOutput = layoutCodeGenerator.GenerateLayoutCompleteCode(
-        layout, eventsIncludes, !exportForPreview);
-    gd::String filename =
-        outputDir + "/" + "code" + gd::String::From(i) + ".js";
-
-    // Export the code
-    if (fs.WriteToFile(filename, eventsOutput)) {
-      for (auto &include : eventsIncludes) InsertUnique(includesFiles, include);
+  // The fingerprints and the includes of the code generated by the previous
+  // exports, by filename.
+  gd::String cacheFilename = outputDir + "/codeCache.json";
+  gd::SerializerElement cache;
+  if (useEventsCodeCache && fs.FileExists(cacheFilename))
+    cache = gd::Serializer::FromJSON(fs.ReadFile(cacheFilename));
+  bool cacheChanged = false;
+
+  std::size_t layoutsCount = project.GetLayoutsCount();
+  std::vector<gd::String> filenames(layoutsCount);
+  std::vector<gd::String> cachedFingerprints(layoutsCount);
+  for (std::size_t i = 0; i < layoutsCount; ++i) {
+    filenames[i] = outputDir + "/" + "code" + gd::String::From(i) + ".js";
+    if (useEventsCodeCache && cache.HasChild(filenames[i]) &&
+        fs.FileExists(filenames[i]))
+      cachedFingerprints[i] =
+          cache.GetChild(filenames[i]).GetStringAttribute("fingerprint");
+  }
 
-      InsertUnique(includesFiles, filename);
+  // Generate the code of the layouts in parallel: the code generators only
+  // read the project. The parts of the project shared by all the layouts are
+  // serialized once, here, as serializing them can update some caches (see
+  // gd::Variable).
+  gd::String projectFingerprint =
+      useEventsCodeCache
+          ? GetProjectCodeFingerprint(project, !exportForPreview)
+          : "";
+  std::vector<gd::String> fingerprints(layoutsCount);
+  std::vector<gd::String> eventsOutputs(layoutsCount);
+  std::vector<std::set<gd::String>> eventsIncludes(layoutsCount);
+  ParallelFor(
+      layoutsCount, GetCodeGenerationThreadsCount(), [&](std::size_t i) {
+        const gd::Layout &layout = project.GetLayout(i);
+        if (useEventsCodeCache) {
+          fingerprints[i] =
+              GetLayoutCodeFingerprint(projectFingerprint, layout);
+          if (fingerprints[i] == cachedFingerprints[i]) return;
+        }
+
+        LayoutCodeGenerator layoutCodeGenerator(project);
+        eventsOutputs[i] = layoutCodeGenerator.GenerateLayoutCompleteCode(
+            layout, eventsIncludes[i], !exportForPreview);
+      });
+
+  // Write the files in the order of the layouts, so that the output does not
+  // depend on the number of threads.
+  for (std::size_t i = 0; i < layoutsCount; ++i) {
+    const gd::String &filename = filenames[i];
+    if (useEventsCodeCache && fingerprints[i] == cachedFingerprints[i]) {
+      // The layout did not change: reuse the code generated previously.
+      gd::SerializerElement &includesElement =
+          cache.GetChild(filename).GetChild("includes");
+      includesElement.ConsiderAsArrayOf("include");
+      for (std::size_t j = 0; j < includesElement.GetChildrenCount(); ++j)
+        eventsIncludes[i].insert(
+            includesElement.GetChild(j).GetStringValue());
     } else {
-      lastError = _("Unable to write ") + filename;
-      return false;
+      // Export the code
+      if (!fs.WriteToFile(filename, eventsOutputs[i])) {
+        lastError = _("Unable to write ") + filename;
+        return false;
+      }
+
+      if (useEventsCodeCache) {
+        cache.RemoveChild(filename);
+        gd::SerializerElement &cacheElement = cache.AddChild(filename);
+        cacheElement.SetAttribute("fingerprint", fingerprints[i]);
+        gd::SerializerElement &includesElement =
+            cacheElement.AddChild("includes");
+        includesElement.ConsiderAsArrayOf("include");
+        for (auto &include : eventsIncludes[i])
+          includesElement.AddChild("include").SetValue(include);
+
+        cacheChanged = true;
+      }
     }
+
+    for (auto &include : eventsIncludes[i])
+      InsertUnique(includesFiles, include);
+    InsertUnique(includesFiles, filename);
   }
 
+  if (cacheChanged &&
+      !fs.WriteToFile(cacheFilename, gd::Serializer::ToJSON(cache)))
+    gd::LogWarning(_("Unable to write the events code cache ") + cacheFilename);
+
   return true;
 }
 
+std::size_t ExporterHelper::GetCodeGenerationThreadsCount() const {
+#if defined(EMSCRIPTEN)
+  return 1;
+#else
+  if (codeGenerationThreadsCount != 0) return codeGenerationThreadsCount;
+
+  return std::max(std::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+gd::String ExporterHelper::GetProjectCodeFingerprint(
+    const gd::Project &project, bool compilationForRuntime) {
+  gd::SerializerElement element;
+  element.SetAttribute("gdVersion", gd::VersionWrapper::FullString());
+  element.SetAttribute("compilationForRuntime", compilationForRuntime);
+
+  // The parts of the project that can be used by the events of the layouts.
+  gd::SerializerElement &extensionsElement =
+      element.AddChild("usedExtensions");
+  extensionsElement.ConsiderAsArrayOf("extension");
+  for (auto &extensionName : project.GetUsedExtensions())
+    extensionsElement.AddChild("extension").SetValue(extensionName);
+
+  project.GetResourcesManager().SerializeTo(element.AddChild("resources"));
+  project.SerializeObjectsTo(element.AddChild("objects"));
+  project.GetObjectGroups().SerializeTo(element.AddChild("objectsGroups"));
+  project.GetVariables().SerializeTo(element.AddChild("variables"));
+
+  gd::SerializerElement &externalEventsElement =
+      element.AddChild("externalEvents");
+  externalEventsElement.ConsiderAsArrayOf("externalEvents");
+  for (std::size_t i = 0; i < project.GetExternalEventsCount(); ++i)
+    project.GetExternalEvents(i).SerializeTo(
+        externalEventsElement.AddChild("externalEvents"));
+
+  gd::SerializerElement &eventsFunctionsExtensionsElement =
+      element.AddChild("eventsFunctionsExtensions");
+  eventsFunctionsExtensionsElement.ConsiderAsArrayOf(
+      "eventsFunctionsExtension");
+  for (std::size_t i = 0; i < project.GetEventsFunctionsExtensionsCount(); ++i)
+    project.GetEventsFunctionsExtension(i).SerializeTo(
+        eventsFunctionsExtensionsElement.AddChild("eventsFunctionsExtension"));
+
+  return HashString(gd::Serializer::ToJSON(element));
+}
+
+gd::String ExporterHelper::GetLayoutCodeFingerprint(
+    const gd::String &projectFingerprint, const gd::Layout &layout) {
+  gd::SerializerElement element;
+  element.SetAttribute("project", projectFingerprint);
+  layout.SerializeTo(element.AddChild("layout"));
+
+  return HashString(gd::Serializer::ToJSON(element));
+}
+
 bool ExporterHelper::ExportExternalSourceFiles(
     gd::Project &project,
     gd::String outputDir,
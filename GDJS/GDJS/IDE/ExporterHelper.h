@@ -106,12 +106,66 @@ class ExporterHelper {
    * outputDir The directory where the events code must be generated. \param
    * includesFiles A reference to a vector that will be filled with JS files to
    * be exported along with the project. ( including "codeX.js" files ).
+   *
+   * \note If the events code cache is enabled, the code of the layouts which
+   * did not change since the last export in the same directory is neither
+   * generated nor written again (see SetEventsCodeCacheEnabled).
    */
   bool ExportEventsCode(gd::Project &project,
                         gd::String outputDir,
                         std::vector<gd::String> &includesFiles,
                         bool exportForPreview);
 
+  /**
+   * \brief Return a fingerprint of the parts of the project that can be used
+   * by the events of all the layouts: the global objects, groups and
+   * variables, the resources, the external events, the events functions
+   * extensions, the used extensions and the version of GDevelop.
+   *
+   * Compute it once per export, and give it to GetLayoutCodeFingerprint for
+   * each layout.
+   */
+  static gd::String GetProjectCodeFingerprint(const gd::Project &project,
+                                              bool compilationForRuntime);
+
+  /**
+   * \brief Return a fingerprint of everything the code generated for the
+   * events of the layout depends on, from the fingerprint returned by
+   * GetProjectCodeFingerprint.
+   *
+   * Layouts with the same fingerprint have the same generated code.
+   */
+  static gd::String GetLayoutCodeFingerprint(
+      const gd::String &projectFingerprint, const gd::Layout &layout);
+
+  /**
+   * \brief Enable or disable the events code cache (enabled by default).
+   *
+   * When enabled, ExportEventsCode stores the fingerprint of the code of each
+   * layout in the output directory, and reuses the code of the layouts whose
+   * fingerprint did not change.
+   */
+  void SetEventsCodeCacheEnabled(bool enable = true) {
+    useEventsCodeCache = enable;
+  }
+
+  /**
+   * \brief Change the number of threads used by ExportEventsCode to generate
+   * the code of the layouts, including the calling thread.
+   *
+   * 0, the default, means the number of hardware threads. The generated code
+   * does not depend on the number of threads. Always 1 with Emscripten.
+   */
+  void SetCodeGenerationThreadsCount(std::size_t threadsCount) {
+    codeGenerationThreadsCount = threadsCount;
+  }
+
+  /**
+   * \brief Return the number of threads used to generate the code of the
+   * layouts.
+   */
+  std::size_t GetCodeGenerationThreadsCount() const;
+
   /**
    * \brief Add the project effects include files.
    */
@@ -239,6 +293,8 @@ class ExporterHelper {
       gdjsRoot;  ///< The root directory of GDJS, used to copy runtime files.
   gd::String codeOutputDir;  ///< The directory where JS code is outputted. Will
                              ///< be then copied to the final output directory.
+  bool useEventsCodeCache;   ///< true to reuse the code of unchanged layouts.
+  std::size_t codeGenerationThreadsCount;  ///< 0 for the hardware threads.
 };
 
 }  // namespace gdjs
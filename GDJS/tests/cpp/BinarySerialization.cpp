@@ -0,0 +1,90 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the binary serialization of all the test games.
+ */
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/TinyXml/tinyxml.h"
+#include "TestGames.h"  // Generated by CMake.
+#include "catch.hpp"
+
+namespace {
+const char* testGames[] = {GDJS_TEST_GAMES};
+
+bool EndsWith(const std::string& str, const std::string& suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Load a test game, saved in JSON or in the old XML format.
+ */
+bool LoadTestGame(const std::string& filename, gd::SerializerElement& element) {
+  if (EndsWith(filename, ".json")) {
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file.is_open()) return false;
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    std::string json = content.str();
+    std::size_t errorPosition;
+    element =
+        gd::Serializer::FromJSON(json.data(), json.size(), &errorPosition);
+    return errorPosition == std::string::npos;
+  }
+
+  TiXmlDocument doc;
+  if (!doc.LoadFile(filename.c_str())) return false;
+
+  gd::Serializer::FromXML(element, doc.FirstChildElement());
+  return true;
+}
+}  // namespace
+
+TEST_CASE("Binary serialization of the test games", "[serialization]") {
+  std::size_t jsonSize = 0, binarySize = 0;
+  long long jsonTime = 0, binaryTime = 0;
+  for (const char* testGame : testGames) {
+    INFO(testGame);
+    gd::SerializerElement element;
+    REQUIRE(LoadTestGame(std::string(GDJS_TEST_GAMES_DIR) + testGame, element));
+    gd::String json = gd::Serializer::ToJSON(element);
+
+    std::string binary = gd::Serializer::ToBinary(element);
+    REQUIRE(gd::Serializer::IsBinary(binary.data(), binary.size()));
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t errorPosition;
+    gd::SerializerElement binaryElement = gd::Serializer::FromBinary(
+        binary.data(), binary.size(), &errorPosition);
+    auto end = std::chrono::steady_clock::now();
+    REQUIRE(errorPosition == std::string::npos);
+    REQUIRE(gd::Serializer::ToJSON(binaryElement) == json);
+    binaryTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+            .count();
+
+    start = std::chrono::steady_clock::now();
+    gd::SerializerElement jsonElement = gd::Serializer::FromJSON(json);
+    end = std::chrono::steady_clock::now();
+    jsonTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+            .count();
+
+    jsonSize += json.Raw().size();
+    binarySize += binary.size();
+  }
+
+  std::cout << "Test games in JSON: " << jsonSize / 1000 << "KB, read in "
+            << jsonTime / 1000 << "ms. In binary: " << binarySize / 1000
+            << "KB, read in " << binaryTime / 1000 << "ms." << std::endl;
+}
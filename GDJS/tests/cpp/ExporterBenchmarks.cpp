@@ -0,0 +1,143 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the generation of the events code by the exporter.
+ */
+#include <chrono>
+#include <iostream>
+#include <map>
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDJS/Extensions/JsPlatform.h"
+#include "GDJS/IDE/ExporterHelper.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief A file system keeping the files in memory, so that only the code
+ * generation is measured.
+ */
+class MemoryFileSystem : public gd::AbstractFileSystem {
+ public:
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) {
+    return files.find(path) != files.end();
+  };
+  virtual gd::String FileNameFrom(const gd::String& file) { return file; };
+  virtual gd::String DirNameFrom(const gd::String& file) { return file; };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) { return true; }
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    return true;
+  }
+  virtual bool ClearDir(const gd::String& directory) { return true; }
+  virtual bool WriteToFile(const gd::String& file, const gd::String& content) {
+    files[file] = content;
+    return true;
+  }
+  virtual gd::String ReadFile(const gd::String& file) { return files[file]; }
+  virtual gd::String GetTempDir() { return "/tmp"; }
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  }
+
+  MemoryFileSystem(){};
+  virtual ~MemoryFileSystem(){};
+
+  std::map<gd::String, gd::String> files;
+};
+
+gd::Instruction CreateInstruction(const gd::String& type,
+                                  const std::vector<gd::String>& parameters) {
+  gd::Instruction instruction(type);
+  instruction.SetParametersCount(parameters.size());
+  for (std::size_t i = 0; i < parameters.size(); ++i)
+    instruction.SetParameter(i, gd::Expression(parameters[i]));
+
+  return instruction;
+}
+
+/**
+ * \brief Fill the project with layouts of objects moved by simple events.
+ */
+void CreateSyntheticProject(gd::Project& project, std::size_t layoutsCount) {
+  project.AddPlatform(gdjs::JsPlatform::Get());
+  for (std::size_t i = 0; i < layoutsCount; ++i) {
+    gd::Layout& layout =
+        project.InsertNewLayout("Layout " + gd::String::From(i), i);
+    for (std::size_t j = 0; j < 10; ++j)
+      layout.InsertNewObject(
+          project, "Sprite", "Object" + gd::String::From(j), j);
+
+    for (std::size_t j = 0; j < 50; ++j) {
+      gd::String objectName = "Object" + gd::String::From(j % 10);
+      gd::StandardEvent event;
+      event.SetType("BuiltinCommonInstructions::Standard");
+      event.GetConditions().Insert(CreateInstruction(
+          "PosX", {objectName, "<", "100 + " + gd::String::From(j)}));
+      event.GetActions().Insert(
+          CreateInstruction("MettreX", {objectName, "+", "1"}));
+      event.GetActions().Insert(CreateInstruction(
+          "Create", {"", objectName, "Object0.X() + 10", "20", ""}));
+
+      gd::StandardEvent subEvent;
+      subEvent.SetType("BuiltinCommonInstructions::Standard");
+      subEvent.GetConditions().Insert(
+          CreateInstruction("PosY", {objectName, ">", "50"}));
+      subEvent.GetActions().Insert(
+          CreateInstruction("MettreY", {objectName, "=", "0"}));
+      event.GetSubEvents().InsertEvent(subEvent);
+
+      layout.GetEvents().InsertEvent(event);
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("ExporterHelper - Benchmarks", "[exporter]") {
+  gd::Project project;
+  CreateSyntheticProject(project, 200);
+
+  // Generate the code with each number of threads, and check that the
+  // generated files are the same as with one thread.
+  std::map<gd::String, gd::String> serialFiles;
+  for (std::size_t threadsCount : {1, 2, 4, 8}) {
+    MemoryFileSystem fs;
+    gdjs::ExporterHelper helper(fs, "/gdjs", "/code");
+    helper.SetEventsCodeCacheEnabled(false);
+    helper.SetCodeGenerationThreadsCount(threadsCount);
+
+    std::vector<gd::String> includesFiles;
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(helper.ExportEventsCode(project, "/code", includesFiles, false));
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Events code generation of " << project.GetLayoutsCount()
+              << " layouts with " << threadsCount << " thread(s): "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                       start)
+                     .count()
+              << "ms" << std::endl;
+
+    REQUIRE(fs.files.size() == project.GetLayoutsCount());
+    if (threadsCount == 1)
+      serialFiles = fs.files;
+    else
+      REQUIRE(fs.files == serialFiles);
+  }
+}
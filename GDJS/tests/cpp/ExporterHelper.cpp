@@ -0,0 +1,129 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the export of the project to JSON.
+ */
+#include "GDJS/IDE/ExporterHelper.h"
+#include <algorithm>
+#include <ostream>
+#include <streambuf>
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDJS/Extensions/JsPlatform.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief A stream buffer not storing anything, only counting the characters
+ * written and the size of the largest write.
+ */
+class CountingBuffer : public std::streambuf {
+ public:
+  CountingBuffer() : size(0), largestWrite(0){};
+
+  std::size_t size;
+  std::size_t largestWrite;
+
+ protected:
+  virtual std::streamsize xsputn(const char* characters,
+                                 std::streamsize count) {
+    size += count;
+    largestWrite = std::max(largestWrite, static_cast<std::size_t>(count));
+    return count;
+  }
+
+  virtual int_type overflow(int_type character) {
+    if (traits_type::eq_int_type(character, traits_type::eof()))
+      return traits_type::not_eof(character);
+
+    size++;
+    largestWrite = std::max(largestWrite, std::size_t(1));
+    return character;
+  }
+};
+
+/**
+ * \brief A file system only measuring what is written to the files.
+ */
+class MeasuringFileSystem : public gd::AbstractFileSystem {
+ public:
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) { return false; };
+  virtual gd::String FileNameFrom(const gd::String& file) { return file; };
+  virtual gd::String DirNameFrom(const gd::String& file) { return file; };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) { return true; }
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    return true;
+  }
+  virtual bool ClearDir(const gd::String& directory) { return true; }
+  virtual bool WriteToFile(const gd::String& file, const gd::String& content) {
+    writtenFilesCount++;
+    return true;
+  }
+  virtual bool StreamToFile(const gd::String& file,
+                            std::function<void(std::ostream&)> writer) {
+    CountingBuffer buffer;
+    std::ostream output(&buffer);
+    writer(output);
+    streamedSize += buffer.size;
+    largestWrite = std::max(largestWrite, buffer.largestWrite);
+    return true;
+  }
+  virtual gd::String ReadFile(const gd::String& file) { return ""; }
+  virtual gd::String GetTempDir() { return "/tmp"; }
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  }
+
+  MeasuringFileSystem()
+      : writtenFilesCount(0), streamedSize(0), largestWrite(0){};
+  virtual ~MeasuringFileSystem(){};
+
+  std::size_t writtenFilesCount;
+  std::size_t streamedSize;
+  std::size_t largestWrite;
+};
+}  // namespace
+
+TEST_CASE("ExporterHelper", "[exporter]") {
+  SECTION("The project is streamed to the JSON file") {
+    gd::Project project;
+    project.AddPlatform(gdjs::JsPlatform::Get());
+    for (std::size_t i = 0; i < 50; ++i) {
+      gd::Layout& layout =
+          project.InsertNewLayout("Layout " + gd::String::From(i), i);
+      for (std::size_t j = 0; j < 400; ++j) {
+        gd::InitialInstance& instance =
+            layout.GetInitialInstances().InsertNewInitialInstance();
+        instance.SetObjectName("Object" + gd::String::From(j % 10));
+        instance.SetX(j);
+      }
+    }
+
+    MeasuringFileSystem fs;
+    REQUIRE(gdjs::ExporterHelper::ExportToJSON(
+                fs, project, "/export/data.js", "gdjs.projectData") == "");
+    REQUIRE(fs.writtenFilesCount == 0);
+
+    // The JSON is large, but written in small parts, without being stored in
+    // a string first.
+    REQUIRE(fs.streamedSize > 1024 * 1024);
+    REQUIRE(fs.largestWrite < 1024);
+  }
+}
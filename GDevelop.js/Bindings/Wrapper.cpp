@@ -1,5 +1,7 @@
 #include <map>
+#include <ostream>
 #include <set>
+#include <streambuf>
 #include <string>
 #include <utility>
 #include <vector>
@@ -279,6 +281,19 @@ class AbstractFileSystemJS : public AbstractFileSystem {
         content.c_str());
   }
 
+  virtual bool StreamToFile(const gd::String &file,
+                            std::function<void(std::ostream &)> writer) {
+    // File systems not able to append to a file get the whole content at
+    // once.
+    if (!CanAppendToFile())
+      return AbstractFileSystem::StreamToFile(file, writer);
+
+    ChunksBuffer buffer(*this, file);
+    std::ostream output(&buffer);
+    writer(output);
+    return buffer.Finish();
+  }
+
   virtual gd::String ReadFile(const gd::String &file) {
     return (const char *)EM_ASM_INT(
         {
@@ -319,6 +334,114 @@ class AbstractFileSystemJS : public AbstractFileSystem {
 
   AbstractFileSystemJS(){};
   virtual ~AbstractFileSystemJS(){};
+
+ private:
+  /**
+   * \brief A stream buffer sending what is written to the file by chunks:
+   * the first one with writeToFile, the next ones with appendToFile.
+   *
+   * Chunks are never cut inside an UTF-8 character, as each chunk is
+   * converted to a JS string.
+   */
+  class ChunksBuffer : public std::streambuf {
+   public:
+    ChunksBuffer(AbstractFileSystemJS &fs_, const gd::String &file_)
+        : fs(fs_), file(file_), chunk(64 * 1024), firstChunk(true), ok(true) {
+      setp(chunk.data(), chunk.data() + chunk.size());
+    };
+
+    /**
+     * \brief Send the last chunk, and return false if a chunk could not be
+     * written.
+     */
+    bool Finish() {
+      SendChunk(pptr() - pbase());
+      return ok;
+    }
+
+   protected:
+    virtual int_type overflow(int_type character) {
+      SendChunk(GetCompleteCharactersSize());
+      if (!ok) return traits_type::eof();
+
+      if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(character);
+        pbump(1);
+      }
+      return traits_type::not_eof(character);
+    }
+
+   private:
+    /**
+     * \brief Return the size of the written bytes, without the bytes of an
+     * UTF-8 character not entirely written yet.
+     */
+    std::size_t GetCompleteCharactersSize() const {
+      std::size_t size = pptr() - pbase();
+      std::size_t start = size;  // The start of the last character.
+      while (start > 0 && size - start < 4 &&
+             (static_cast<unsigned char>(chunk[start - 1]) & 0xC0) == 0x80)
+        --start;
+      if (start == 0) return size;
+
+      unsigned char lead = chunk[start - 1];
+      std::size_t length = 1;
+      if (lead >= 0xF0)
+        length = 4;
+      else if (lead >= 0xE0)
+        length = 3;
+      else if (lead >= 0xC0)
+        length = 2;
+      return size - (start - 1) < length ? start - 1 : size;
+    }
+
+    /**
+     * \brief Send the first \a size bytes, keeping the others at the start of
+     * the buffer.
+     */
+    void SendChunk(std::size_t size) {
+      std::size_t writtenSize = pptr() - pbase();
+      if (ok) {
+        ok = fs.WriteChunkToFile(
+            file, std::string(chunk.data(), size), !firstChunk);
+        firstChunk = false;
+      }
+
+      std::copy(chunk.data() + size, chunk.data() + writtenSize, chunk.data());
+      setp(chunk.data(), chunk.data() + chunk.size());
+      pbump(writtenSize - size);
+    }
+
+    AbstractFileSystemJS &fs;
+    gd::String file;
+    std::vector<char> chunk;
+    bool firstChunk;
+    bool ok;  ///< False if a chunk could not be written.
+  };
+
+  bool CanAppendToFile() {
+    return (bool)EM_ASM_INT(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          return self.hasOwnProperty('appendToFile');
+        },
+        (int)this);
+  }
+
+  bool WriteChunkToFile(const gd::String &file,
+                        const std::string &content,
+                        bool append) {
+    return (bool)EM_ASM_INT(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          return $3 ? self.appendToFile(UTF8ToString($1), UTF8ToString($2))
+                    : self.writeToFile(UTF8ToString($1), UTF8ToString($2));
+        },
+        (int)this,
+        file.c_str(),
+        content.c_str(),
+        append);
+  }
 };
 
 class InitialInstanceJSFunctorWrapper : public gd::InitialInstanceFunctor {
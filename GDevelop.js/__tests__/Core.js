@@ -2585,30 +2585,127 @@ describe('libGD.js', function() {
   });
 
   describe('gd.Exporter (and gd.AbstractFileSystemJS)', function() {
-    it('should export a layout for preview', function(done) {
+    // A fake file system, keeping the written files in memory.
+    var createFileSystem = function(files, writtenFiles) {
       var fs = new gd.AbstractFileSystemJS();
-      var project = new gd.ProjectHelper.createNewGDJSProject();
-      var layout = project.insertNewLayout('Scene', 0);
-
-      fs.mkDir = fs.clearDir = function() {};
+      fs.mkDir = function() {};
+      fs.clearDir = fs.copyFile = function() {
+        return true;
+      };
+      fs.dirExists = function(path) {
+        return true;
+      };
+      fs.fileExists = function(path) {
+        return files.hasOwnProperty(path);
+      };
       fs.getTempDir = function(path) {
         return '/tmp/';
       };
       fs.fileNameFrom = function(fullpath) {
-        return path.basename(fullpath);
+        return path.posix.basename(fullpath);
       };
       fs.dirNameFrom = function(fullpath) {
-        return path.dirname(fullpath);
+        return path.posix.dirname(fullpath);
+      };
+      fs.isAbsolute = function(fullpath) {
+        return path.posix.isAbsolute(fullpath);
+      };
+      fs.makeAbsolute = function(relativePath, baseDirectory) {
+        return path.posix.resolve(baseDirectory, relativePath);
+      };
+      fs.makeRelative = function(absolutePath, baseDirectory) {
+        return path.posix.relative(baseDirectory, absolutePath);
+      };
+      fs.readFile = function(path) {
+        return files[path] || '';
+      };
+      fs.readDir = function(path, extension) {
+        return new gd.VectorString();
       };
       fs.writeToFile = function(path, content) {
-        //Validate that some code have been generated:
-        expect(content).toMatch('runtimeScene.getOnceTriggers().startNewFrame');
-        done();
+        files[path] = content;
+        writtenFiles.push(path);
+        return true;
+      };
+      fs.appendToFile = function(path, content) {
+        files[path] += content;
+        return true;
       };
+      return fs;
+    };
+
+    it('should export a layout for preview', function() {
+      var files = {};
+      var fs = createFileSystem(files, []);
+      var project = new gd.ProjectHelper.createNewGDJSProject();
+      var layout = project.insertNewLayout('Scene', 0);
 
       var exporter = new gd.Exporter(fs);
+      exporter.setCodeOutputDirectory('/code');
       exporter.exportLayoutForPixiPreview(project, layout, '/path/for/export/');
       exporter.delete();
+
+      //Validate that some code have been generated:
+      expect(files['/code/code0.js']).toMatch(
+        'runtimeScene.getOnceTriggers().startNewFrame'
+      );
+      expect(files['/code/data.js']).toMatch('gdjs.projectData');
+
+      project.delete();
+    });
+
+    it('should only generate the code of the changed layouts', function() {
+      var files = {};
+      var writtenFiles = [];
+      var fs = createFileSystem(files, writtenFiles);
+
+      var project = new gd.ProjectHelper.createNewGDJSProject();
+      var layout1 = project.insertNewLayout('Scene1', 0);
+      var layout2 = project.insertNewLayout('Scene2', 1);
+      layout1.getVariables().insertNew('Variable1', 0);
+
+      var exportLayout = function(useEventsCodeCache) {
+        var exporter = new gd.Exporter(fs);
+        exporter.setCodeOutputDirectory('/code');
+        exporter.setEventsCodeCacheEnabled(useEventsCodeCache);
+        writtenFiles.length = 0;
+        exporter.exportLayoutForPixiPreview(project, layout1, '/export');
+        exporter.delete();
+      };
+
+      // The first export generates all the code.
+      exportLayout(true);
+      expect(writtenFiles).toContain('/code/code0.js');
+      expect(writtenFiles).toContain('/code/code1.js');
+      expect(writtenFiles).toContain('/code/codeCache.json');
+      var code0 = files['/code/code0.js'];
+      var code1 = files['/code/code1.js'];
+      var projectData = files['/code/data.js'];
+
+      // Nothing changed: the code is reused.
+      exportLayout(true);
+      expect(writtenFiles).not.toContain('/code/code0.js');
+      expect(writtenFiles).not.toContain('/code/code1.js');
+      expect(writtenFiles).not.toContain('/code/codeCache.json');
+      expect(files['/code/data.js']).toBe(projectData);
+
+      // Only the code of the changed layout is generated.
+      layout2.getVariables().insertNew('Variable2', 0);
+      exportLayout(true);
+      expect(writtenFiles).not.toContain('/code/code0.js');
+      expect(writtenFiles).toContain('/code/code1.js');
+      var cachedCode0 = files['/code/code0.js'];
+      var cachedCode1 = files['/code/code1.js'];
+
+      // The code is the same as without the cache.
+      exportLayout(false);
+      expect(writtenFiles).toContain('/code/code0.js');
+      expect(writtenFiles).toContain('/code/code1.js');
+      expect(files['/code/code0.js']).toBe(code0);
+      expect(files['/code/code0.js']).toBe(cachedCode0);
+      expect(files['/code/code1.js']).toBe(cachedCode1);
+
+      project.delete();
     });
   });
 
@@ -187,6 +187,11 @@ export default class BrowserFileSystem {
     return true;
   };
 
+  appendToFile = (filePath: string, content: string) => {
+    this._textFiles[pathPosix.normalize(filePath)] += content;
+    return true;
+  };
+
   readFile = (file: string): string => {
     if (this._textFiles[file]) return this._textFiles[file];
 
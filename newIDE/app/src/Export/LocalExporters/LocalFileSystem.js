@@ -104,6 +104,15 @@ export default {
     }
     return true;
   },
+  appendToFile: function(file, contents) {
+    try {
+      fs.appendFileSync(file, contents);
+    } catch (e) {
+      console.error('appendToFile(' + file + ', ...) failed: ' + e);
+      return false;
+    }
+    return true;
+  },
   readFile: function(file) {
     try {
       var contents = fs.readFileSync(file);